@@ -65,6 +65,11 @@
         #undef LV_MEM_POOL_INCLUDE
         #undef LV_MEM_POOL_ALLOC
     #endif
+
+    /*Keep the small freed blocks of each thread to allocate them again without locking the heap.
+     *Size of the cache of a thread in bytes (e.g. 4096). 0: disable
+     *Used only with LV_USE_OS and requires compiler support for thread local variables*/
+    #define LV_MEM_THREAD_CACHE_SIZE 0
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -78,6 +83,10 @@
  *(Not so important, you can adjust it to modify default sizes and spaces)*/
 #define LV_DPI_DEF 130     /*[px/inch]*/
 
+/*The overhead of refreshing one more area (e.g. starting a flush) expressed in pixels.
+ *Invalidated areas are joined if redrawing the joined area is cheaper than redrawing them separately.*/
+#define LV_REFR_AREA_OVERHEAD 1024     /*[px]*/
+
 /*=================
  * OPERATING SYSTEM
  *=================*/
@@ -126,6 +135,11 @@
      * > 1 means multiply threads will render the screen in parallel */
     #define LV_DRAW_SW_DRAW_UNIT_CNT    1
 
+    /* Split the draw tasks covering at least this many pixels into horizontal bands.
+     * The idle draw units can render the bands of the same draw task in parallel.
+     * Has effect only if LV_DRAW_SW_DRAW_UNIT_CNT > 1. 0: disable splitting */
+    #define LV_DRAW_SW_SPLIT_MIN_AREA   (32 * 1024)
+
     /* Use Arm-2D to accelerate the sw render */
     #define LV_USE_DRAW_ARM2D_SYNC      0
 
@@ -322,6 +336,26 @@
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/*Eviction policy of the image cache and the image header cache
+ * - LV_CACHE_POLICY_LRU:  evict the least recently used image
+ * - LV_CACHE_POLICY_2Q:   keep the images used in more frames when many images are shown only once (e.g. scrolling a gallery)
+ * - LV_CACHE_POLICY_COST: evict the images which use more memory and are faster to decode again
+ * - LV_CACHE_POLICY_HASH: approximate LRU with a hash table. With an OS the cached images are found without locking*/
+#define LV_IMAGE_CACHE_POLICY           LV_CACHE_POLICY_LRU
+#define LV_IMAGE_HEADER_CACHE_POLICY    LV_CACHE_POLICY_LRU
+
+/*Number of threads decoding the not cached images in the background.
+ *While an image is being decoded nothing is drawn in its place and the area is redrawn when it's ready.
+ *Requires `LV_USE_OS` and `LV_CACHE_DEF_SIZE > 0`. Enable it with `lv_image_decoder_enable_async(true)`.
+ *0: decode the images synchronously while drawing*/
+#define LV_IMAGE_DECODER_ASYNC_THREAD_CNT 0
+
+/*Size of the tiles in which the images decoded by `get_area_cb` are cached (e.g. RGB bin files if
+ *`LV_BIN_DECODER_RAM_LOAD == 0` or JPGs decoded by TJPGD). Only the tiles which are drawn are decoded,
+ *so the memory usage depends on the visible part of an image instead of its size.
+ *Requires `LV_CACHE_DEF_SIZE > 0`. 0: don't cache the partially decoded images*/
+#define LV_IMAGE_DECODER_TILE_SIZE 0
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS   2
@@ -333,6 +367,12 @@
 /* Add 2 x 32 bit variables to each lv_obj_t to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/* Cache the resolved style values (found in the styles, inherited or default) per object
+ * to make getting style properties O(1) in the steady state.
+ * The cache is invalidated when any style, state or parent changes.
+ * Set the number of cached values per object (power of 2, e.g. 64) or 0 to disable.*/
+#define LV_OBJ_STYLE_VALUE_CACHE 0
+
 /* Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -461,6 +501,11 @@
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Cache the glyph IDs and the kerning values of the fonts with many characters (e.g. CJK fonts).
+ *It's the number of entries per font. Each entry takes 8 bytes and a cache is allocated for the used fonts.
+ *0: disable, else a power of 2 >= 256*/
+#define LV_FONT_FMT_TXT_CACHE_SIZE 0
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
@@ -723,6 +768,10 @@
 #if LV_USE_GIF
 /*GIF decoder accelerate*/
 #define LV_GIF_CACHE_DECODE_DATA 0
+/*Decode this many frames ahead in a background thread to avoid frame time spikes.
+ *It needs (LV_GIF_PREDECODE_FRAME_CNT + 1) * width * height * 4 bytes extra RAM per GIF.
+ *Requires an OS (`LV_USE_OS`). 0: decode the frames in a timer when they are due*/
+#define LV_GIF_PREDECODE_FRAME_CNT 0
 #endif
 
 
@@ -821,7 +870,7 @@
     /*1: Enable the built-in profiler*/
     #define LV_USE_PROFILER_BUILTIN 1
     #if LV_USE_PROFILER_BUILTIN
-        /*Default profiler trace buffer size*/
+        /*Default profiler trace buffer size of each thread*/
         #define LV_PROFILER_BUILTIN_BUF_SIZE (16 * 1024)     /*[bytes]*/
     #endif
 
@@ -918,6 +967,9 @@
     #define LV_LINUX_FBDEV_RENDER_MODE   LV_DISPLAY_RENDER_MODE_PARTIAL
     #define LV_LINUX_FBDEV_BUFFER_COUNT  0
     #define LV_LINUX_FBDEV_BUFFER_SIZE   60
+    /*Render directly to two pages of the framebuffer and show them with `FBIOPAN_DISPLAY`
+     *instead of copying the rendered areas. The copy mode is used if panning is not supported.*/
+    #define LV_LINUX_FBDEV_PAGE_FLIP     0
 #endif
 
 /*Use Nuttx to open window and handle touchscreen*/
@@ -49,8 +49,14 @@ fout.write(
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_X86          3
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
+#define LV_CACHE_POLICY_LRU         0
+#define LV_CACHE_POLICY_2Q          1
+#define LV_CACHE_POLICY_COST        2
+#define LV_CACHE_POLICY_HASH        3
+
 /* Handle special Kconfig options */
 #ifndef LV_KCONFIG_IGNORE
     #include "lv_conf_kconfig.h"
@@ -78,6 +78,9 @@ typedef struct _lv_global_t {
     uint32_t style_custom_table_size;
     uint32_t style_last_custom_prop_id;
     uint8_t * style_custom_prop_flag_lookup_table;
+#if LV_OBJ_STYLE_VALUE_CACHE
+    uint32_t style_value_cache_epoch;
+#endif
 
     lv_ll_t group_ll;
     lv_group_t * group_default;
@@ -89,6 +92,7 @@ typedef struct _lv_global_t {
     uint32_t layout_count;
     lv_layout_dsc_t * layout_list;
     bool layout_update_mutex;
+    uint32_t layout_update_cnt;     /*Number of objects whose layout was updated*/
 
     uint32_t memory_zero;
     uint32_t math_rand_seed;
@@ -109,6 +113,9 @@ typedef struct _lv_global_t {
 
     lv_cache_t * img_cache;
     lv_cache_t * img_header_cache;
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    lv_image_decoder_async_state_t img_decoder_async;
+#endif
 
     lv_draw_global_info_t draw_info;
 #if defined(LV_DRAW_SW_SHADOW_CACHE_SIZE) && LV_DRAW_SW_SHADOW_CACHE_SIZE > 0
@@ -182,6 +189,10 @@ typedef struct _lv_global_t {
     lv_font_fmt_rle_t font_fmt_rle;
 #endif
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    lv_font_fmt_txt_cache_state_t font_fmt_txt_cache;
+#endif
+
 #if LV_USE_SPAN != 0
     struct _snippet_stack * span_snippet_stack;
 #endif
@@ -361,6 +361,11 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_obj_remove_style_all(obj);
     lv_obj_enable_style_refresh(true);
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+    lv_free(obj->style_value_cache);
+    obj->style_value_cache = NULL;
+#endif
+
     /*Remove the animations from this object*/
     lv_anim_delete(obj, NULL);
 
@@ -736,6 +741,9 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
 
     lv_state_t prev_state = obj->state;
 
+    /*The children might inherit different values in the new state*/
+    _lv_obj_style_value_cache_invalidate();
+
     _lv_style_state_cmp_t cmp_res = _lv_obj_style_state_compare(obj, prev_state, new_state);
     /*If there is no difference in styles there is nothing else to do*/
     if(cmp_res == _LV_STYLE_STATE_CMP_SAME) {
@@ -222,6 +222,9 @@ struct _lv_obj_t {
 #if LV_OBJ_STYLE_CACHE
     uint32_t style_main_prop_is_set;
     uint32_t style_other_prop_is_set;
+#endif
+#if LV_OBJ_STYLE_VALUE_CACHE
+    _lv_obj_style_value_cache_t * style_value_cache;
 #endif
     void * user_data;
 #if LV_USE_OBJ_ID
@@ -231,6 +234,7 @@ struct _lv_obj_t {
     lv_obj_flag_t flags;
     lv_state_t state;
     uint16_t layout_inv : 1;
+    uint16_t layout_child_inv : 1;  /*A descendant has `layout_inv` or `readjust_scroll_after_layout` set*/
     uint16_t readjust_scroll_after_layout : 1;
     uint16_t scr_layout_inv : 1;
     uint16_t skip_trans : 1;
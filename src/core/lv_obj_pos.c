@@ -27,7 +27,8 @@
  **********************/
 static int32_t calc_content_width(lv_obj_t * obj);
 static int32_t calc_content_height(lv_obj_t * obj);
-static void layout_update_core(lv_obj_t * obj);
+static uint32_t layout_update_core(lv_obj_t * obj);
+static lv_obj_t * mark_layout_child_inv(lv_obj_t * obj);
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv);
 
 /**********************
@@ -193,6 +194,7 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_obj_invalidate(obj);
 
     obj->readjust_scroll_after_layout = 1;
+    mark_layout_child_inv(obj);
 
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
@@ -278,7 +280,7 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
     obj->layout_inv = 1;
 
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
-    lv_obj_t * scr = lv_obj_get_screen(obj);
+    lv_obj_t * scr = mark_layout_child_inv(obj);
     scr->scr_layout_inv = 1;
 
     /*Make the display refreshing*/
@@ -300,7 +302,7 @@ void lv_obj_update_layout(const lv_obj_t * obj)
     while(scr->scr_layout_inv) {
         LV_LOG_TRACE("Layout update begin");
         scr->scr_layout_inv = 0;
-        layout_update_core(scr);
+        LV_GLOBAL_DEFAULT()->layout_update_cnt += layout_update_core(scr);
         LV_LOG_TRACE("Layout update end");
     }
 
@@ -1103,13 +1105,26 @@ static int32_t calc_content_height(lv_obj_t * obj)
     return LV_MAX(self_h, child_res + space_bottom);
 }
 
-static void layout_update_core(lv_obj_t * obj)
+/**
+ * Update the layout of an object and of its descendants if they are marked.
+ * Only the branches marked with `layout_child_inv` are visited.
+ * @param obj       pointer to an object
+ * @return          number of objects whose layout was updated
+ */
+static uint32_t layout_update_core(lv_obj_t * obj)
 {
+    uint32_t layout_cnt = 0;
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_count(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+    if(obj->layout_child_inv) {
+        /*Clear it first, the children might be marked again while they are updated*/
+        obj->layout_child_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->layout_child_inv || child->readjust_scroll_after_layout) {
+                layout_cnt += layout_update_core(child);
+            }
+        }
     }
 
     if(obj->layout_inv) {
@@ -1120,12 +1135,32 @@ static void layout_update_core(lv_obj_t * obj)
         if(child_cnt > 0) {
             _lv_layout_apply(obj);
         }
+        layout_cnt++;
     }
 
     if(obj->readjust_scroll_after_layout) {
         obj->readjust_scroll_after_layout = 0;
         lv_obj_readjust_scroll(obj, LV_ANIM_OFF);
     }
+
+    return layout_cnt;
+}
+
+/**
+ * Mark the ancestors of an object that they have a descendant to update in the next layout update.
+ * @param obj       pointer to an object
+ * @return          the screen of the object
+ */
+static lv_obj_t * mark_layout_child_inv(lv_obj_t * obj)
+{
+    lv_obj_t * parent = obj->parent;
+    while(parent) {
+        parent->layout_child_inv = 1;
+        obj = parent;
+        parent = parent->parent;
+    }
+
+    return obj;
 }
 
 static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p_count, bool inv)
@@ -11,6 +11,8 @@
 #include "../indev/lv_indev.h"
 #include "../indev/lv_indev_scroll.h"
 #include "../display/lv_display.h"
+#include "../display/lv_display_private.h"
+#include "lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -36,6 +38,13 @@ static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_end_cb(lv_anim_t * a);
 static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_point_t * scroll_value,
                                   lv_anim_enable_t anim_en);
+static bool scroll_blit_get_area(lv_obj_t * obj, lv_area_t * area);
+static bool has_draw_event_cb(lv_obj_t * obj, lv_event_code_t first);
+static void scroll_blit_invalidate_overlays(lv_obj_t * obj, const lv_area_t * area, int32_t x, int32_t y);
+static void scroll_blit_invalidate_obj(lv_display_t * disp, const lv_area_t * area, lv_obj_t * overlay,
+                                       int32_t x, int32_t y);
+static void scroll_blit_invalidate_overlay(lv_display_t * disp, const lv_area_t * area, const lv_area_t * overlay_area,
+                                           int32_t x, int32_t y);
 
 /**********************
  *  STATIC VARIABLES
@@ -414,13 +423,39 @@ lv_result_t _lv_obj_scroll_by_raw(lv_obj_t * obj, int32_t x, int32_t y)
 
     lv_obj_allocate_spec_attr(obj);
 
+    /*If possible shift the already rendered content instead of redrawing the whole object*/
+    lv_area_t blit_area;
+    lv_area_t sb_hor_area;
+    lv_area_t sb_ver_area;
+    bool blit = scroll_blit_get_area(obj, &blit_area);
+    if(blit) lv_obj_get_scrollbar_area(obj, &sb_hor_area, &sb_ver_area);
+
     obj->spec_attr->scroll.x += x;
     obj->spec_attr->scroll.y += y;
 
     lv_obj_move_children_by(obj, x, y, true);
+
+    if(blit) blit = _lv_inv_area_shift(lv_obj_get_display(obj), &blit_area, x, y);
+    if(blit) {
+        /*The scrollbars and the border don't move with the content*/
+        lv_display_t * disp = lv_obj_get_display(obj);
+        scroll_blit_invalidate_overlay(disp, &blit_area, &sb_hor_area, x, y);
+        scroll_blit_invalidate_overlay(disp, &blit_area, &sb_ver_area, x, y);
+        lv_obj_scrollbar_invalidate(obj);
+
+        lv_area_t border_areas[4];
+        int8_t border_cnt = _lv_area_diff(border_areas, &obj->coords, &blit_area);
+        int8_t i;
+        for(i = 0; i < border_cnt; i++) {
+            lv_obj_invalidate_area(obj, &border_areas[i]);
+        }
+
+        scroll_blit_invalidate_overlays(obj, &blit_area, x, y);
+    }
+
     lv_result_t res = lv_obj_send_event(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RESULT_OK) return res;
-    lv_obj_invalidate(obj);
+    if(!blit) lv_obj_invalidate(obj);
     return LV_RESULT_OK;
 }
 
@@ -789,3 +824,179 @@ static void scroll_area_into_view(const lv_area_t * area, lv_obj_t * child, lv_p
     scroll_value->y += anim_en == LV_ANIM_OFF ? 0 : y_scroll;
     lv_obj_scroll_by(parent, x_scroll, y_scroll, anim_en);
 }
+
+/**
+ * Get the area of an object whose content can be shifted in the draw buffer when it's scrolled.
+ * It's possible only if the object's content is drawn on an opaque, uniform background
+ * and nothing is transformed or drawn by the object or its parents on top of the content.
+ * @param obj       pointer to an object which is about to be scrolled
+ * @param area      store the visible part of the object's inner area here (absolute coordinates)
+ * @return          true: the content can be shifted; false: the object needs to be redrawn
+ */
+static bool scroll_blit_get_area(lv_obj_t * obj, lv_area_t * area)
+{
+    lv_display_t * disp = lv_obj_get_display(obj);
+    if(disp == NULL || !disp->scroll_blit) return false;
+    if(disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) return false;
+    if(disp->rotation != LV_DISPLAY_ROTATION_0 || disp->prev_scr) return false;
+
+    /*The widget shouldn't draw anything else than a plain object*/
+    const lv_obj_class_t * class_p;
+    for(class_p = obj->class_p; class_p && class_p != &lv_obj_class; class_p = class_p->base_class) {
+        if(class_p->event_cb) return false;
+    }
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) return false;
+    if(has_draw_event_cb(obj, LV_EVENT_DRAW_MAIN_BEGIN)) return false;
+
+    /*The background needs to cover everything behind the content and needs to look the same everywhere*/
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) < LV_OPA_MAX) return false;
+    if(lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN) < LV_OPA_MAX) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_grad(obj, LV_PART_MAIN) != NULL) return false;
+    if(lv_obj_get_style_bg_image_src(obj, LV_PART_MAIN) != NULL) return false;
+
+    /*The content can't be transformed, drawn outside of the object or covered by the parents*/
+    lv_obj_t * parent;
+    for(parent = obj; parent; parent = lv_obj_get_parent(parent)) {
+        if(lv_obj_has_flag(parent, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) return false;
+        if(_lv_obj_get_layer_type(parent) != LV_LAYER_TYPE_NONE) return false;
+        if(parent == obj) continue;
+        if(lv_obj_get_style_border_post(parent, LV_PART_MAIN)) return false;
+        if(has_draw_event_cb(parent, LV_EVENT_DRAW_POST_BEGIN)) return false;
+    }
+
+    /*The border and the rounded corners stay in place*/
+    int32_t w = lv_obj_get_width(obj);
+    int32_t h = lv_obj_get_height(obj);
+    int32_t radius = LV_MIN(lv_obj_get_style_radius(obj, LV_PART_MAIN), LV_MIN(w, h) / 2);
+    int32_t border_w = LV_MAX(radius, lv_obj_get_style_border_width(obj, LV_PART_MAIN));
+    *area = obj->coords;
+    lv_area_increase(area, -border_w, -border_w);
+    if(area->x1 > area->x2 || area->y1 > area->y2) return false;
+
+    if(!lv_obj_area_is_visible(obj, area)) return false;
+
+    lv_area_t disp_area = {0, 0, lv_display_get_horizontal_resolution(disp) - 1, lv_display_get_vertical_resolution(disp) - 1};
+    return _lv_area_intersect(area, area, &disp_area);
+}
+
+/**
+ * Tell if an object has an event callback which can draw on the object
+ * @param obj       pointer to an object
+ * @param first     the first drawing event to consider, e.g. `LV_EVENT_DRAW_POST_BEGIN`
+ * @return          true: there is such an event callback
+ */
+static bool has_draw_event_cb(lv_obj_t * obj, lv_event_code_t first)
+{
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        lv_event_dsc_t * dsc = lv_obj_get_event_dsc(obj, i);
+        uint32_t filter = dsc->filter & ~LV_EVENT_PREPROCESS;
+        if(filter == LV_EVENT_ALL || (filter >= (uint32_t)first && filter <= LV_EVENT_DRAW_POST_END)) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Invalidate the objects which don't move with the scrolled content but are drawn on it.
+ * They are the floating children, the siblings drawn later and the layers above the object.
+ * @param obj       pointer to the scrolled object
+ * @param area      the area where the content is shifted
+ * @param x         the horizontal shift
+ * @param y         the vertical shift
+ */
+static void scroll_blit_invalidate_overlays(lv_obj_t * obj, const lv_area_t * area, int32_t x, int32_t y)
+{
+    lv_display_t * disp = lv_obj_get_display(obj);
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    uint32_t i;
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) scroll_blit_invalidate_obj(disp, area, child, x, y);
+    }
+
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent) {
+        child_cnt = lv_obj_get_child_count(parent);
+        for(i = (uint32_t)lv_obj_get_index(obj) + 1; i < child_cnt; i++) {
+            scroll_blit_invalidate_obj(disp, area, parent->spec_attr->children[i], x, y);
+        }
+        obj = parent;
+        parent = lv_obj_get_parent(parent);
+    }
+
+    /*`obj` is the screen now, so check the layers drawn after it*/
+    lv_obj_t * layers[] = {disp->bottom_layer, disp->act_scr, disp->top_layer, disp->sys_layer};
+    bool above = false;
+    for(i = 0; i < sizeof(layers) / sizeof(layers[0]); i++) {
+        if(layers[i] == NULL) continue;
+        if(!above) {
+            above = layers[i] == obj;
+            continue;
+        }
+
+        if(lv_obj_get_style_bg_opa(layers[i], LV_PART_MAIN) > LV_OPA_TRANSP) {
+            scroll_blit_invalidate_overlay(disp, area, NULL, x, y);
+            continue;
+        }
+
+        child_cnt = lv_obj_get_child_count(layers[i]);
+        uint32_t j;
+        for(j = 0; j < child_cnt; j++) {
+            scroll_blit_invalidate_obj(disp, area, layers[i]->spec_attr->children[j], x, y);
+        }
+    }
+}
+
+/**
+ * Invalidate an object which is drawn on the scrolled content but doesn't move with it
+ * @param disp      pointer to the display of the scrolled object
+ * @param area      the area where the content is shifted
+ * @param overlay   pointer to the object drawn on the content
+ * @param x         the horizontal shift
+ * @param y         the vertical shift
+ */
+static void scroll_blit_invalidate_obj(lv_display_t * disp, const lv_area_t * area, lv_obj_t * overlay,
+                                       int32_t x, int32_t y)
+{
+    if(lv_obj_has_flag(overlay, LV_OBJ_FLAG_HIDDEN)) return;
+
+    /*The children can be anywhere*/
+    if(lv_obj_has_flag(overlay, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        scroll_blit_invalidate_overlay(disp, area, NULL, x, y);
+        return;
+    }
+
+    lv_area_t overlay_area = overlay->coords;
+    int32_t ext_size = _lv_obj_get_ext_draw_size(overlay);
+    lv_area_increase(&overlay_area, ext_size, ext_size);
+    lv_obj_get_transformed_area(overlay, &overlay_area, LV_OBJ_POINT_TRANSFORM_FLAG_RECURSIVE);
+    scroll_blit_invalidate_overlay(disp, area, &overlay_area, x, y);
+}
+
+/**
+ * Invalidate an area drawn on the scrolled content which doesn't move with it.
+ * Its pixels were shifted with the content, so the shifted area is invalidated too.
+ * @param disp          pointer to the display of the scrolled object
+ * @param area          the area where the content is shifted
+ * @param overlay_area  the area drawn on the content (absolute coordinates), NULL: the whole `area`
+ * @param x             the horizontal shift
+ * @param y             the vertical shift
+ */
+static void scroll_blit_invalidate_overlay(lv_display_t * disp, const lv_area_t * area, const lv_area_t * overlay_area,
+                                           int32_t x, int32_t y)
+{
+    if(overlay_area == NULL) {
+        _lv_inv_area(disp, area);
+        return;
+    }
+
+    lv_area_t a;
+    if(!_lv_area_intersect(&a, overlay_area, area)) return;
+    _lv_inv_area(disp, &a);
+
+    lv_area_move(&a, x, y);
+    if(_lv_area_intersect(&a, &a, area)) _lv_inv_area(disp, &a);
+}
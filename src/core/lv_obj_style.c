@@ -20,6 +20,11 @@
 #define style_trans_ll_p &(LV_GLOBAL_DEFAULT()->style_trans_ll)
 #define _style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define STYLE_PROP_SHIFTED(prop) ((uint32_t)1 << ((prop) >> 3))
+#define style_value_cache_epoch LV_GLOBAL_DEFAULT()->style_value_cache_epoch
+
+#if LV_OBJ_STYLE_VALUE_CACHE & (LV_OBJ_STYLE_VALUE_CACHE - 1)
+#error "LV_OBJ_STYLE_VALUE_CACHE must be a power of 2"
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -65,6 +70,9 @@ static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
+#if LV_OBJ_STYLE_VALUE_CACHE
+static _lv_obj_style_value_cache_entry_t * get_value_cache_entry(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -92,6 +100,13 @@ void _lv_obj_style_deinit(void)
     }
 }
 
+void _lv_obj_style_value_cache_invalidate(void)
+{
+#if LV_OBJ_STYLE_VALUE_CACHE
+    style_value_cache_epoch++;
+#endif
+}
+
 void lv_obj_add_style(lv_obj_t * obj, const lv_style_t * style, lv_style_selector_t selector)
 {
     LV_ASSERT(obj->style_cnt < 63);
@@ -273,9 +288,9 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
-    if(!style_refr) return;
+    _lv_obj_style_value_cache_invalidate();
 
-    lv_obj_invalidate(obj);
+    if(!style_refr) return;
 
     lv_part_t part = lv_obj_style_get_selector_part(selector);
 
@@ -284,6 +299,12 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     bool is_inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE);
     bool is_layer_refr = lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_LAYER_UPDATE);
 
+    /*If only the look of the scrollbars changes (e.g. they fade in) don't redraw the whole object*/
+    bool is_scrollbar_only = part == LV_PART_SCROLLBAR && prop != LV_STYLE_PROP_ANY && !is_layout_refr && !is_ext_draw;
+
+    if(is_scrollbar_only) lv_obj_scrollbar_invalidate(obj);
+    else lv_obj_invalidate(obj);
+
     if(is_layout_refr) {
         if(part == LV_PART_ANY ||
            part == LV_PART_MAIN ||
@@ -306,7 +327,9 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
     if(prop == LV_STYLE_PROP_ANY || is_ext_draw) {
         lv_obj_refresh_ext_draw_size(obj);
     }
-    lv_obj_invalidate(obj);
+
+    if(is_scrollbar_only) lv_obj_scrollbar_invalidate(obj);
+    else lv_obj_invalidate(obj);
 
     if(prop == LV_STYLE_PROP_ANY || (is_inheritable && (is_ext_draw || is_layout_refr))) {
         if(part != LV_PART_SCROLLBAR) {
@@ -324,14 +347,35 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
 {
     LV_ASSERT_NULL(obj)
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+    /*Transitions are skipped only temporarily so don't cache the values in this case*/
+    _lv_obj_style_value_cache_entry_t * entry = NULL;
+    if(!obj->skip_trans) {
+        /*The cache is not part of the object's style so it can be updated even for constant objects*/
+        entry = get_value_cache_entry((lv_obj_t *)obj, part, prop);
+        if(entry && entry->prop == prop && entry->part == (part >> 16) && entry->state == obj->state) {
+            return entry->value;
+        }
+    }
+#endif
+
     lv_style_selector_t selector = part | obj->state;
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
     found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+    if(found != LV_STYLE_RES_FOUND) value_act = lv_style_prop_get_default(prop);
+
+#if LV_OBJ_STYLE_VALUE_CACHE
+    if(entry) {
+        entry->value = value_act;
+        entry->state = obj->state;
+        entry->prop = prop;
+        entry->part = part >> 16;
+    }
+#endif
 
-    return lv_style_prop_get_default(prop);
+    return value_act;
 }
 
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
@@ -692,7 +736,7 @@ static lv_style_res_t get_prop_core(const lv_obj_t * obj, lv_style_selector_t se
                                     lv_style_value_t * v)
 {
 
-    const uint32_t group = (uint32_t)1 << _lv_style_get_prop_group(prop);
+    const uint64_t group = (uint64_t)1 << _lv_style_get_prop_group(prop);
     const lv_part_t part = lv_obj_style_get_selector_part(selector);
     const lv_state_t state = lv_obj_style_get_selector_state(selector);
     const lv_state_t state_inv = ~state;
@@ -1118,3 +1162,34 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 
     return LV_STYLE_RES_NOT_FOUND;
 }
+
+#if LV_OBJ_STYLE_VALUE_CACHE
+/**
+ * Get the entry of the value cache where the value of a property should be stored.
+ * The cache is allocated and the outdated entries are cleared here.
+ * @param obj       pointer to an object
+ * @param part      the part of the object
+ * @param prop      the property
+ * @return          pointer to the entry which might store an other property. NULL on allocation error.
+ */
+static _lv_obj_style_value_cache_entry_t * get_value_cache_entry(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    _lv_obj_style_value_cache_t * cache = obj->style_value_cache;
+    if(cache == NULL) {
+        cache = lv_malloc(sizeof(_lv_obj_style_value_cache_t));
+        if(cache == NULL) return NULL;
+        /*Make sure it's cleared below*/
+        cache->epoch = style_value_cache_epoch - 1;
+        obj->style_value_cache = cache;
+    }
+
+    if(cache->epoch != style_value_cache_epoch) {
+        /*LV_STYLE_PROP_INV is 0 so it marks all entries as empty*/
+        lv_memzero(cache->entries, sizeof(cache->entries));
+        cache->epoch = style_value_cache_epoch;
+    }
+
+    uint32_t id = (uint32_t)prop * 3 + (part >> 16) * 29 + obj->state;
+    return &cache->entries[id & (LV_OBJ_STYLE_VALUE_CACHE - 1)];
+}
+#endif
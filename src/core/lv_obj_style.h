@@ -62,6 +62,20 @@ typedef struct {
     void * user_data;
 } _lv_obj_style_transition_dsc_t;
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+typedef struct {
+    lv_style_value_t value;
+    lv_state_t state;
+    lv_style_prop_t prop;   /**< LV_STYLE_PROP_INV: the entry is empty*/
+    uint8_t part;           /**< The part shifted to the lowest bits*/
+} _lv_obj_style_value_cache_entry_t;
+
+typedef struct {
+    uint32_t epoch;         /**< The entries are valid only if it equals to the global epoch*/
+    _lv_obj_style_value_cache_entry_t entries[LV_OBJ_STYLE_VALUE_CACHE];
+} _lv_obj_style_value_cache_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -78,6 +92,12 @@ void _lv_obj_style_init(void);
  */
 void _lv_obj_style_deinit(void);
 
+/**
+ * Mark the cached style values of all objects as invalid.
+ * Needs to be called if the resolved style values might have changed (e.g. the state or the parent of an object).
+ */
+void _lv_obj_style_value_cache_invalidate(void);
+
 /**
  * Add a style to an object.
  * @param obj       pointer to an object
@@ -34,8 +34,12 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static int64_t get_join_gain(const lv_area_t * a1, const lv_area_t * a2);
+static bool inv_area_make_space(lv_display_t * disp, const lv_area_t * area_p);
+static void inv_areas_remove_overlaps(lv_display_t * disp);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
+static void refr_scroll_blits(void);
 static void refr_area(const lv_area_t * area_p);
 static void refr_area_part(lv_layer_t * layer);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
@@ -43,6 +47,11 @@ static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj);
 static void refr_obj(lv_layer_t * layer, lv_obj_t * obj);
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h);
 static void draw_buf_flush(lv_display_t * disp);
+static bool is_pipelined(lv_display_t * disp);
+static lv_layer_t * get_part_layer(lv_display_t * disp);
+static void draw_buf_flush_pipelined(lv_display_t * disp, lv_layer_t * layer);
+static void flush_pending_part(lv_display_t * disp);
+static void wait_for_layer_ready(lv_layer_t * layer);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 static void wait_for_flushing(lv_display_t * disp);
 
@@ -291,18 +300,79 @@ void _lv_inv_area(lv_display_t * disp, const lv_area_t * area_p)
         if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
     }
 
-    /*Save the area*/
-    lv_area_t * tmp_area_p = &com_area;
-    if(disp->inv_p >= LV_INV_BUF_SIZE) { /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        tmp_area_p = &scr_area;
+    /*If there is no place for the area join the two areas which are the cheapest to join*/
+    if(disp->inv_p >= LV_INV_BUF_SIZE) {
+        if(inv_area_make_space(disp, &com_area)) {
+            lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
+            return;
+        }
     }
-    lv_area_copy(&disp->inv_areas[disp->inv_p], tmp_area_p);
+
+    /*Save the area*/
+    lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
     disp->inv_p++;
 
     lv_display_send_event(disp, LV_EVENT_REFR_REQUEST, NULL);
 }
 
+bool _lv_inv_area_shift(lv_display_t * disp, const lv_area_t * area_p, int32_t x, int32_t y)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) return false;
+    if(!disp->scroll_blit || disp->render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) return false;
+    if(!lv_display_is_invalidation_enabled(disp)) return false;
+    if(disp->scroll_blit_cnt >= LV_SCROLL_BLIT_BUF_SIZE) return false;
+
+    LV_ASSERT_MSG(!disp->rendering_in_progress, "Invalidate area is not allowed during rendering.");
+
+    lv_area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = lv_display_get_horizontal_resolution(disp) - 1;
+    scr_area.y2 = lv_display_get_vertical_resolution(disp) - 1;
+    if(!_lv_area_is_in(area_p, &scr_area, 0)) return false;
+
+    /*Nothing remains from the old content*/
+    if(LV_ABS(x) >= lv_area_get_width(area_p) || LV_ABS(y) >= lv_area_get_height(area_p)) return false;
+
+    /*The area is flushed as it is, so it can't be shifted if the display would modify it (e.g. round it)*/
+    lv_area_t com_area = *area_p;
+    lv_result_t res = lv_display_send_event(disp, LV_EVENT_INVALIDATE_AREA, &com_area);
+    if(res != LV_RESULT_OK || !_lv_area_is_equal(&com_area, area_p)) return false;
+
+    /*The already invalidated parts are shifted too, so redraw them at their new position*/
+    lv_area_t moved_areas[LV_INV_BUF_SIZE];
+    uint32_t moved_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        lv_area_t * a = &moved_areas[moved_cnt];
+        if(!_lv_area_intersect(a, &disp->inv_areas[i], area_p)) continue;
+        lv_area_move(a, x, y);
+        if(_lv_area_intersect(a, a, area_p)) moved_cnt++;
+    }
+
+    disp->scroll_blit_areas[disp->scroll_blit_cnt] = *area_p;
+    disp->scroll_blit_ofs[disp->scroll_blit_cnt].x = x;
+    disp->scroll_blit_ofs[disp->scroll_blit_cnt].y = y;
+    disp->scroll_blit_cnt++;
+
+    for(i = 0; i < moved_cnt; i++) {
+        _lv_inv_area(disp, &moved_areas[i]);
+    }
+
+    /*Redraw the parts which were shifted in from outside of the area*/
+    lv_area_t shifted_area = *area_p;
+    lv_area_move(&shifted_area, x, y);
+    lv_area_t exposed_areas[4];
+    int8_t exposed_cnt = _lv_area_diff(exposed_areas, area_p, &shifted_area);
+    int8_t j;
+    for(j = 0; j < exposed_cnt; j++) {
+        _lv_inv_area(disp, &exposed_areas[j]);
+    }
+
+    return true;
+}
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -354,23 +424,27 @@ void _lv_display_refr_timer(lv_timer_t * tmr)
 
     /*Refresh the screen's layout if required*/
     LV_PROFILER_BEGIN_TAG("layout");
+    uint32_t layout_update_cnt = LV_GLOBAL_DEFAULT()->layout_update_cnt;
     lv_obj_update_layout(disp_refr->act_scr);
     if(disp_refr->prev_scr) lv_obj_update_layout(disp_refr->prev_scr);
 
     lv_obj_update_layout(disp_refr->bottom_layer);
     lv_obj_update_layout(disp_refr->top_layer);
     lv_obj_update_layout(disp_refr->sys_layer);
+    disp_refr->layout_cnt = LV_GLOBAL_DEFAULT()->layout_update_cnt - layout_update_cnt;
     LV_PROFILER_END_TAG("layout");
 
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
+        disp_refr->scroll_blit_cnt = 0;
         LV_LOG_WARN("there is no active screen");
         goto refr_finish;
     }
 
     lv_refr_join_area();
     refr_sync_areas();
+    refr_scroll_blits();
     refr_invalid_areas();
 
     if(disp_refr->inv_p == 0) goto refr_finish;
@@ -401,6 +475,8 @@ refr_finish:
     _lv_draw_sw_mask_cleanup();
 #endif
 
+    _lv_draw_task_pool_trim();
+
     lv_display_send_event(disp_refr, LV_EVENT_REFR_READY, NULL);
 
     LV_TRACE_REFR("finished");
@@ -412,42 +488,152 @@ refr_finish:
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Join the areas where redrawing the joined area is cheaper than redrawing them separately
  */
 static void lv_refr_join_area(void)
 {
     LV_PROFILER_BEGIN;
-    uint32_t join_from;
-    uint32_t join_in;
+    lv_area_t * areas = disp_refr->inv_areas;
+    uint8_t * joined = disp_refr->inv_area_joined;
+
+    /*Always join the pair with the highest gain as joining them might make other joins unnecessary*/
+    while(1) {
+        uint32_t join_in = 0;
+        uint32_t join_from = 0;
+        int64_t gain_max = 0;
+        uint32_t i;
+        uint32_t j;
+        for(i = 0; i < disp_refr->inv_p; i++) {
+            if(joined[i]) continue;
+            for(j = i + 1; j < disp_refr->inv_p; j++) {
+                if(joined[j]) continue;
+
+                int64_t gain = get_join_gain(&areas[i], &areas[j]);
+                if(gain > gain_max) {
+                    gain_max = gain;
+                    join_in = i;
+                    join_from = j;
+                }
+            }
+        }
+
+        if(gain_max == 0) break;
+
+        _lv_area_join(&areas[join_in], &areas[join_in], &areas[join_from]);
+
+        /*Mark 'join_form' is joined into 'join_in'*/
+        joined[join_from] = 1;
+    }
+
+    inv_areas_remove_overlaps(disp_refr);
+    LV_PROFILER_END;
+}
+
+/**
+ * Get how much cheaper it is to redraw the joined area of two areas than the areas separately
+ * @param a1    pointer to an area
+ * @param a2    pointer to an other area
+ * @return      the saved pixels (can be negative)
+ */
+static int64_t get_join_gain(const lv_area_t * a1, const lv_area_t * a2)
+{
     lv_area_t joined_area;
-    for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
-        if(disp_refr->inv_area_joined[join_in] != 0) continue;
+    _lv_area_join(&joined_area, a1, a2);
 
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
+    /*The common parts would be redrawn twice if they were not joined*/
+    int64_t separate = (int64_t)lv_area_get_size(a1) + lv_area_get_size(a2) + LV_REFR_AREA_OVERHEAD;
+    return separate - (int64_t)lv_area_get_size(&joined_area);
+}
 
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
+/**
+ * Make space for a new invalidated area by joining the two areas which are the cheapest to join.
+ * The new area is also considered, so it might be joined into a saved area.
+ * @param disp      pointer to display whose `inv_areas` is full
+ * @param area_p    the new area
+ * @return          true: `area_p` was joined into a saved area; false: there is space to save `area_p`
+ */
+static bool inv_area_make_space(lv_display_t * disp, const lv_area_t * area_p)
+{
+    lv_area_t * areas = disp->inv_areas;
+    uint32_t join_in = 0;
+    uint32_t join_from = 0;
+    int64_t gain_max = INT64_MIN;
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < disp->inv_p; i++) {
+        /*`inv_p` means the new area*/
+        for(j = i + 1; j <= disp->inv_p; j++) {
+            int64_t gain = get_join_gain(&areas[i], j == disp->inv_p ? area_p : &areas[j]);
+            if(gain > gain_max) {
+                gain_max = gain;
+                join_in = i;
+                join_from = j;
             }
+        }
+    }
+
+    if(join_from == disp->inv_p) {
+        _lv_area_join(&areas[join_in], &areas[join_in], area_p);
+        return true;
+    }
 
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+    _lv_area_join(&areas[join_in], &areas[join_in], &areas[join_from]);
+    disp->inv_p--;
+    areas[join_from] = areas[disp->inv_p];
+    return false;
+}
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+/**
+ * Cut the overlapping parts from the not joined invalidated areas to not redraw them twice.
+ * It's done only if the saved pixels are more than the overhead of the new areas
+ * and there is place for the new areas.
+ * @param disp      pointer to a display
+ */
+static void inv_areas_remove_overlaps(lv_display_t * disp)
+{
+    lv_area_t * areas = disp->inv_areas;
+    uint8_t * joined = disp->inv_area_joined;
+    uint32_t i;
+    uint32_t j;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(joined[i]) continue;
+        for(j = 0; j < disp->inv_p; j++) {
+            if(joined[j] || i == j) continue;
+
+            lv_area_t com;
+            if(!_lv_area_intersect(&com, &areas[i], &areas[j])) continue;
+
+            lv_area_t res[4];
+            int8_t res_c = _lv_area_diff(res, &areas[j], &areas[i]);
+            if(res_c > 1 && lv_area_get_size(&com) <= (uint32_t)(res_c - 1) * LV_REFR_AREA_OVERHEAD) continue;
+
+            /*Find places for the new areas (reuse the joined ones too)*/
+            uint32_t places[3];
+            uint32_t place_cnt = 0;
+            uint32_t k;
+            for(k = 0; k < disp->inv_p && place_cnt + 1 < (uint32_t)res_c; k++) {
+                if(joined[k]) places[place_cnt++] = k;
+            }
+            while(place_cnt + 1 < (uint32_t)res_c && disp->inv_p + place_cnt < LV_INV_BUF_SIZE) {
+                places[place_cnt] = disp->inv_p + place_cnt;
+                place_cnt++;
+            }
+            if(place_cnt + 1 < (uint32_t)res_c) continue;
+
+            if(res_c == 0) {
+                joined[j] = 1;
+                continue;
+            }
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
+            areas[j] = res[0];
+            for(k = 1; k < (uint32_t)res_c; k++) {
+                uint32_t p = places[k - 1];
+                areas[p] = res[k];
+                joined[p] = 0;
+                if(p >= disp->inv_p) disp->inv_p = p + 1;
             }
         }
     }
-    LV_PROFILER_END;
 }
 
 /**
@@ -477,13 +663,14 @@ static void refr_sync_areas(void)
     uint32_t hor_res = lv_display_get_horizontal_resolution(disp_refr);
     uint32_t ver_res = lv_display_get_vertical_resolution(disp_refr);
 
-    /*Iterate through invalidated areas to see if sync area should be copied*/
+    /*Iterate through invalidated areas to see if sync area should be copied.
+     *If areas will be shifted they need the whole last frame, so copy everything in that case.*/
     uint16_t i;
     int8_t j;
     lv_area_t res[4] = {0};
     int8_t res_c;
     lv_area_t * sync_area, * new_area, * next_area;
-    for(i = 0; i < disp_refr->inv_p; i++) {
+    for(i = 0; i < disp_refr->inv_p && disp_refr->scroll_blit_cnt == 0; i++) {
         /*Skip joined areas*/
         if(disp_refr->inv_area_joined[i]) continue;
 
@@ -528,11 +715,63 @@ static void refr_sync_areas(void)
     LV_PROFILER_END;
 }
 
+/**
+ * Shift the content of the scrolled areas in the draw buffer and flush them
+ */
+static void refr_scroll_blits(void)
+{
+    if(disp_refr->scroll_blit_cnt == 0) return;
+
+    LV_PROFILER_BEGIN;
+    /*Don't modify the buffer while it's being sent to the display*/
+    wait_for_flushing(disp_refr);
+
+    lv_draw_buf_t * buf = disp_refr->buf_act;
+    lv_area_t disp_area = {0, 0, lv_display_get_horizontal_resolution(disp_refr) - 1, lv_display_get_vertical_resolution(disp_refr) - 1};
+    uint32_t i;
+    for(i = 0; i < disp_refr->scroll_blit_cnt; i++) {
+        const lv_area_t * area = &disp_refr->scroll_blit_areas[i];
+        const lv_point_t * ofs = &disp_refr->scroll_blit_ofs[i];
+
+        /*The resolution might have changed since the scrolling*/
+        if(!_lv_area_is_in(area, &disp_area, 0)) continue;
+
+        /*Copy the part which remains in the area after shifting*/
+        lv_area_t dest_area = *area;
+        lv_area_move(&dest_area, ofs->x, ofs->y);
+        if(!_lv_area_intersect(&dest_area, &dest_area, area)) continue;
+        lv_area_t src_area = dest_area;
+        lv_area_move(&src_area, -ofs->x, -ofs->y);
+        lv_draw_buf_copy(buf, &dest_area, buf, &src_area);
+        lv_draw_buf_flush_cache(buf, &dest_area);
+
+        /*Send the shifted content to the display too*/
+        wait_for_flushing(disp_refr);
+        disp_refr->flushing = 1;
+        disp_refr->flushing_last = 0;
+        if(disp_refr->flush_cb) {
+            call_flush_cb(disp_refr, area, buf->data);
+        }
+
+        /*The other buffer needs the shifted content too*/
+        if(lv_display_is_double_buffered(disp_refr)) {
+            lv_area_t * sync_area = _lv_ll_ins_tail(&disp_refr->sync_areas);
+            *sync_area = *area;
+        }
+    }
+
+    disp_refr->scroll_blit_cnt = 0;
+    LV_PROFILER_END;
+}
+
 /**
  * Refresh the joined areas
  */
 static void refr_invalid_areas(void)
 {
+    disp_refr->refr_px_cnt = 0;
+    disp_refr->flush_cnt = 0;
+
     if(disp_refr->inv_p == 0) return;
     LV_PROFILER_BEGIN;
 
@@ -560,9 +799,13 @@ static void refr_invalid_areas(void)
             if(i == last_i) disp_refr->last_area = 1;
             disp_refr->last_part = 0;
             refr_area(&disp_refr->inv_areas[i]);
+            disp_refr->refr_px_cnt += lv_area_get_size(&disp_refr->inv_areas[i]);
         }
     }
 
+    /*In pipelined mode the last part is still being rendered*/
+    if(disp_refr->layer_pending) flush_pending_part(disp_refr);
+
     disp_refr->rendering_in_progress = false;
     LV_PROFILER_END;
 }
@@ -590,11 +833,11 @@ static void refr_area(const lv_area_t * area_p)
 {
     LV_PROFILER_BEGIN;
     lv_layer_t * layer = disp_refr->layer_head;
-    layer->draw_buf = disp_refr->buf_act;
 
     /*With full refresh just redraw directly into the buffer*/
     /*In direct mode draw directly on the absolute coordinates of the buffer*/
     if(disp_refr->render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        layer->draw_buf = disp_refr->buf_act;
         layer->buf_area.x1 = 0;
         layer->buf_area.y1 = 0;
         layer->buf_area.x2 = lv_display_get_horizontal_resolution(disp_refr) - 1;
@@ -636,6 +879,7 @@ static void refr_area(const lv_area_t * area_p)
         sub_area.x2 = area_p->x2;
         sub_area.y1 = row;
         sub_area.y2 = row + max_row - 1;
+        layer = get_part_layer(disp_refr);
         layer->draw_buf = disp_refr->buf_act;
         layer->buf_area = sub_area;
         layer->_clip_area = sub_area;
@@ -653,6 +897,7 @@ static void refr_area(const lv_area_t * area_p)
         sub_area.x2 = area_p->x2;
         sub_area.y1 = row;
         sub_area.y2 = y2;
+        layer = get_part_layer(disp_refr);
         layer->draw_buf = disp_refr->buf_act;
         layer->buf_area = sub_area;
         layer->_clip_area = sub_area;
@@ -669,8 +914,10 @@ static void refr_area_part(lv_layer_t * layer)
     disp_refr->refreshed_area = layer->_clip_area;
 
     /* In single buffered mode wait here until the buffer is freed.
-     * Else we would draw into the buffer while it's still being transferred to the display*/
-    if(!lv_display_is_double_buffered(disp_refr)) {
+     * Else we would draw into the buffer while it's still being transferred to the display.
+     * In pipelined mode the previous part is rendered into the other buffer, therefore the part before it
+     * (which was flushed from this buffer) needs to be flushed.*/
+    if(!lv_display_is_double_buffered(disp_refr) || (is_pipelined(disp_refr) && disp_refr->layer_pending)) {
         wait_for_flushing(disp_refr);
     }
     /*If the screen is transparent initialize it when the flushing is ready*/
@@ -723,7 +970,8 @@ static void refr_area_part(lv_layer_t * layer)
     refr_obj_and_children(layer, lv_display_get_layer_top(disp_refr));
     refr_obj_and_children(layer, lv_display_get_layer_sys(disp_refr));
 
-    draw_buf_flush(disp_refr);
+    if(is_pipelined(disp_refr)) draw_buf_flush_pipelined(disp_refr, layer);
+    else draw_buf_flush(disp_refr);
     LV_PROFILER_END;
 }
 
@@ -1012,10 +1260,7 @@ static void draw_buf_flush(lv_display_t * disp)
     /*Flush the rendered content to the display*/
     lv_layer_t * layer = disp->layer_head;
 
-    while(layer->draw_task_head) {
-        lv_draw_dispatch_wait_for_request();
-        lv_draw_dispatch();
-    }
+    wait_for_layer_ready(layer);
 
     /* In double buffered mode wait until the other buffer is freed
      * and driver is ready to receive the new buffer.
@@ -1046,6 +1291,98 @@ static void draw_buf_flush(lv_display_t * disp)
     }
 }
 
+/**
+ * In double buffered partial mode the draw tasks of the next part can be created while
+ * the draw units are still rendering the previous part in the other buffer.
+ * @param disp      pointer to a display
+ * @return          true: the parts are rendered and flushed in a pipeline
+ */
+static bool is_pipelined(lv_display_t * disp)
+{
+    return disp->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL && lv_display_is_double_buffered(disp);
+}
+
+/**
+ * Get the layer where the next part should be drawn.
+ * In pipelined mode it's the layer which is not being rendered.
+ * @param disp      pointer to a display
+ * @return          `layer_head` or `layer_pipe` of the display
+ */
+static lv_layer_t * get_part_layer(lv_display_t * disp)
+{
+    if(disp->layer_pending != disp->layer_head) return disp->layer_head;
+
+    if(disp->layer_pipe == NULL) {
+        lv_layer_t * layer = lv_malloc_zeroed(sizeof(lv_layer_t));
+        LV_ASSERT_MALLOC(layer);
+        if(disp->layer_init) disp->layer_init(disp, layer);
+        layer->color_format = disp->color_format;
+
+        /*Add it to the display's layers to get its draw tasks dispatched*/
+        layer->next = disp->layer_head->next;
+        disp->layer_head->next = layer;
+        disp->layer_pipe = layer;
+    }
+
+    return disp->layer_pipe;
+}
+
+/**
+ * Flush the previous part and let the current one be rendered while the next part is created
+ * @param disp      pointer to a display
+ * @param layer     the layer where the draw tasks of the current part were just added
+ */
+static void draw_buf_flush_pipelined(lv_display_t * disp, lv_layer_t * layer)
+{
+    /*The draw units are already working on this part, so flush the previous one meanwhile*/
+    if(disp->layer_pending) flush_pending_part(disp);
+
+    disp->layer_pending = layer;
+    disp->pending_area = disp->refreshed_area;
+    disp->pending_last = disp->last_area && disp->last_part;
+
+    /*Draw the next part to the other buffer*/
+    if(disp->buf_act == disp->buf_1) {
+        disp->buf_act = disp->buf_2;
+    }
+    else {
+        disp->buf_act = disp->buf_1;
+    }
+}
+
+/**
+ * Wait until the pending part is rendered and flush it
+ * @param disp      pointer to a display with `layer_pending`
+ */
+static void flush_pending_part(lv_display_t * disp)
+{
+    lv_layer_t * layer = disp->layer_pending;
+    wait_for_layer_ready(layer);
+
+    /*Only one part can be flushed at a time*/
+    wait_for_flushing(disp);
+
+    disp->flushing = 1;
+    disp->flushing_last = disp->pending_last;
+    disp->layer_pending = NULL;
+
+    if(disp->flush_cb) {
+        call_flush_cb(disp, &disp->pending_area, layer->draw_buf->data);
+    }
+}
+
+/**
+ * Dispatch the draw tasks of a layer until all of them are rendered
+ * @param layer     pointer to a layer
+ */
+static void wait_for_layer_ready(lv_layer_t * layer)
+{
+    while(layer->draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+}
+
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
 {
     LV_PROFILER_BEGIN;
@@ -1067,6 +1404,7 @@ static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t *
 #endif
 
     disp->flush_cb(disp, &offset_area, px_map);
+    disp->flush_cnt++;
     lv_display_send_event(disp, LV_EVENT_FLUSH_FINISH, &offset_area);
 
     LV_PROFILER_END;
@@ -75,6 +75,20 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj);
  */
 void _lv_inv_area(lv_display_t * disp, const lv_area_t * area_p);
 
+/**
+ * Shift the rendered content of an area in the draw buffer instead of redrawing it.
+ * It's done on the next refresh, before the invalidated areas are redrawn.
+ * The parts of the area which were shifted in from outside are invalidated
+ * and so are the already invalidated parts at their shifted position.
+ * Works only in direct render mode if enabled by `lv_display_set_scroll_blit()`.
+ * @param disp      pointer to display where the area should be shifted
+ * @param area_p    the area to shift. The content is shifted within this area.
+ * @param x         shift the content horizontally by this amount
+ * @param y         shift the content vertically by this amount
+ * @return          true: the area will be shifted; false: the area can't be shifted, invalidate it instead
+ */
+bool _lv_inv_area_shift(lv_display_t * disp, const lv_area_t * area_p, int32_t x, int32_t y);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
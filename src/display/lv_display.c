@@ -198,6 +198,11 @@ void lv_display_delete(lv_display_t * disp)
     if(disp->layer_deinit) disp->layer_deinit(disp, disp->layer_head);
     lv_free(disp->layer_head);
 
+    if(disp->layer_pipe) {
+        if(disp->layer_deinit) disp->layer_deinit(disp, disp->layer_pipe);
+        lv_free(disp->layer_pipe);
+    }
+
     lv_free(disp);
 
     if(was_default) lv_display_set_default(_lv_ll_get_head(disp_ll_p));
@@ -440,6 +445,16 @@ void lv_display_set_render_mode(lv_display_t * disp, lv_display_render_mode_t re
 {
     if(disp == NULL) disp = lv_display_get_default();
     if(disp == NULL) return;
+
+    /*The scrolled areas can be shifted only in direct mode, so redraw them instead*/
+    if(render_mode != LV_DISPLAY_RENDER_MODE_DIRECT) {
+        uint32_t i;
+        for(i = 0; i < disp->scroll_blit_cnt; i++) {
+            _lv_inv_area(disp, &disp->scroll_blit_areas[i]);
+        }
+        disp->scroll_blit_cnt = 0;
+    }
+
     disp->render_mode = render_mode;
 }
 
@@ -466,6 +481,7 @@ void lv_display_set_color_format(lv_display_t * disp, lv_color_format_t color_fo
 
     disp->color_format = color_format;
     disp->layer_head->color_format = color_format;
+    if(disp->layer_pipe) disp->layer_pipe->color_format = color_format;
     if(disp->buf_1) disp->buf_1->header.cf = color_format;
     if(disp->buf_2) disp->buf_2->header.cf = color_format;
 
@@ -496,6 +512,22 @@ bool lv_display_get_antialiasing(lv_display_t * disp)
     return disp->antialiasing;
 }
 
+void lv_display_set_scroll_blit(lv_display_t * disp, bool en)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return;
+
+    disp->scroll_blit = en;
+}
+
+bool lv_display_get_scroll_blit(lv_display_t * disp)
+{
+    if(disp == NULL) disp = lv_display_get_default();
+    if(disp == NULL) return false;
+
+    return disp->scroll_blit;
+}
+
 LV_ATTRIBUTE_FLUSH_READY void lv_display_flush_ready(lv_display_t * disp)
 {
     disp->flushing = 0;
@@ -879,6 +911,30 @@ bool lv_display_is_invalidation_enabled(lv_display_t * disp)
     return (disp->inv_en_cnt > 0);
 }
 
+uint32_t lv_display_get_refr_px_cnt(lv_display_t * disp)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) return 0;
+
+    return disp->refr_px_cnt;
+}
+
+uint32_t lv_display_get_flush_cnt(lv_display_t * disp)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) return 0;
+
+    return disp->flush_cnt;
+}
+
+uint32_t lv_display_get_layout_cnt(lv_display_t * disp)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) return 0;
+
+    return disp->layout_cnt;
+}
+
 lv_timer_t * lv_display_get_refr_timer(lv_display_t * disp)
 {
     if(!disp) disp = lv_display_get_default();
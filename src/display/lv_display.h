@@ -305,6 +305,24 @@ void lv_display_set_antialiasing(lv_display_t * disp, bool en);
  */
 bool lv_display_get_antialiasing(lv_display_t * disp);
 
+/**
+ * Enable scrolling by shifting the already rendered content in the draw buffer.
+ * When an object is scrolled only the newly exposed parts and the scrollbars are redrawn
+ * instead of the whole object. Used only in `LV_DISPLAY_RENDER_MODE_DIRECT` and only for objects
+ * which can be shifted safely (e.g. plain containers and lists with an opaque, uniform background
+ * and no transformation). Otherwise the object is invalidated as usual.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @param en        true/false
+ */
+void lv_display_set_scroll_blit(lv_display_t * disp, bool en);
+
+/**
+ * Get if the scrolled content is shifted in the draw buffer instead of being redrawn
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          true/false
+ */
+bool lv_display_get_scroll_blit(lv_display_t * disp);
+
 //! @cond Doxygen_Suppress
 
 /**
@@ -516,6 +534,27 @@ void lv_display_enable_invalidation(lv_display_t * disp, bool en);
  */
 bool lv_display_is_invalidation_enabled(lv_display_t * disp);
 
+/**
+ * Get the number of pixels redrawn during the last refresh.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          number of redrawn pixels
+ */
+uint32_t lv_display_get_refr_px_cnt(lv_display_t * disp);
+
+/**
+ * Get how many times `flush_cb` was called during the last refresh.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          number of flushes
+ */
+uint32_t lv_display_get_flush_cnt(lv_display_t * disp);
+
+/**
+ * Get the number of objects whose layout was updated during the last refresh.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          number of updated layouts
+ */
+uint32_t lv_display_get_layout_cnt(lv_display_t * disp);
+
 /**
  * Get a pointer to the screen refresher timer to
  * modify its parameters with `lv_timer_...` functions.
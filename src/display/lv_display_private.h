@@ -29,6 +29,10 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas*/
 #endif
 
+#ifndef LV_SCROLL_BLIT_BUF_SIZE
+#define LV_SCROLL_BLIT_BUF_SIZE 8 /*Buffer size for the scrolled areas to shift before the next refresh*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -85,6 +89,7 @@ struct _lv_display_t {
     volatile int flushing_last;
     volatile uint32_t last_area         : 1; /*1: the last area is being rendered*/
     volatile uint32_t last_part         : 1; /*1: the last part of the current area is being rendered*/
+    uint32_t pending_last               : 1; /*1: `layer_pending` is the last part of the last area*/
 
     lv_display_render_mode_t render_mode;
     uint32_t antialiasing : 1;       /**< 1: anti-aliasing is enabled on this display.*/
@@ -100,15 +105,34 @@ struct _lv_display_t {
     uint32_t inv_p;
     int32_t inv_en_cnt;
 
+    /** Statistics of the last refresh*/
+    uint32_t refr_px_cnt;   /**< Number of redrawn pixels*/
+    uint32_t flush_cnt;     /**< Number of `flush_cb` calls*/
+    uint32_t layout_cnt;    /**< Number of objects whose layout was updated*/
+
     /** Double buffer sync areas (redrawn during last refresh) */
     lv_ll_t sync_areas;
 
+    /** Scrolled areas whose content will be shifted in the draw buffer before the next refresh*/
+    lv_area_t scroll_blit_areas[LV_SCROLL_BLIT_BUF_SIZE];
+    lv_point_t scroll_blit_ofs[LV_SCROLL_BLIT_BUF_SIZE];
+    uint32_t scroll_blit_cnt;
+    uint32_t scroll_blit : 1;   /**< 1: shift the scrolled content instead of redrawing it*/
+
     lv_draw_buf_t _static_buf1; /*Used when user pass in a raw buffer as display draw buffer*/
     lv_draw_buf_t _static_buf2;
     /*---------------------
      * Layer
      *--------------------*/
     lv_layer_t * layer_head;
+
+    /** In double buffered partial mode the draw tasks of the next part are created in this layer
+     *  while the previous part is still being rendered in `layer_head` (and vice versa)*/
+    lv_layer_t * layer_pipe;
+
+    /** The part which is being rendered but not flushed yet. NULL if there is no such part*/
+    lv_layer_t * layer_pending;
+    lv_area_t pending_area;
     void (*layer_init)(lv_display_t * disp, lv_layer_t * layer);
     void (*layer_deinit)(lv_display_t * disp, lv_layer_t * layer);
 
@@ -12,20 +12,77 @@
 #include "../core/lv_global.h"
 #include "../core/lv_refr.h"
 #include "../stdlib/lv_string.h"
+#if LV_USE_VECTOR_GRAPHIC
+    #include "lv_draw_vector.h"
+#endif
 
 /*********************
  *      DEFINES
  *********************/
 #define _draw_info LV_GLOBAL_DEFAULT()->draw_info
 
+/*The unfinished draw tasks of a layer are sorted into a grid of
+ *TASK_GRID_COLS x TASK_GRID_ROWS cells to find the overlapping tasks quickly.
+ *The cells are tracked in the 64 bit `_grid_mask` of the tasks.*/
+#define TASK_GRID_COLS  8
+#define TASK_GRID_ROWS  8
+
+/*Number of draw task slots allocated at once*/
+#define TASK_POOL_CHUNK_SLOT_CNT    32
+
 /**********************
  *      TYPEDEFS
  **********************/
+/*Union of the built-in draw descriptors to size the slots of the draw task pool*/
+typedef union {
+    lv_draw_fill_dsc_t fill;
+    lv_draw_border_dsc_t border;
+    lv_draw_box_shadow_dsc_t box_shadow;
+    lv_draw_label_dsc_t label;
+    lv_draw_image_dsc_t image;
+    lv_draw_line_dsc_t line;
+    lv_draw_arc_dsc_t arc;
+    lv_draw_triangle_dsc_t triangle;
+    lv_draw_mask_rect_dsc_t mask_rect;
+#if LV_USE_VECTOR_GRAPHIC
+    lv_draw_vector_task_dsc_t vector;
+#endif
+} task_slot_dsc_t;
+
+/*A draw task and its descriptor allocated together*/
+typedef struct {
+    lv_draw_task_t task;
+    task_slot_dsc_t dsc;
+} task_slot_t;
+
+typedef struct _task_pool_chunk_t {
+    struct _task_pool_chunk_t * next;
+    task_slot_t slots[TASK_POOL_CHUNK_SLOT_CNT];
+} task_pool_chunk_t;
+
+typedef struct {
+    lv_draw_task_t ** tasks;
+    uint32_t cnt;
+    uint32_t capacity;
+} task_grid_cell_t;
+
+typedef struct {
+    lv_area_t area;                 /**< The area covered by the cells. Areas out of it go to the border cells.*/
+    int32_t cell_w;
+    int32_t cell_h;
+    uint32_t task_cnt;              /**< Number of tasks added to the grid*/
+    uint32_t visit_id;              /**< Incremented on each grid walk to visit each task once*/
+    task_grid_cell_t cells[TASK_GRID_COLS * TASK_GRID_ROWS];
+} task_grid_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check);
+static void task_grid_add(lv_layer_t * layer, lv_draw_task_t * t);
+static void task_grid_remove(lv_layer_t * layer, lv_draw_task_t * t);
+static uint64_t task_grid_get_mask(const task_grid_t * grid, const lv_area_t * area);
+static lv_draw_task_t * task_pool_alloc(void);
+static void task_pool_free(lv_draw_task_t * t);
 
 static inline uint32_t get_layer_size_kb(uint32_t size_byte)
 {
@@ -60,6 +117,16 @@ void lv_draw_deinit(void)
     lv_thread_sync_delete(&_draw_info.sync);
 #endif
 
+    task_pool_chunk_t * chunk = _draw_info.task_pool_chunks;
+    while(chunk) {
+        task_pool_chunk_t * chunk_next = chunk->next;
+        lv_free(chunk);
+        chunk = chunk_next;
+    }
+    _draw_info.task_pool_chunks = NULL;
+    _draw_info.task_pool_free = NULL;
+    _draw_info.task_pool_used_cnt = 0;
+
     lv_draw_unit_t * u = _draw_info.unit_head;
     while(u) {
         lv_draw_unit_t * cur_unit = u;
@@ -84,28 +151,34 @@ void * lv_draw_create_unit(size_t size)
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
 {
     LV_PROFILER_BEGIN;
-    lv_draw_task_t * new_task = lv_malloc_zeroed(sizeof(lv_draw_task_t));
+    lv_draw_task_t * new_task = task_pool_alloc();
+    LV_ASSERT_MALLOC(new_task);
 
     new_task->area = *coords;
     new_task->_real_area = *coords;
     new_task->clip_area = layer->_clip_area;
     new_task->state = LV_DRAW_TASK_STATE_QUEUED;
+    new_task->_id = layer->_task_id_cnt;
+    layer->_task_id_cnt++;
 
-    /*Find the tail*/
     if(layer->draw_task_head == NULL) {
         layer->draw_task_head = new_task;
     }
     else {
-        lv_draw_task_t * tail = layer->draw_task_head;
-        while(tail->next) tail = tail->next;
-
-        tail->next = new_task;
+        layer->_draw_task_tail->next = new_task;
     }
+    layer->_draw_task_tail = new_task;
 
     LV_PROFILER_END;
     return new_task;
 }
 
+void * lv_draw_task_alloc_dsc(lv_draw_task_t * t, size_t size)
+{
+    if(size <= sizeof(task_slot_dsc_t)) return &((task_slot_t *)t)->dsc;
+    else return lv_malloc(size);
+}
+
 void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
 {
     LV_PROFILER_BEGIN;
@@ -135,6 +208,9 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
             u = u->next;
         }
 
+        /*The areas are final only now as they might be modified in LV_EVENT_DRAW_TASK_ADDED*/
+        task_grid_add(layer, t);
+
         lv_draw_dispatch();
     }
     else {
@@ -146,6 +222,8 @@ void lv_draw_finalize_task_creation(lv_layer_t * layer, lv_draw_task_t * t)
             if(u->evaluate_cb) u->evaluate_cb(u, t);
             u = u->next;
         }
+
+        task_grid_add(layer, t);
     }
     LV_PROFILER_END;
 }
@@ -181,6 +259,10 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
         if(t->state == LV_DRAW_TASK_STATE_READY) {
             if(t_prev) t_prev->next = t->next;      /*Remove it by assigning the next task to the previous*/
             else layer->draw_task_head = t_next;    /*If it was the head, set the next as head*/
+            if(layer->_draw_task_tail == t) layer->_draw_task_tail = t_prev;
+
+            /*Let the tasks waiting for this one know that it's finished*/
+            task_grid_remove(layer, t);
 
             /*If it was layer drawing free the layer too*/
             if(t->type == LV_DRAW_TASK_TYPE_LAYER) {
@@ -219,8 +301,7 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
                 draw_label_dsc->text = NULL;
             }
 
-            lv_free(t->draw_dsc);
-            lv_free(t);
+            task_pool_free(t);
         }
         else {
             t_prev = t;
@@ -228,6 +309,9 @@ bool lv_draw_dispatch_layer(lv_display_t * disp, lv_layer_t * layer)
         t = t_next;
     }
 
+    /*Restart the IDs to avoid overflow*/
+    if(layer->draw_task_head == NULL) layer->_task_id_cnt = 0;
+
     bool render_running = false;
 
     /*This layer is ready, enable blending its buffer*/
@@ -299,10 +383,11 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
 
     lv_draw_task_t * t = t_prev ? t_prev->next : layer->draw_task_head;
     while(t) {
-        /*Find a queued and independent task*/
+        /*Find a queued and independent task.
+         *Tasks which are not added to the grid yet are not finalized so skip them too.*/
         if(t->state == LV_DRAW_TASK_STATE_QUEUED &&
            (t->preferred_draw_unit_id == LV_DRAW_UNIT_NONE || t->preferred_draw_unit_id == draw_unit_id) &&
-           is_independent(layer, t)) {
+           t->_grid_mask != 0 && t->_dep_cnt == 0) {
             LV_PROFILER_END;
             return t;
         }
@@ -334,6 +419,24 @@ uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check)
     return cnt;
 }
 
+void _lv_draw_task_pool_trim(void)
+{
+    lv_draw_global_info_t * info = &_draw_info;
+    if(info->task_pool_used_cnt != 0) return;
+
+    LV_PROFILER_BEGIN;
+    /*All slots are free so the chunks can be freed in one go*/
+    task_pool_chunk_t * chunk = info->task_pool_chunks;
+    while(chunk) {
+        task_pool_chunk_t * chunk_next = chunk->next;
+        lv_free(chunk);
+        chunk = chunk_next;
+    }
+    info->task_pool_chunks = NULL;
+    info->task_pool_free = NULL;
+    LV_PROFILER_END;
+}
+
 lv_layer_t * lv_draw_layer_create(lv_layer_t * parent_layer, lv_color_format_t color_format, const lv_area_t * area)
 {
     lv_display_t * disp = _lv_refr_get_disp_refreshing();
@@ -397,28 +500,196 @@ void * lv_draw_layer_go_to_xy(lv_layer_t * layer, int32_t x, int32_t y)
  **********************/
 
 /**
- * Check if there are older draw task overlapping the area of `t_check`
- * @param layer      the draw ctx to search in
- * @param t_check       check this task if it overlaps with the older ones
- * @return              true: `t_check` is not overlapping with older tasks so it's independent
+ * Get a zeroed draw task slot from the pool. Allocate a new chunk of slots if there are no free ones.
+ * @return          pointer to the new draw task or NULL on error
  */
-static bool is_independent(lv_layer_t * layer, lv_draw_task_t * t_check)
+static lv_draw_task_t * task_pool_alloc(void)
+{
+    lv_draw_global_info_t * info = &_draw_info;
+    if(info->task_pool_free == NULL) {
+        task_pool_chunk_t * chunk = lv_malloc(sizeof(task_pool_chunk_t));
+        LV_ASSERT_MALLOC(chunk);
+        if(chunk == NULL) return NULL;
+
+        chunk->next = info->task_pool_chunks;
+        info->task_pool_chunks = chunk;
+
+        int32_t i;
+        for(i = TASK_POOL_CHUNK_SLOT_CNT - 1; i >= 0; i--) {
+            chunk->slots[i].task.next = info->task_pool_free;
+            info->task_pool_free = &chunk->slots[i].task;
+        }
+    }
+
+    lv_draw_task_t * t = info->task_pool_free;
+    info->task_pool_free = t->next;
+    info->task_pool_used_cnt++;
+
+    lv_memzero(t, sizeof(lv_draw_task_t));
+    return t;
+}
+
+/**
+ * Give back a finished draw task to the pool. Its draw descriptor is freed too.
+ * @param t         pointer to a draw task
+ */
+static void task_pool_free(lv_draw_task_t * t)
+{
+    lv_draw_global_info_t * info = &_draw_info;
+    if(t->draw_dsc != &((task_slot_t *)t)->dsc) lv_free(t->draw_dsc);
+
+    t->next = info->task_pool_free;
+    info->task_pool_free = t;
+    info->task_pool_used_cnt--;
+}
+
+/**
+ * Add a finalized draw task to the grid of its layer and count how many older tasks it needs to wait for.
+ * The younger tasks already in the grid (e.g. added in `LV_EVENT_DRAW_TASK_ADDED`) will wait for `t` too.
+ * @param layer     the layer of the task
+ * @param t         the task to add
+ */
+static void task_grid_add(lv_layer_t * layer, lv_draw_task_t * t)
 {
     LV_PROFILER_BEGIN;
-    lv_draw_task_t * t = layer->draw_task_head;
+    task_grid_t * grid = layer->_task_grid;
+    if(grid == NULL) {
+        grid = lv_malloc_zeroed(sizeof(task_grid_t));
+        LV_ASSERT_MALLOC(grid);
+        if(grid == NULL) {
+            LV_PROFILER_END;
+            return;
+        }
+        layer->_task_grid = grid;
+    }
+
+    /*The grid is empty so it can be fitted to the current buffer area*/
+    if(grid->task_cnt == 0) {
+        grid->area = layer->buf_area;
+        grid->cell_w = LV_MAX(1, (lv_area_get_width(&grid->area) + TASK_GRID_COLS - 1) / TASK_GRID_COLS);
+        grid->cell_h = LV_MAX(1, (lv_area_get_height(&grid->area) + TASK_GRID_ROWS - 1) / TASK_GRID_ROWS);
+    }
+
+    uint64_t mask = task_grid_get_mask(grid, &t->_real_area);
+    t->_grid_mask = mask;
+    t->_dep_cnt = 0;
+    grid->visit_id++;
+    t->_visit_id = grid->visit_id;
+
+    uint32_t i;
+    for(i = 0; i < TASK_GRID_COLS * TASK_GRID_ROWS; i++) {
+        if((mask & ((uint64_t)1 << i)) == 0) continue;
+
+        task_grid_cell_t * cell = &grid->cells[i];
+        uint32_t j;
+        for(j = 0; j < cell->cnt; j++) {
+            lv_draw_task_t * t_other = cell->tasks[j];
+            if(t_other->_visit_id == grid->visit_id) continue;
+            t_other->_visit_id = grid->visit_id;
 
-    /*If t_check is outside of the older tasks then it's independent*/
-    while(t && t != t_check) {
-        if(t->state != LV_DRAW_TASK_STATE_READY) {
             lv_area_t a;
-            if(_lv_area_intersect(&a, &t->_real_area, &t_check->_real_area)) {
-                LV_PROFILER_END;
-                return false;
+            if(!_lv_area_intersect(&a, &t_other->_real_area, &t->_real_area)) continue;
+
+            if(t_other->_id < t->_id) t->_dep_cnt++;
+            else t_other->_dep_cnt++;
+        }
+
+        if(cell->cnt == cell->capacity) {
+            uint32_t new_capacity = cell->capacity ? cell->capacity * 2 : 8;
+            lv_draw_task_t ** new_tasks = lv_realloc(cell->tasks, new_capacity * sizeof(lv_draw_task_t *));
+            LV_ASSERT_MALLOC(new_tasks);
+            if(new_tasks == NULL) continue;
+            cell->tasks = new_tasks;
+            cell->capacity = new_capacity;
+        }
+        cell->tasks[cell->cnt] = t;
+        cell->cnt++;
+    }
+
+    grid->task_cnt++;
+    LV_PROFILER_END;
+}
+
+/**
+ * Remove a finished draw task from the grid and release the younger tasks waiting for it.
+ * Free the grid when it becomes empty.
+ * @param layer     the layer of the task
+ * @param t         the finished task
+ */
+static void task_grid_remove(lv_layer_t * layer, lv_draw_task_t * t)
+{
+    task_grid_t * grid = layer->_task_grid;
+    if(grid == NULL || t->_grid_mask == 0) return;
+
+    LV_PROFILER_BEGIN;
+    grid->visit_id++;
+    t->_visit_id = grid->visit_id;
+
+    uint32_t i;
+    for(i = 0; i < TASK_GRID_COLS * TASK_GRID_ROWS; i++) {
+        if((t->_grid_mask & ((uint64_t)1 << i)) == 0) continue;
+
+        task_grid_cell_t * cell = &grid->cells[i];
+        uint32_t j = 0;
+        while(j < cell->cnt) {
+            lv_draw_task_t * t_other = cell->tasks[j];
+            if(t_other == t) {
+                /*The order doesn't matter so just move the last one here*/
+                cell->cnt--;
+                cell->tasks[j] = cell->tasks[cell->cnt];
+                continue;
             }
+
+            if(t_other->_visit_id != grid->visit_id) {
+                t_other->_visit_id = grid->visit_id;
+                lv_area_t a;
+                if(t_other->_id > t->_id && _lv_area_intersect(&a, &t_other->_real_area, &t->_real_area)) {
+                    t_other->_dep_cnt--;
+                }
+            }
+            j++;
         }
-        t = t->next;
+    }
+
+    t->_grid_mask = 0;
+    grid->task_cnt--;
+
+    if(grid->task_cnt == 0) {
+        for(i = 0; i < TASK_GRID_COLS * TASK_GRID_ROWS; i++) {
+            lv_free(grid->cells[i].tasks);
+        }
+        lv_free(grid);
+        layer->_task_grid = NULL;
     }
     LV_PROFILER_END;
+}
+
+/**
+ * Get the grid cells touched by an area
+ * @param grid      pointer to a task grid
+ * @param area      an area with absolute coordinates
+ * @return          bit mask of the cells. Areas out of the grid are added to the nearest cells
+ */
+static uint64_t task_grid_get_mask(const task_grid_t * grid, const lv_area_t * area)
+{
+    int32_t col1 = (area->x1 - grid->area.x1) / grid->cell_w;
+    int32_t col2 = (area->x2 - grid->area.x1) / grid->cell_w;
+    int32_t row1 = (area->y1 - grid->area.y1) / grid->cell_h;
+    int32_t row2 = (area->y2 - grid->area.y1) / grid->cell_h;
+
+    col1 = LV_CLAMP(0, col1, TASK_GRID_COLS - 1);
+    col2 = LV_CLAMP(0, col2, TASK_GRID_COLS - 1);
+    row1 = LV_CLAMP(0, row1, TASK_GRID_ROWS - 1);
+    row2 = LV_CLAMP(0, row2, TASK_GRID_ROWS - 1);
+
+    /*Bits of the columns in one row*/
+    uint64_t row_mask = (((uint64_t)1 << (col2 - col1 + 1)) - 1) << col1;
+
+    uint64_t mask = 0;
+    int32_t row;
+    for(row = row1; row <= row2; row++) {
+        mask |= row_mask << (row * TASK_GRID_COLS);
+    }
 
-    return true;
+    return mask;
 }
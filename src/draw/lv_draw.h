@@ -96,6 +96,26 @@ struct _lv_draw_task_t {
      */
     uint8_t preference_score;
 
+    /**
+     * Creation order of the task inside its layer. Used to decide which of two overlapping tasks is the older one.
+     */
+    uint32_t _id;
+
+    /**
+     * Number of older, not yet finished tasks whose `_real_area` overlaps with this task's `_real_area`.
+     * The task can be drawn only when it's 0.
+     */
+    uint32_t _dep_cnt;
+
+    /**
+     * Helper to visit each task only once while walking the cells of the layer's task grid
+     */
+    uint32_t _visit_id;
+
+    /**
+     * The cells of the layer's task grid touched by `_real_area`. 0 if the task is not added to the grid yet.
+     */
+    uint64_t _grid_mask;
 };
 
 typedef struct {
@@ -168,6 +188,15 @@ struct _lv_layer_t  {
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
+    /** The last draw task of the list to append new tasks quickly */
+    lv_draw_task_t * _draw_task_tail;
+
+    /** Spatial index of the unfinished draw tasks to find overlapping tasks quickly. Allocated on demand.*/
+    void * _task_grid;
+
+    /** Counter to set the `_id` of the new draw tasks*/
+    uint32_t _task_id_cnt;
+
     lv_layer_t * parent;
     lv_layer_t * next;
     bool all_tasks_added;
@@ -194,6 +223,9 @@ typedef struct {
 #endif
     lv_mutex_t circle_cache_mutex;
     bool task_running;
+    lv_draw_task_t * task_pool_free;        /**< Linked list of the unused draw task slots*/
+    void * task_pool_chunks;                /**< Linked list of the allocated chunks of draw task slots*/
+    uint32_t task_pool_used_cnt;            /**< Number of draw task slots in use*/
 } lv_draw_global_info_t;
 
 /**********************
@@ -226,6 +258,16 @@ void * lv_draw_create_unit(size_t size);
  */
 lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords);
 
+/**
+ * Allocate memory for the draw descriptor of a draw task.
+ * If the descriptor fits, it's stored in the same pooled slot as the draw task,
+ * else it's allocated on the heap. In both cases it's freed together with the draw task.
+ * @param t         pointer to a draw task created by `lv_draw_add_task`
+ * @param size      size of the draw descriptor, e.g. `sizeof(lv_draw_fill_dsc_t)`
+ * @return          pointer to the uninitialized memory for the draw descriptor
+ */
+void * lv_draw_task_alloc_dsc(lv_draw_task_t * t, size_t size);
+
 /**
  * Needs to be called when a draw task is created and configured.
  * It will send an event about the new draw task to the widget
@@ -279,6 +321,12 @@ lv_draw_task_t * lv_draw_get_next_available_task(lv_layer_t * layer, lv_draw_tas
  */
 uint32_t lv_draw_get_dependent_count(lv_draw_task_t * t_check);
 
+/**
+ * Used internally to free the draw task slots when the rendering is finished.
+ * It does nothing if any draw tasks are still in use.
+ */
+void _lv_draw_task_pool_trim(void);
+
 /**
  * Create a new layer on a parent layer
  * @param parent_layer      the parent layer to which the layer will be merged when it's rendered
@@ -227,6 +227,27 @@ void lv_draw_buf_copy(lv_draw_buf_t * dest, const lv_area_t * dest_area,
     uint32_t src_stride = src->header.stride;
     uint32_t line_bytes = (line_width * lv_color_format_get_bpp(dest->header.cf) + 7) >> 3;
 
+    /*The areas can overlap in the same buffer (e.g. when scrolling), so copy from the other end if needed*/
+    if(dest == src) {
+        if(dest_bufc > src_bufc) {
+            dest_bufc += (end_y - start_y) * dest_stride;
+            src_bufc += (end_y - start_y) * src_stride;
+            for(; start_y <= end_y; start_y++) {
+                lv_memmove(dest_bufc, src_bufc, line_bytes);
+                dest_bufc -= dest_stride;
+                src_bufc -= src_stride;
+            }
+        }
+        else {
+            for(; start_y <= end_y; start_y++) {
+                lv_memmove(dest_bufc, src_bufc, line_bytes);
+                dest_bufc += dest_stride;
+                src_bufc += src_stride;
+            }
+        }
+        return;
+    }
+
     for(; start_y <= end_y; start_y++) {
         lv_memcpy(dest_bufc, src_bufc, line_bytes);
         dest_bufc += dest_stride;
@@ -225,6 +225,7 @@ void lv_draw_buf_clear(lv_draw_buf_t * draw_buf, const lv_area_t * a);
  * @param src_area  the area to copy from the destination buffer, if NULL, use the whole buffer
  * @note `dest_area` and `src_area` should have the same width and height
  * @note  `dest` and `src` should have same color format. Color converting is not supported fow now.
+ * @note  if `dest` and `src` are the same buffer the areas can overlap
  */
 void lv_draw_buf_copy(lv_draw_buf_t * dest, const lv_area_t * dest_area,
                       const lv_draw_buf_t * src, const lv_area_t * src_area);
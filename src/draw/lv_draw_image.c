@@ -13,24 +13,47 @@
 #include "../core/lv_refr.h"
 #include "../stdlib/lv_mem.h"
 #include "../stdlib/lv_string.h"
+#include "../core/lv_global.h"
 
 /*********************
  *      DEFINES
  *********************/
+#define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_IMAGE_DECODER_TILE_SIZE
+typedef struct {
+    lv_area_t area;                 /*Relative to the image*/
+    lv_cache_entry_t * entry;       /*The cache entry if it's cached*/
+    lv_draw_buf_t * decoded;        /*The decoded tile if it wasn't cached*/
+} tile_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
+static lv_result_t img_decoder_open(lv_draw_unit_t * draw_unit, lv_image_decoder_dsc_t * decoder_dsc,
+                                    const void * src, const lv_area_t * area);
+
 static void img_decode_and_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
                                 lv_image_decoder_dsc_t * decoder_dsc, lv_area_t * relative_decoded_area,
                                 const lv_area_t * img_area, const lv_area_t * clipped_img_area,
                                 lv_draw_image_core_cb draw_core_cb);
 
+#if LV_IMAGE_DECODER_TILE_SIZE
+static lv_result_t img_draw_tiles(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
+                                  lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
+                                  lv_area_t * relative_decoded_area,
+                                  const lv_area_t * img_area, const lv_area_t * clipped_img_area,
+                                  lv_draw_image_core_cb draw_core_cb);
+static lv_result_t img_decode_tiles(lv_image_decoder_dsc_t * decoder_dsc, tile_t * tiles, uint32_t tile_cnt,
+                                    const lv_area_t * area_to_decode, lv_area_t * relative_decoded_area);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -64,7 +87,7 @@ void lv_draw_layer(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv
 {
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
 
-    t->draw_dsc = lv_malloc(sizeof(*dsc));
+    t->draw_dsc = lv_draw_task_alloc_dsc(t, sizeof(*dsc));
     lv_memcpy(t->draw_dsc, dsc, sizeof(*dsc));
     t->type = LV_DRAW_TASK_TYPE_LAYER;
     t->state = LV_DRAW_TASK_STATE_WAITING;
@@ -89,16 +112,18 @@ void lv_draw_image(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv
 
     LV_PROFILER_BEGIN;
 
-    lv_draw_image_dsc_t * new_image_dsc = lv_malloc(sizeof(*dsc));
-    lv_memcpy(new_image_dsc, dsc, sizeof(*dsc));
-    lv_result_t res = lv_image_decoder_get_info(new_image_dsc->src, &new_image_dsc->header);
+    lv_image_header_t header;
+    lv_result_t res = lv_image_decoder_get_info(dsc->src, &header);
     if(res != LV_RESULT_OK) {
         LV_LOG_WARN("Couldn't get info about the image");
-        lv_free(new_image_dsc);
+        LV_PROFILER_END;
         return;
     }
 
     lv_draw_task_t * t = lv_draw_add_task(layer, coords);
+    lv_draw_image_dsc_t * new_image_dsc = lv_draw_task_alloc_dsc(t, sizeof(*dsc));
+    lv_memcpy(new_image_dsc, dsc, sizeof(*dsc));
+    new_image_dsc->header = header;
     t->draw_dsc = new_image_dsc;
     t->type = LV_DRAW_TASK_TYPE_IMAGE;
 
@@ -156,11 +181,8 @@ void _lv_draw_image_normal_helper(lv_draw_unit_t * draw_unit, const lv_draw_imag
     }
 
     lv_image_decoder_dsc_t decoder_dsc;
-    lv_result_t res = lv_image_decoder_open(&decoder_dsc, draw_dsc->src, NULL);
-    if(res != LV_RESULT_OK) {
-        LV_LOG_ERROR("Failed to open image");
-        return;
-    }
+    lv_result_t res = img_decoder_open(draw_unit, &decoder_dsc, draw_dsc->src, &clipped_img_area);
+    if(res != LV_RESULT_OK) return;
 
     img_decode_and_draw(draw_unit, draw_dsc, &decoder_dsc, NULL, coords, &clipped_img_area, draw_core_cb);
 
@@ -175,12 +197,12 @@ void _lv_draw_image_tiled_helper(lv_draw_unit_t * draw_unit, const lv_draw_image
         return;
     }
 
+    lv_area_t clipped_area;
+    if(!_lv_area_intersect(&clipped_area, coords, draw_unit->clip_area)) return;
+
     lv_image_decoder_dsc_t decoder_dsc;
-    lv_result_t res = lv_image_decoder_open(&decoder_dsc, draw_dsc->src, NULL);
-    if(res != LV_RESULT_OK) {
-        LV_LOG_ERROR("Failed to open image");
-        return;
-    }
+    lv_result_t res = img_decoder_open(draw_unit, &decoder_dsc, draw_dsc->src, &clipped_area);
+    if(res != LV_RESULT_OK) return;
 
     int32_t img_w = draw_dsc->header.w;
     int32_t img_h = draw_dsc->header.h;
@@ -257,6 +279,32 @@ void _lv_image_buf_get_transformed_area(lv_area_t * res, int32_t w, int32_t h, i
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Open an image and if it's decoded in the background redraw `area` when it's ready
+ */
+static lv_result_t img_decoder_open(lv_draw_unit_t * draw_unit, lv_image_decoder_dsc_t * decoder_dsc,
+                                    const void * src, const lv_area_t * area)
+{
+    lv_image_decoder_args_t args = {
+        .stride_align = LV_DRAW_BUF_STRIDE_ALIGN != 1,
+        .async = true,
+    };
+
+    lv_result_t res = lv_image_decoder_open(decoder_dsc, src, &args);
+    if(res == LV_RESULT_OK) return res;
+
+    if(decoder_dsc->pending) {
+        /*The coordinates on a layer are not display coordinates so redraw the whole display*/
+        bool on_layer = draw_unit->target_layer && draw_unit->target_layer->parent;
+        _lv_image_decoder_add_pending_area(decoder_dsc, _lv_refr_get_disp_refreshing(), on_layer ? NULL : area);
+    }
+    else {
+        LV_LOG_ERROR("Failed to open image");
+    }
+
+    return res;
+}
+
 static void img_decode_and_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
                                 lv_image_decoder_dsc_t * decoder_dsc, lv_area_t * relative_decoded_area,
                                 const lv_area_t * img_area, const lv_area_t * clipped_img_area,
@@ -273,6 +321,14 @@ static void img_decode_and_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_
     }
     /*Draw in smaller pieces*/
     else {
+#if LV_IMAGE_DECODER_TILE_SIZE
+        /*Decode and cache only the visible tiles*/
+        if(img_draw_tiles(draw_unit, draw_dsc, decoder_dsc, &sup, relative_decoded_area, img_area, clipped_img_area,
+                          draw_core_cb) == LV_RESULT_OK) {
+            return;
+        }
+#endif
+
         lv_area_t relative_full_area_to_decode = *clipped_img_area;
         lv_area_move(&relative_full_area_to_decode, -img_area->x1, -img_area->y1);
         lv_area_t tmp;
@@ -299,3 +355,181 @@ static void img_decode_and_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_
         }
     }
 }
+
+#if LV_IMAGE_DECODER_TILE_SIZE
+
+/**
+ * Draw an image decoded by `get_area_cb` tile by tile. The tiles are taken from the image cache
+ * and only the missing ones are decoded and added to the cache.
+ * @return LV_RESULT_INVALID if the image can't be drawn in tiles
+ */
+static lv_result_t img_draw_tiles(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
+                                  lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
+                                  lv_area_t * relative_decoded_area,
+                                  const lv_area_t * img_area, const lv_area_t * clipped_img_area,
+                                  lv_draw_image_core_cb draw_core_cb)
+{
+    if(decoder_dsc->cache == NULL || decoder_dsc->args.no_cache) return LV_RESULT_INVALID;
+    if(decoder_dsc->src_type != LV_IMAGE_SRC_FILE && decoder_dsc->src_type != LV_IMAGE_SRC_VARIABLE) {
+        return LV_RESULT_INVALID;
+    }
+
+    /*The alpha map of the decoded lines can't be copied into tiles*/
+    if(decoder_dsc->header.cf == LV_COLOR_FORMAT_RGB565A8) return LV_RESULT_INVALID;
+
+    const int32_t tile_size = LV_IMAGE_DECODER_TILE_SIZE;
+    int32_t img_w = decoder_dsc->header.w;
+    int32_t img_h = decoder_dsc->header.h;
+
+    lv_area_t relative_clipped_area = *clipped_img_area;
+    lv_area_move(&relative_clipped_area, -img_area->x1, -img_area->y1);
+    lv_area_t img_rel_area = {0, 0, img_w - 1, img_h - 1};
+    if(!_lv_area_intersect(&relative_clipped_area, &relative_clipped_area, &img_rel_area)) return LV_RESULT_OK;
+
+    int32_t col_cnt = (img_w + tile_size - 1) / tile_size;
+    int32_t col_start = relative_clipped_area.x1 / tile_size;
+    int32_t col_end = relative_clipped_area.x2 / tile_size;
+    int32_t row_start = relative_clipped_area.y1 / tile_size;
+    int32_t row_end = relative_clipped_area.y2 / tile_size;
+    uint32_t tile_cnt = (col_end - col_start + 1) * (row_end - row_start + 1);
+
+    tile_t * tiles = lv_malloc_zeroed(tile_cnt * sizeof(tile_t));
+    LV_ASSERT_MALLOC(tiles);
+    if(tiles == NULL) return LV_RESULT_INVALID;
+
+    /*Take the cached tiles and collect the area of the missing ones*/
+    lv_area_t area_to_decode = {LV_COORD_MAX, LV_COORD_MAX, LV_COORD_MIN, LV_COORD_MIN};
+    uint32_t i = 0;
+    int32_t row;
+    int32_t col;
+    for(row = row_start; row <= row_end; row++) {
+        for(col = col_start; col <= col_end; col++) {
+            tile_t * tile = &tiles[i];
+            tile->area.x1 = col * tile_size;
+            tile->area.y1 = row * tile_size;
+            tile->area.x2 = LV_MIN(tile->area.x1 + tile_size, img_w) - 1;
+            tile->area.y2 = LV_MIN(tile->area.y1 + tile_size, img_h) - 1;
+
+            tile->entry = _lv_image_decoder_acquire_tile(decoder_dsc, row * col_cnt + col + 1);
+            if(tile->entry == NULL) {
+                area_to_decode.x1 = LV_MIN(area_to_decode.x1, tile->area.x1);
+                area_to_decode.y1 = LV_MIN(area_to_decode.y1, tile->area.y1);
+                area_to_decode.x2 = LV_MAX(area_to_decode.x2, tile->area.x2);
+                area_to_decode.y2 = LV_MAX(area_to_decode.y2, tile->area.y2);
+            }
+            i++;
+        }
+    }
+
+    lv_result_t res = LV_RESULT_OK;
+    if(area_to_decode.x1 <= area_to_decode.x2) {
+        res = img_decode_tiles(decoder_dsc, tiles, tile_cnt, &area_to_decode, relative_decoded_area);
+    }
+
+    /*E.g. out of memory. Release the tiles and let the caller draw it line by line*/
+    if(res != LV_RESULT_OK) {
+        for(i = 0; i < tile_cnt; i++) {
+            if(tiles[i].entry) lv_cache_release(decoder_dsc->cache, tiles[i].entry, NULL);
+        }
+        lv_free(tiles);
+        return LV_RESULT_INVALID;
+    }
+
+    const lv_draw_buf_t * decoded_ori = decoder_dsc->decoded;
+    i = 0;
+    for(row = row_start; row <= row_end; row++) {
+        for(col = col_start; col <= col_end; col++) {
+            tile_t * tile = &tiles[i];
+            i++;
+
+            /*Add the new tiles to the cache. If the cache is full just draw them*/
+            if(tile->entry == NULL) {
+                tile->entry = _lv_image_decoder_add_tile_to_cache(decoder_dsc, row * col_cnt + col + 1, tile->decoded);
+                if(tile->entry) tile->decoded = NULL;
+            }
+
+            if(tile->entry) {
+                lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(tile->entry);
+                decoder_dsc->decoded = cached_data->decoded;
+            }
+            else {
+                decoder_dsc->decoded = tile->decoded;
+            }
+
+            lv_area_t tile_area = tile->area;
+            lv_area_move(&tile_area, img_area->x1, img_area->y1);
+            lv_area_t clipped_tile_area;
+            if(_lv_area_intersect(&clipped_tile_area, clipped_img_area, &tile_area)) {
+                draw_core_cb(draw_unit, draw_dsc, decoder_dsc, sup, &tile_area, &clipped_tile_area);
+            }
+
+            if(tile->entry) lv_cache_release(decoder_dsc->cache, tile->entry, NULL);
+            if(tile->decoded) lv_draw_buf_destroy(tile->decoded);
+        }
+    }
+
+    decoder_dsc->decoded = decoded_ori;
+    lv_free(tiles);
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Decode an area with `get_area_cb` and copy the decoded pixels into the not cached tiles
+ * @return LV_RESULT_INVALID if not all the tiles could be decoded. They are freed in this case.
+ */
+static lv_result_t img_decode_tiles(lv_image_decoder_dsc_t * decoder_dsc, tile_t * tiles, uint32_t tile_cnt,
+                                    const lv_area_t * area_to_decode, lv_area_t * relative_decoded_area)
+{
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    bool out_of_mem = false;
+    while(!out_of_mem && lv_image_decoder_get_area(decoder_dsc, area_to_decode, &decoded_area) == LV_RESULT_OK) {
+        /*Decoders which decode in blocks (e.g. TJPGD) would continue after the area*/
+        if(decoded_area.y1 > area_to_decode->y2) break;
+
+        const lv_draw_buf_t * decoded = decoder_dsc->decoded;
+        uint32_t i;
+        for(i = 0; i < tile_cnt; i++) {
+            tile_t * tile = &tiles[i];
+            if(tile->entry) continue;
+
+            lv_area_t common_area;
+            if(!_lv_area_intersect(&common_area, &tile->area, &decoded_area)) continue;
+
+            if(tile->decoded == NULL) {
+                tile->decoded = lv_draw_buf_create_user(image_cache_draw_buf_handlers,
+                                                        lv_area_get_width(&tile->area), lv_area_get_height(&tile->area),
+                                                        decoded->header.cf, LV_STRIDE_AUTO);
+                if(tile->decoded == NULL) {
+                    out_of_mem = true;
+                    break;
+                }
+            }
+
+            lv_area_t dest_area = common_area;
+            lv_area_move(&dest_area, -tile->area.x1, -tile->area.y1);
+            lv_area_t src_area = common_area;
+            lv_area_move(&src_area, -decoded_area.x1, -decoded_area.y1);
+            lv_draw_buf_copy(tile->decoded, &dest_area, decoded, &src_area);
+        }
+    }
+
+    /*Let the caller know that the decoder was used*/
+    if(relative_decoded_area) *relative_decoded_area = decoded_area;
+
+    /*Drop the tiles if they weren't decoded completely*/
+    if(out_of_mem || decoded_area.y1 <= area_to_decode->y2) {
+        uint32_t i;
+        for(i = 0; i < tile_cnt; i++) {
+            if(tiles[i].decoded) {
+                lv_draw_buf_destroy(tiles[i].decoded);
+                tiles[i].decoded = NULL;
+            }
+        }
+        return LV_RESULT_INVALID;
+    }
+
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_IMAGE_DECODER_TILE_SIZE*/
@@ -12,6 +12,8 @@
 #include "../misc/lv_ll.h"
 #include "../stdlib/lv_string.h"
 #include "../core/lv_global.h"
+#include "../core/lv_refr.h"
+#include "../display/lv_display.h"
 
 /*********************
  *      DEFINES
@@ -20,11 +22,31 @@
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
 #define img_header_cache_p (LV_GLOBAL_DEFAULT()->img_header_cache)
 #define image_cache_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->image_cache_draw_buf_handlers)
+#define async_state (&(LV_GLOBAL_DEFAULT()->img_decoder_async))
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+typedef enum {
+    ASYNC_JOB_QUEUED,       /*Waiting for a thread*/
+    ASYNC_JOB_DECODING,     /*A thread is decoding it*/
+    ASYNC_JOB_READY,        /*Decoded, the areas need to be invalidated*/
+    ASYNC_JOB_DONE,         /*Couldn't be cached, decode it synchronously next time*/
+} async_job_state_t;
+
+typedef struct {
+    const void * src;
+    lv_image_src_t src_type;
+    async_job_state_t state;
+    bool cached;            /*The decoded image was added to the cache*/
+    bool inv_all;           /*Invalidate all the displays*/
+    lv_display_t * disp;    /*The display to invalidate or NULL if there is nothing to invalidate*/
+    lv_area_t inv_area;
+} async_job_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -41,6 +63,15 @@ static lv_image_decoder_t * image_decoder_get_info(const void * src, lv_image_he
 
 static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc);
 
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    static bool async_is_pending(lv_image_decoder_dsc_t * dsc);
+    static async_job_t * async_find_job(const void * src, lv_image_src_t src_type);
+    static void async_thread_cb(void * user_data);
+    static void async_invalidate(lv_display_t * disp);
+    static void async_timer_cb(lv_timer_t * timer);
+    static void async_deinit(void);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -60,6 +91,10 @@ void _lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_cou
 {
     _lv_ll_init(img_decoder_ll_p, sizeof(lv_image_decoder_t));
 
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    _lv_ll_init(&async_state->job_ll, sizeof(async_job_t));
+#endif
+
     /*Initialize the cache*/
     lv_image_cache_init(image_cache_size);
     lv_image_header_cache_init(image_header_count);
@@ -70,6 +105,10 @@ void _lv_image_decoder_init(uint32_t image_cache_size, uint32_t image_header_cou
  */
 void _lv_image_decoder_deinit(void)
 {
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    async_deinit();
+#endif
+
     lv_cache_destroy(img_cache_p, NULL);
     lv_cache_destroy(img_header_cache_p, NULL);
 
@@ -100,6 +139,18 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
             * Check the cache first
             * If the image is found in the cache, just return it.*/
             if(try_cache(dsc) == LV_RESULT_OK) return LV_RESULT_OK;
+
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+            if(args && args->async && async_state->enabled) {
+                if(async_is_pending(dsc)) {
+                    dsc->pending = true;
+                    return LV_RESULT_INVALID;
+                }
+
+                /*It might have been decoded since the cache was checked*/
+                if(try_cache(dsc) == LV_RESULT_OK) return LV_RESULT_OK;
+            }
+#endif
         }
     }
 
@@ -121,8 +172,14 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
      * If decoder open failed, free the source and return error.
      * If decoder open succeed, add the image to cache if enabled.
      * */
+    uint32_t t_start = lv_tick_get();
     lv_result_t res = dsc->decoder->open_cb(dsc->decoder, dsc);
 
+    /*Let the cost-aware cache keep the images which are slow to decode*/
+    if(res == LV_RESULT_OK && dsc->cache_entry) {
+        lv_cache_entry_set_cost(dsc->cache_entry, LV_MAX(lv_tick_elaps(t_start), 1));
+    }
+
     /* Flush the D-Cache if enabled and the image was successfully opened */
     if(dsc->args.flush_cache && res == LV_RESULT_OK) {
         lv_draw_buf_flush_cache(dsc->decoded, NULL);
@@ -138,6 +195,88 @@ lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src
     return res;
 }
 
+void lv_image_decoder_enable_async(bool en)
+{
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    lv_image_decoder_async_state_t * state = async_state;
+    if(en && !lv_image_cache_is_enabled()) {
+        LV_LOG_WARN("The image cache is disabled, can't decode asynchronously");
+        return;
+    }
+
+    if(en && !state->started) {
+        lv_mutex_init(&state->lock);
+        uint32_t i;
+        for(i = 0; i < LV_IMAGE_DECODER_ASYNC_THREAD_CNT; i++) {
+            lv_thread_sync_init(&state->syncs[i]);
+            lv_thread_init(&state->threads[i], LV_THREAD_PRIO_LOW, async_thread_cb, LV_DRAW_THREAD_STACK_SIZE,
+                           &state->syncs[i]);
+        }
+        state->timer = lv_timer_create(async_timer_cb, LV_DEF_REFR_PERIOD, NULL);
+        state->started = 1;
+    }
+
+    /*Keep the threads and the timer to finish the already started jobs*/
+    state->enabled = en;
+#else
+    LV_UNUSED(en);
+    LV_LOG_WARN("LV_IMAGE_DECODER_ASYNC_THREAD_CNT is 0");
+#endif
+}
+
+void lv_image_decoder_prefetch(const void * const srcs[], uint32_t cnt)
+{
+    if(!lv_image_cache_is_enabled()) {
+        LV_LOG_WARN("The image cache is disabled, nothing to prefetch");
+        return;
+    }
+
+    lv_image_decoder_args_t args = {
+        .stride_align = LV_DRAW_BUF_STRIDE_ALIGN != 1,
+        .async = true,
+    };
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_image_decoder_dsc_t dsc;
+        if(lv_image_decoder_open(&dsc, srcs[i], &args) == LV_RESULT_OK) {
+            lv_image_decoder_close(&dsc);
+        }
+        else if(!dsc.pending) {
+            LV_LOG_WARN("Failed to prefetch image %" LV_PRIu32, i);
+        }
+    }
+}
+
+void _lv_image_decoder_add_pending_area(const lv_image_decoder_dsc_t * dsc, lv_display_t * disp,
+                                        const lv_area_t * area)
+{
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    lv_image_decoder_async_state_t * state = async_state;
+    if(!dsc->pending) return;
+
+    lv_mutex_lock(&state->lock);
+    async_job_t * job = async_find_job(dsc->src, dsc->src_type);
+    if(job) {
+        if(area == NULL || disp == NULL || (job->disp && job->disp != disp)) {
+            job->inv_all = true;
+        }
+        else if(job->disp == NULL) {
+            job->disp = disp;
+            job->inv_area = *area;
+        }
+        else {
+            _lv_area_join(&job->inv_area, &job->inv_area, area);
+        }
+    }
+    lv_mutex_unlock(&state->lock);
+#else
+    LV_UNUSED(dsc);
+    LV_UNUSED(disp);
+    LV_UNUSED(area);
+#endif
+}
+
 lv_result_t lv_image_decoder_get_area(lv_image_decoder_dsc_t * dsc, const lv_area_t * full_area,
                                       lv_area_t * decoded_area)
 {
@@ -213,21 +352,56 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
                                                  lv_image_cache_data_t * search_key,
                                                  const lv_draw_buf_t * decoded, void * user_data)
 {
+    /*Set the decoder data before adding the entry as other draw units can
+     *acquire it from the cache as soon as it's added*/
+    search_key->decoded = decoded;
+    if(search_key->src_type == LV_IMAGE_SRC_FILE) {
+        search_key->src = lv_strdup(search_key->src);
+    }
+    search_key->user_data = user_data; /*Need to free data on cache invalidate instead of decoder_close*/
+    search_key->decoder = decoder;
+    search_key->tile_id = 0;
+
     lv_cache_entry_t * cache_entry = lv_cache_add(img_cache_p, search_key, NULL);
     if(cache_entry == NULL) {
+        if(search_key->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)search_key->src);
         return NULL;
     }
 
-    lv_image_cache_data_t * cached_data;
-    cached_data = lv_cache_entry_get_data(cache_entry);
+    return cache_entry;
+}
+
+lv_cache_entry_t * _lv_image_decoder_acquire_tile(lv_image_decoder_dsc_t * dsc, uint32_t tile_id)
+{
+    lv_image_cache_data_t search_key;
+    search_key.src_type = dsc->src_type;
+    search_key.src = dsc->src;
+    search_key.tile_id = tile_id;
+
+    return lv_cache_acquire(dsc->cache, &search_key, NULL);
+}
 
-    /*Set the cache entry to decoder data*/
-    cached_data->decoded = decoded;
-    if(cached_data->src_type == LV_IMAGE_SRC_FILE) {
-        cached_data->src = lv_strdup(cached_data->src);
+lv_cache_entry_t * _lv_image_decoder_add_tile_to_cache(lv_image_decoder_dsc_t * dsc, uint32_t tile_id,
+                                                       const lv_draw_buf_t * decoded)
+{
+    /*An other draw unit might have added it in the meantime*/
+    lv_cache_entry_t * cache_entry = _lv_image_decoder_acquire_tile(dsc, tile_id);
+    if(cache_entry) {
+        lv_draw_buf_destroy((lv_draw_buf_t *)decoded);
+        return cache_entry;
     }
-    cached_data->user_data = user_data; /*Need to free data on cache invalidate instead of decoder_close*/
-    cached_data->decoder = decoder;
+
+    lv_image_cache_data_t search_key;
+    search_key.src_type = dsc->src_type;
+    search_key.src = dsc->src_type == LV_IMAGE_SRC_FILE ? lv_strdup(dsc->src) : dsc->src;
+    search_key.tile_id = tile_id;
+    search_key.decoded = decoded;
+    search_key.decoder = dsc->decoder;
+    search_key.user_data = NULL;
+    search_key.slot.size = decoded->data_size;
+
+    cache_entry = lv_cache_add(dsc->cache, &search_key, NULL);
+    if(cache_entry == NULL && dsc->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)search_key.src);
 
     return cache_entry;
 }
@@ -382,6 +556,7 @@ static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc)
     lv_image_cache_data_t search_key;
     search_key.src_type = dsc->src_type;
     search_key.src = dsc->src;
+    search_key.tile_id = 0;
 
     lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
 
@@ -395,3 +570,186 @@ static lv_result_t try_cache(lv_image_decoder_dsc_t * dsc)
 
     return LV_RESULT_INVALID;
 }
+
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+
+/**
+ * Queue a job for an image if it's worth decoding it in the background.
+ * Decoding C arrays is fast except for the ones storing e.g. PNG data.
+ * @param dsc       the decoder descriptor with `src` and `src_type` set
+ * @return          true: the image is queued or being decoded; false: decode it synchronously
+ */
+static bool async_is_pending(lv_image_decoder_dsc_t * dsc)
+{
+    if(dsc->src_type == LV_IMAGE_SRC_VARIABLE) {
+        const lv_image_dsc_t * img_dsc = dsc->src;
+        if(img_dsc->header.cf != LV_COLOR_FORMAT_RAW && img_dsc->header.cf != LV_COLOR_FORMAT_RAW_ALPHA) return false;
+    }
+    else if(dsc->src_type != LV_IMAGE_SRC_FILE) {
+        return false;
+    }
+
+    lv_image_decoder_async_state_t * state = async_state;
+    bool pending;
+
+    lv_mutex_lock(&state->lock);
+    async_job_t * job = async_find_job(dsc->src, dsc->src_type);
+    if(job == NULL) {
+        job = _lv_ll_ins_tail(&state->job_ll);
+        LV_ASSERT_MALLOC(job);
+        if(job) {
+            lv_memzero(job, sizeof(async_job_t));
+            job->src_type = dsc->src_type;
+            job->src = dsc->src_type == LV_IMAGE_SRC_FILE ? lv_strdup(dsc->src) : dsc->src;
+            job->state = ASYNC_JOB_QUEUED;
+        }
+        pending = job != NULL;
+    }
+    else {
+        pending = job->state == ASYNC_JOB_QUEUED || job->state == ASYNC_JOB_DECODING;
+    }
+    lv_mutex_unlock(&state->lock);
+
+    if(pending) {
+        /*Wake up all the threads, the idle ones will take the job*/
+        uint32_t i;
+        for(i = 0; i < LV_IMAGE_DECODER_ASYNC_THREAD_CNT; i++) {
+            lv_thread_sync_signal(&state->syncs[i]);
+        }
+    }
+
+    return pending;
+}
+
+/**
+ * Find the job of an image source. Should be called with the lock held.
+ */
+static async_job_t * async_find_job(const void * src, lv_image_src_t src_type)
+{
+    async_job_t * job;
+    _LV_LL_READ(&async_state->job_ll, job) {
+        if(job->src_type != src_type) continue;
+        if(src_type == LV_IMAGE_SRC_FILE) {
+            if(lv_strcmp(job->src, src) == 0) return job;
+        }
+        else if(job->src == src) {
+            return job;
+        }
+    }
+
+    return NULL;
+}
+
+static void async_thread_cb(void * user_data)
+{
+    lv_image_decoder_async_state_t * state = async_state;
+    lv_thread_sync_t * sync = user_data;
+
+    while(1) {
+        lv_thread_sync_wait(sync);
+        if(state->exit) break;
+
+        while(1) {
+            lv_mutex_lock(&state->lock);
+            async_job_t * job;
+            _LV_LL_READ(&state->job_ll, job) {
+                if(job->state == ASYNC_JOB_QUEUED) break;
+            }
+            if(job) job->state = ASYNC_JOB_DECODING;
+            lv_mutex_unlock(&state->lock);
+
+            if(job == NULL) break;
+
+            /*The job can't be removed while it's being decoded*/
+            lv_image_decoder_dsc_t dsc;
+            bool cached = false;
+            if(lv_image_decoder_open(&dsc, job->src, NULL) == LV_RESULT_OK) {
+                cached = dsc.cache_entry != NULL;
+                lv_image_decoder_close(&dsc);
+            }
+
+            lv_mutex_lock(&state->lock);
+            job->cached = cached;
+            job->state = ASYNC_JOB_READY;
+            lv_mutex_unlock(&state->lock);
+        }
+    }
+}
+
+static void async_invalidate(lv_display_t * disp)
+{
+    lv_area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = lv_display_get_horizontal_resolution(disp) - 1;
+    scr_area.y2 = lv_display_get_vertical_resolution(disp) - 1;
+    _lv_inv_area(disp, &scr_area);
+}
+
+static void async_timer_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    lv_image_decoder_async_state_t * state = async_state;
+
+    while(1) {
+        lv_mutex_lock(&state->lock);
+        async_job_t * job;
+        _LV_LL_READ(&state->job_ll, job) {
+            if(job->state == ASYNC_JOB_READY) break;
+        }
+
+        if(job == NULL) {
+            lv_mutex_unlock(&state->lock);
+            break;
+        }
+
+        bool inv_all = job->inv_all;
+        lv_display_t * disp = job->disp;
+        lv_area_t inv_area = job->inv_area;
+
+        /*If it's cached the next draw will find it there, else keep the job to decode it synchronously*/
+        if(job->cached) {
+            if(job->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)job->src);
+            _lv_ll_remove(&state->job_ll, job);
+            lv_free(job);
+        }
+        else {
+            job->state = ASYNC_JOB_DONE;
+        }
+        lv_mutex_unlock(&state->lock);
+
+        /*Invalidate without holding the lock as it might call event callbacks*/
+        lv_display_t * d = lv_display_get_next(NULL);
+        while(d) {
+            if(inv_all) async_invalidate(d);
+            else if(d == disp) _lv_inv_area(d, &inv_area);
+            d = lv_display_get_next(d);
+        }
+    }
+}
+
+static void async_deinit(void)
+{
+    lv_image_decoder_async_state_t * state = async_state;
+
+    if(state->started) {
+        state->exit = 1;
+        uint32_t i;
+        for(i = 0; i < LV_IMAGE_DECODER_ASYNC_THREAD_CNT; i++) {
+            lv_thread_sync_signal(&state->syncs[i]);
+            lv_thread_delete(&state->threads[i]);
+            lv_thread_sync_delete(&state->syncs[i]);
+        }
+        lv_mutex_delete(&state->lock);
+        lv_timer_delete(state->timer);
+    }
+
+    async_job_t * job;
+    _LV_LL_READ(&state->job_ll, job) {
+        if(job->src_type == LV_IMAGE_SRC_FILE) lv_free((void *)job->src);
+    }
+    _lv_ll_clear(&state->job_ll);
+    lv_memzero(state, sizeof(lv_image_decoder_async_state_t));
+}
+
+#endif /*LV_IMAGE_DECODER_ASYNC_THREAD_CNT*/
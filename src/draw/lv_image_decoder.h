@@ -20,6 +20,8 @@ extern "C" {
 #include "../misc/lv_types.h"
 #include "../misc/lv_area.h"
 #include "../misc/cache/lv_cache.h"
+#include "../misc/lv_ll.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -63,6 +65,8 @@ typedef struct _lv_image_decoder_args_t {
     bool no_cache;          /*When set, decoded image won't be put to cache, and decoder open will also ignore cache.*/
     bool use_indexed;       /*Decoded indexed image as is. Convert to ARGB8888 if false.*/
     bool flush_cache;       /*Whether to flush the data cache after decoding*/
+    bool async;             /*Decode the not cached image in the background and return with `dsc->pending` set.
+                             *Has effect only if `LV_IMAGE_DECODER_ASYNC_THREAD_CNT > 0` and it's enabled.*/
 } lv_image_decoder_args_t;
 
 /**
@@ -119,6 +123,7 @@ typedef struct _lv_image_decoder_cache_data_t {
 
     const void * src;
     lv_image_src_t src_type;
+    uint32_t tile_id;       /*0: the whole image, else the index of the tile + 1 (see `LV_IMAGE_DECODER_TILE_SIZE`)*/
 
     const lv_draw_buf_t * decoded;
     const lv_image_decoder_t * decoder;
@@ -170,10 +175,27 @@ struct _lv_image_decoder_dsc_t {
     /**Point to cache entry information*/
     lv_cache_entry_t * cache_entry;
 
+    /**Set if `args.async` was set and the image is being decoded in the background.
+     * `lv_image_decoder_open` returns with `LV_RESULT_INVALID` in this case.*/
+    bool pending;
+
     /**Store any custom data here is required*/
     void * user_data;
 };
 
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+typedef struct {
+    lv_mutex_t lock;                /**< Protects `job_ll` and the jobs*/
+    lv_thread_t threads[LV_IMAGE_DECODER_ASYNC_THREAD_CNT];
+    lv_thread_sync_t syncs[LV_IMAGE_DECODER_ASYNC_THREAD_CNT];
+    lv_ll_t job_ll;                 /**< Images being decoded or already decoded but not invalidated yet*/
+    lv_timer_t * timer;             /**< Invalidates the areas of the decoded images*/
+    uint32_t started   : 1;
+    uint32_t enabled   : 1;
+    uint32_t exit      : 1;
+} lv_image_decoder_async_state_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -217,6 +239,33 @@ lv_result_t lv_image_decoder_get_info(const void * src, lv_image_header_t * head
  */
 lv_result_t lv_image_decoder_open(lv_image_decoder_dsc_t * dsc, const void * src, const lv_image_decoder_args_t * args);
 
+/**
+ * Enable or disable decoding the not cached images in the background.
+ * If enabled, the images drawn by LVGL are not drawn until they are decoded
+ * and their areas are invalidated when they are ready.
+ * @param en        true: enable; false: disable
+ * @note            requires `LV_IMAGE_DECODER_ASYNC_THREAD_CNT > 0` and the image cache
+ */
+void lv_image_decoder_enable_async(bool en);
+
+/**
+ * Decode images and put them into the image cache before they are drawn.
+ * With asynchronous decoding enabled the images are decoded in the background,
+ * else they are decoded right away.
+ * @param srcs      array of image sources (file names or pointers to `lv_image_dsc_t` variables)
+ * @param cnt       number of sources in `srcs`
+ */
+void lv_image_decoder_prefetch(const void * const srcs[], uint32_t cnt);
+
+/**
+ * Invalidate an area when the image of a pending decoding session is decoded.
+ * @param dsc       pointer to a decoder descriptor with `pending` set
+ * @param disp      the display to invalidate
+ * @param area      the area to invalidate or NULL to invalidate the whole display
+ */
+void _lv_image_decoder_add_pending_area(const lv_image_decoder_dsc_t * dsc, lv_display_t * disp,
+                                        const lv_area_t * area);
+
 /***
  * Decode `full_area` pixels incrementally by calling in a loop. Set `decoded_area` to `LV_COORD_MIN` on first call.
  * @param dsc           image decoder descriptor
@@ -285,6 +334,24 @@ lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
                                                  lv_image_cache_data_t * search_key,
                                                  const lv_draw_buf_t * decoded, void * user_data);
 
+/**
+ * Get a tile of an image from the image cache.
+ * @param dsc       pointer to a decoder descriptor of an opened image
+ * @param tile_id   index of the tile + 1
+ * @return          the cache entry of the tile or NULL if it's not cached. Release it with `lv_cache_release`.
+ */
+lv_cache_entry_t * _lv_image_decoder_acquire_tile(lv_image_decoder_dsc_t * dsc, uint32_t tile_id);
+
+/**
+ * Add a decoded tile of an image to the image cache.
+ * @param dsc       pointer to a decoder descriptor of an opened image
+ * @param tile_id   index of the tile + 1
+ * @param decoded   the decoded tile. The cache will free it.
+ * @return          the cache entry of the tile or NULL if it couldn't be added. Release it with `lv_cache_release`.
+ */
+lv_cache_entry_t * _lv_image_decoder_add_tile_to_cache(lv_image_decoder_dsc_t * dsc, uint32_t tile_id,
+                                                       const lv_draw_buf_t * decoded);
+
 /**
  * Check the decoded image, make any modification if decoder `args` requires.
  * @note A new draw buf will be allocated if provided `decoded` is not modifiable or stride mismatch etc.
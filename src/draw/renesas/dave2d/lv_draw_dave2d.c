@@ -346,6 +346,8 @@ static int32_t lv_draw_dave2d_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t *
     t = lv_draw_get_next_available_task(layer, NULL, DRAW_UNIT_ID_DAVE2D);
     while(t && t->preferred_draw_unit_id != DRAW_UNIT_ID_DAVE2D) {
         t->state = LV_DRAW_TASK_STATE_READY;
+        /*Dispatch again to release the tasks waiting for the dropped one*/
+        lv_draw_dispatch_request();
         t = lv_draw_get_next_available_task(layer, NULL, DRAW_UNIT_ID_DAVE2D);
     }
 
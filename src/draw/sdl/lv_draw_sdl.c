@@ -132,7 +132,7 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
 
     lv_display_t * disp = _lv_refr_get_disp_refreshing();
     SDL_Texture * texture = layer_get_texture(layer);
-    if(layer != disp->layer_head && texture == NULL) {
+    if(layer != disp->layer_head && layer != disp->layer_pipe && texture == NULL) {
         void * buf = lv_draw_layer_alloc_buf(layer);
         if(buf == NULL) return -1;
 
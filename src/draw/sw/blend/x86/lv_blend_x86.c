@@ -0,0 +1,634 @@
+/**
+ * @file lv_blend_x86.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_blend_x86.h"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && defined(__SSE2__)
+
+#include "../../../../misc/lv_color.h"
+#include "../../../../stdlib/lv_string.h"
+#include <emmintrin.h>
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Number of pixels mixed in one step. The last, partial step of a row is done on a copy*/
+#define STEP_PX     8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t color;     /*The fill color in the format of the destination*/
+    lv_opa_t opa;
+    uint32_t dest_px_size;
+    uint32_t src_px_size;
+} step_param_t;
+
+typedef void (*step_cb_t)(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const step_param_t * p);
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static inline void blend_rows(uint8_t * dest, int32_t dest_stride, const uint8_t * src, int32_t src_stride,
+                              const lv_opa_t * mask, int32_t mask_stride, int32_t w, int32_t h,
+                              step_cb_t step, const step_param_t * p);
+
+static void step_color_to_rgb565(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const step_param_t * p);
+static void step_rgb565_to_rgb565(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const step_param_t * p);
+static void step_rgb888_to_rgb565(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const step_param_t * p);
+static void step_argb8888_to_rgb565(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                    const step_param_t * p);
+static void step_color_to_rgb888(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const step_param_t * p);
+static void step_rgb888_to_rgb888(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const step_param_t * p);
+static void step_argb8888_to_rgb888(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                    const step_param_t * p);
+static void step_color_to_argb8888(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                   const step_param_t * p);
+static void step_argb8888_to_argb8888(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                      const step_param_t * p);
+
+static inline __m128i get_mix(const lv_opa_t * mask, lv_opa_t opa);
+static inline __m128i get_mix_alpha(__m128i alpha, const lv_opa_t * mask, lv_opa_t opa);
+static inline __m128i get_alpha(__m128i px_lo, __m128i px_hi);
+static inline __m128i rgb565_mix(__m128i fg, __m128i bg, __m128i mix);
+static inline __m128i rgb888_to_rgb565_mix(__m128i fg_lo, __m128i fg_hi, __m128i bg, __m128i mix);
+static inline void rgb888_mix(uint8_t * dest, uint32_t dest_px_size, __m128i fg_lo, __m128i fg_hi, __m128i mix);
+static inline __m128i rgb888_mix_4(__m128i fg, __m128i bg, __m128i mix);
+static inline void argb8888_mix(uint8_t * dest, __m128i fg_lo, __m128i fg_hi, __m128i mix);
+static inline __m128i argb8888_mix_4(__m128i fg, __m128i bg, __m128i alpha);
+static lv_color32_t argb8888_mix_px(lv_color32_t fg, lv_color32_t bg);
+
+static inline __m128i load_rgb888_4(const uint8_t * src, uint32_t px_size);
+static inline void store_rgb888_4(uint8_t * dest, __m128i px, uint32_t px_size);
+static inline __m128i select_128(__m128i a, __m128i b, __m128i sel);
+static void fill_16(uint16_t * dest, uint16_t color, int32_t w);
+static void fill_32(uint32_t * dest, uint32_t color, int32_t w);
+static void copy_row(uint8_t * dest, const uint8_t * src, int32_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t _lv_color_blend_to_rgb565_x86(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    uint8_t * dest_buf = dsc->dest_buf;
+    int32_t y;
+
+    /*The C implementation mixes the same two colors only once so it's faster with opacity only*/
+    if(dsc->mask_buf == NULL && dsc->opa < LV_OPA_MAX) return LV_RESULT_INVALID;
+
+    if(dsc->mask_buf == NULL) {
+        uint16_t color16 = lv_color_to_u16(dsc->color);
+        for(y = 0; y < dsc->dest_h; y++) {
+            fill_16((uint16_t *)dest_buf, color16, dsc->dest_w);
+            dest_buf += dsc->dest_stride;
+        }
+        return LV_RESULT_OK;
+    }
+
+    step_param_t p = {.color = lv_color_to_u16(dsc->color), .opa = dsc->opa, .dest_px_size = 2};
+    blend_rows(dest_buf, dsc->dest_stride, NULL, 0, dsc->mask_buf, dsc->mask_stride, dsc->dest_w, dsc->dest_h,
+               step_color_to_rgb565, &p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_rgb565_blend_normal_to_rgb565_x86(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    uint8_t * dest_buf = dsc->dest_buf;
+    const uint8_t * src_buf = dsc->src_buf;
+    int32_t y;
+
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) {
+        for(y = 0; y < dsc->dest_h; y++) {
+            copy_row(dest_buf, src_buf, dsc->dest_w * 2);
+            dest_buf += dsc->dest_stride;
+            src_buf += dsc->src_stride;
+        }
+        return LV_RESULT_OK;
+    }
+
+    step_param_t p = {.opa = dsc->opa, .dest_px_size = 2, .src_px_size = 2};
+    blend_rows(dest_buf, dsc->dest_stride, src_buf, dsc->src_stride, dsc->mask_buf, dsc->mask_stride,
+               dsc->dest_w, dsc->dest_h, step_rgb565_to_rgb565, &p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_rgb888_blend_normal_to_rgb565_x86(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t src_px_size)
+{
+    /*SSE2 has no byte shuffle so plain conversion of 3 byte pixels is faster in C*/
+    if(src_px_size == 3 && dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) return LV_RESULT_INVALID;
+
+    step_param_t p = {.opa = dsc->opa, .dest_px_size = 2, .src_px_size = src_px_size};
+    blend_rows(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, dsc->mask_buf, dsc->mask_stride,
+               dsc->dest_w, dsc->dest_h, step_rgb888_to_rgb565, &p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_argb8888_blend_normal_to_rgb565_x86(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    step_param_t p = {.opa = dsc->opa, .dest_px_size = 2, .src_px_size = 4};
+    blend_rows(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, dsc->mask_buf, dsc->mask_stride,
+               dsc->dest_w, dsc->dest_h, step_argb8888_to_rgb565, &p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_color_blend_to_rgb888_x86(_lv_draw_sw_blend_fill_dsc_t * dsc, uint32_t dst_px_size)
+{
+    uint8_t * dest_buf = dsc->dest_buf;
+    int32_t y;
+
+    /*Without a mask 3 byte pixels are written faster by the C implementation*/
+    if(dsc->mask_buf == NULL && dst_px_size == 3) return LV_RESULT_INVALID;
+
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) {
+        uint32_t color32 = lv_color_to_u32(dsc->color);
+        for(y = 0; y < dsc->dest_h; y++) {
+            fill_32((uint32_t *)dest_buf, color32, dsc->dest_w);
+            dest_buf += dsc->dest_stride;
+        }
+        return LV_RESULT_OK;
+    }
+
+    step_param_t p = {.color = lv_color_to_u32(dsc->color), .opa = dsc->opa, .dest_px_size = dst_px_size};
+    blend_rows(dest_buf, dsc->dest_stride, NULL, 0, dsc->mask_buf, dsc->mask_stride, dsc->dest_w, dsc->dest_h,
+               step_color_to_rgb888, &p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_rgb888_blend_normal_to_rgb888_x86(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size,
+                                                  uint32_t src_px_size)
+{
+    uint8_t * dest_buf = dsc->dest_buf;
+    const uint8_t * src_buf = dsc->src_buf;
+    int32_t y;
+
+    /*Without a mask 3 byte pixels and the RGB888 <-> XRGB8888 conversion are faster in C*/
+    if(dsc->mask_buf == NULL && (dst_px_size == 3 || dst_px_size != src_px_size)) return LV_RESULT_INVALID;
+
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) {
+        for(y = 0; y < dsc->dest_h; y++) {
+            copy_row(dest_buf, src_buf, dsc->dest_w * dst_px_size);
+            dest_buf += dsc->dest_stride;
+            src_buf += dsc->src_stride;
+        }
+        return LV_RESULT_OK;
+    }
+
+    step_param_t p = {.opa = dsc->opa, .dest_px_size = dst_px_size, .src_px_size = src_px_size};
+    blend_rows(dest_buf, dsc->dest_stride, src_buf, dsc->src_stride, dsc->mask_buf, dsc->mask_stride,
+               dsc->dest_w, dsc->dest_h, step_rgb888_to_rgb888, &p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_argb8888_blend_normal_to_rgb888_x86(_lv_draw_sw_blend_image_dsc_t * dsc, uint32_t dst_px_size)
+{
+    step_param_t p = {.opa = dsc->opa, .dest_px_size = dst_px_size, .src_px_size = 4};
+    blend_rows(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, dsc->mask_buf, dsc->mask_stride,
+               dsc->dest_w, dsc->dest_h, step_argb8888_to_rgb888, &p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_color_blend_to_argb8888_x86(_lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    uint8_t * dest_buf = dsc->dest_buf;
+    uint32_t color32 = lv_color_to_u32(dsc->color);
+    int32_t y;
+
+    if(dsc->mask_buf == NULL && dsc->opa >= LV_OPA_MAX) {
+        for(y = 0; y < dsc->dest_h; y++) {
+            fill_32((uint32_t *)dest_buf, color32, dsc->dest_w);
+            dest_buf += dsc->dest_stride;
+        }
+        return LV_RESULT_OK;
+    }
+
+    step_param_t p = {.color = color32, .opa = dsc->opa, .dest_px_size = 4};
+    blend_rows(dest_buf, dsc->dest_stride, NULL, 0, dsc->mask_buf, dsc->mask_stride, dsc->dest_w, dsc->dest_h,
+               step_color_to_argb8888, &p);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_argb8888_blend_normal_to_argb8888_x86(_lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    step_param_t p = {.opa = dsc->opa, .dest_px_size = 4, .src_px_size = 4};
+    blend_rows(dsc->dest_buf, dsc->dest_stride, dsc->src_buf, dsc->src_stride, dsc->mask_buf, dsc->mask_stride,
+               dsc->dest_w, dsc->dest_h, step_argb8888_to_argb8888, &p);
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static inline void blend_rows(uint8_t * dest, int32_t dest_stride, const uint8_t * src, int32_t src_stride,
+                              const lv_opa_t * mask, int32_t mask_stride, int32_t w, int32_t h,
+                              step_cb_t step, const step_param_t * p)
+{
+    uint32_t dest_px_size = p->dest_px_size;
+    uint32_t src_px_size = p->src_px_size;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        int32_t x;
+        for(x = 0; x + STEP_PX <= w; x += STEP_PX) {
+            step(dest + x * dest_px_size, src ? src + x * src_px_size : NULL, mask ? mask + x : NULL, p);
+        }
+
+        if(x < w) {
+            uint8_t dest_tmp[STEP_PX * 4] = {0};
+            uint8_t src_tmp[STEP_PX * 4] = {0};
+            lv_opa_t mask_tmp[STEP_PX] = {0};
+            int32_t rest = w - x;
+            lv_memcpy(dest_tmp, dest + x * dest_px_size, rest * dest_px_size);
+            if(src) lv_memcpy(src_tmp, src + x * src_px_size, rest * src_px_size);
+            if(mask) lv_memcpy(mask_tmp, mask + x, rest);
+            step(dest_tmp, src ? src_tmp : NULL, mask ? mask_tmp : NULL, p);
+            lv_memcpy(dest + x * dest_px_size, dest_tmp, rest * dest_px_size);
+        }
+
+        dest += dest_stride;
+        if(src) src += src_stride;
+        if(mask) mask += mask_stride;
+    }
+}
+
+static void step_color_to_rgb565(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const step_param_t * p)
+{
+    LV_UNUSED(src);
+    __m128i bg = _mm_loadu_si128((const __m128i *)dest);
+    __m128i res = rgb565_mix(_mm_set1_epi16((int16_t)p->color), bg, get_mix(mask, p->opa));
+    _mm_storeu_si128((__m128i *)dest, res);
+}
+
+static void step_rgb565_to_rgb565(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const step_param_t * p)
+{
+    __m128i fg = _mm_loadu_si128((const __m128i *)src);
+    __m128i bg = _mm_loadu_si128((const __m128i *)dest);
+    _mm_storeu_si128((__m128i *)dest, rgb565_mix(fg, bg, get_mix(mask, p->opa)));
+}
+
+static void step_rgb888_to_rgb565(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const step_param_t * p)
+{
+    __m128i fg_lo = load_rgb888_4(src, p->src_px_size);
+    __m128i fg_hi = load_rgb888_4(src + 4 * p->src_px_size, p->src_px_size);
+    __m128i bg = _mm_loadu_si128((const __m128i *)dest);
+    _mm_storeu_si128((__m128i *)dest, rgb888_to_rgb565_mix(fg_lo, fg_hi, bg, get_mix(mask, p->opa)));
+}
+
+static void step_argb8888_to_rgb565(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                    const step_param_t * p)
+{
+    __m128i fg_lo = _mm_loadu_si128((const __m128i *)src);
+    __m128i fg_hi = _mm_loadu_si128((const __m128i *)(src + 16));
+    __m128i bg = _mm_loadu_si128((const __m128i *)dest);
+    __m128i mix = get_mix_alpha(get_alpha(fg_lo, fg_hi), mask, p->opa);
+    _mm_storeu_si128((__m128i *)dest, rgb888_to_rgb565_mix(fg_lo, fg_hi, bg, mix));
+}
+
+static void step_color_to_rgb888(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const step_param_t * p)
+{
+    LV_UNUSED(src);
+    __m128i fg = _mm_set1_epi32((int32_t)p->color);
+    rgb888_mix(dest, p->dest_px_size, fg, fg, get_mix(mask, p->opa));
+}
+
+static void step_rgb888_to_rgb888(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask, const step_param_t * p)
+{
+    __m128i fg_lo = load_rgb888_4(src, p->src_px_size);
+    __m128i fg_hi = load_rgb888_4(src + 4 * p->src_px_size, p->src_px_size);
+    rgb888_mix(dest, p->dest_px_size, fg_lo, fg_hi, get_mix(mask, p->opa));
+}
+
+static void step_argb8888_to_rgb888(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                    const step_param_t * p)
+{
+    __m128i fg_lo = _mm_loadu_si128((const __m128i *)src);
+    __m128i fg_hi = _mm_loadu_si128((const __m128i *)(src + 16));
+    __m128i mix = get_mix_alpha(get_alpha(fg_lo, fg_hi), mask, p->opa);
+    rgb888_mix(dest, p->dest_px_size, fg_lo, fg_hi, mix);
+}
+
+static void step_color_to_argb8888(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                   const step_param_t * p)
+{
+    LV_UNUSED(src);
+    __m128i fg = _mm_set1_epi32((int32_t)p->color);
+    argb8888_mix(dest, fg, fg, get_mix(mask, p->opa));
+}
+
+static void step_argb8888_to_argb8888(uint8_t * dest, const uint8_t * src, const lv_opa_t * mask,
+                                      const step_param_t * p)
+{
+    __m128i fg_lo = _mm_loadu_si128((const __m128i *)src);
+    __m128i fg_hi = _mm_loadu_si128((const __m128i *)(src + 16));
+    __m128i mix = get_mix_alpha(get_alpha(fg_lo, fg_hi), mask, p->opa);
+    argb8888_mix(dest, fg_lo, fg_hi, mix);
+}
+
+/**
+ * Get the opacity of 8 pixels as 16 bit values if the source has no alpha channel.
+ * Same as the `opa`, `mask[x]` and `LV_OPA_MIX2(mask[x], opa)` of the C implementation.
+ */
+static inline __m128i get_mix(const lv_opa_t * mask, lv_opa_t opa)
+{
+    if(mask == NULL) return _mm_set1_epi16(opa >= LV_OPA_MAX ? 255 : opa);
+
+    __m128i m = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)mask), _mm_setzero_si128());
+    if(opa < LV_OPA_MAX) m = _mm_srli_epi16(_mm_mullo_epi16(m, _mm_set1_epi16(opa)), 8);
+    return m;
+}
+
+/**
+ * Get the opacity of 8 pixels as 16 bit values if the source has an alpha channel.
+ * Same as the `LV_OPA_MIX2` and `LV_OPA_MIX3` of the C implementation.
+ */
+static inline __m128i get_mix_alpha(__m128i alpha, const lv_opa_t * mask, lv_opa_t opa)
+{
+    if(mask == NULL) {
+        if(opa >= LV_OPA_MAX) return alpha;
+        else return _mm_srli_epi16(_mm_mullo_epi16(alpha, _mm_set1_epi16(opa)), 8);
+    }
+
+    __m128i m = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)mask), _mm_setzero_si128());
+    __m128i am = _mm_mullo_epi16(alpha, m);     /*At most 255 * 255, still fits*/
+    if(opa >= LV_OPA_MAX) return _mm_srli_epi16(am, 8);
+    else return _mm_mulhi_epu16(am, _mm_set1_epi16(opa));
+}
+
+/*Get the alpha channel of 8 ARGB8888 pixels as 16 bit values*/
+static inline __m128i get_alpha(__m128i px_lo, __m128i px_hi)
+{
+    return _mm_packs_epi32(_mm_srli_epi32(px_lo, 24), _mm_srli_epi32(px_hi, 24));
+}
+
+#if !defined(__AVX2__)
+static inline __m128i mullo_epi32(__m128i a, __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/*`lv_color_16_16_mix` on 4 pixels stored in the lower half of 32 bit values*/
+static inline __m128i rgb565_mix_4(__m128i fg, __m128i bg, __m128i mix)
+{
+    const __m128i rb_g = _mm_set1_epi32(0x7E0F81F);
+    fg = _mm_and_si128(_mm_or_si128(fg, _mm_slli_epi32(fg, 16)), rb_g);
+    bg = _mm_and_si128(_mm_or_si128(bg, _mm_slli_epi32(bg, 16)), rb_g);
+    __m128i res = mullo_epi32(_mm_sub_epi32(fg, bg), mix);
+    res = _mm_and_si128(_mm_add_epi32(_mm_srli_epi32(res, 5), bg), rb_g);
+    res = _mm_or_si128(res, _mm_srli_epi32(res, 16));
+
+    /*Sign extend the lower 16 bit so that the signed saturation of the packing keeps them*/
+    return _mm_srai_epi32(_mm_slli_epi32(res, 16), 16);
+}
+#endif
+
+/**
+ * Mix 8 RGB565 pixels exactly like `lv_color_16_16_mix`.
+ * The separated channels are multiplied together in 32 bit as in the C implementation,
+ * that is the borrow between the channels is kept too.
+ */
+static inline __m128i rgb565_mix(__m128i fg, __m128i bg, __m128i mix)
+{
+    mix = _mm_srli_epi16(_mm_add_epi16(mix, _mm_set1_epi16(4)), 3);
+
+#if defined(__AVX2__)
+    const __m256i rb_g = _mm256_set1_epi32(0x7E0F81F);
+    __m256i fg32 = _mm256_cvtepu16_epi32(fg);
+    __m256i bg32 = _mm256_cvtepu16_epi32(bg);
+    fg32 = _mm256_and_si256(_mm256_or_si256(fg32, _mm256_slli_epi32(fg32, 16)), rb_g);
+    bg32 = _mm256_and_si256(_mm256_or_si256(bg32, _mm256_slli_epi32(bg32, 16)), rb_g);
+    __m256i res = _mm256_mullo_epi32(_mm256_sub_epi32(fg32, bg32), _mm256_cvtepu16_epi32(mix));
+    res = _mm256_and_si256(_mm256_add_epi32(_mm256_srli_epi32(res, 5), bg32), rb_g);
+    res = _mm256_and_si256(_mm256_or_si256(res, _mm256_srli_epi32(res, 16)), _mm256_set1_epi32(0xFFFF));
+    return _mm_packus_epi32(_mm256_castsi256_si128(res), _mm256_extracti128_si256(res, 1));
+#else
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = rgb565_mix_4(_mm_unpacklo_epi16(fg, zero), _mm_unpacklo_epi16(bg, zero),
+                              _mm_unpacklo_epi16(mix, zero));
+    __m128i hi = rgb565_mix_4(_mm_unpackhi_epi16(fg, zero), _mm_unpackhi_epi16(bg, zero),
+                              _mm_unpackhi_epi16(mix, zero));
+    return _mm_packs_epi32(lo, hi);
+#endif
+}
+
+/**
+ * Mix 8 RGB888 pixels (in 32 bit) to 8 RGB565 pixels exactly like `lv_color_24_16_mix`.
+ */
+static inline __m128i rgb888_to_rgb565_mix(__m128i fg_lo, __m128i fg_hi, __m128i bg, __m128i mix)
+{
+    const __m128i ff = _mm_set1_epi32(0xFF);
+    __m128i r = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(fg_lo, 16), ff),
+                                _mm_and_si128(_mm_srli_epi32(fg_hi, 16), ff));
+    __m128i g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(fg_lo, 8), ff),
+                                _mm_and_si128(_mm_srli_epi32(fg_hi, 8), ff));
+    __m128i b = _mm_packs_epi32(_mm_and_si128(fg_lo, ff), _mm_and_si128(fg_hi, ff));
+
+    __m128i mix_inv = _mm_sub_epi16(_mm_set1_epi16(255), mix);
+    __m128i bg_r = _mm_srli_epi16(bg, 11);
+    __m128i bg_g = _mm_and_si128(_mm_srli_epi16(bg, 5), _mm_set1_epi16(0x3F));
+    __m128i bg_b = _mm_and_si128(bg, _mm_set1_epi16(0x1F));
+
+    __m128i res_r = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(r, 3), mix), _mm_mullo_epi16(bg_r, mix_inv));
+    __m128i res_g = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(g, 2), mix), _mm_mullo_epi16(bg_g, mix_inv));
+    __m128i res_b = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(b, 3), mix), _mm_mullo_epi16(bg_b, mix_inv));
+    __m128i res = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(res_r, 3), _mm_set1_epi16((int16_t)0xF800)),
+                               _mm_and_si128(_mm_srli_epi16(res_g, 3), _mm_set1_epi16(0x07E0)));
+    res = _mm_or_si128(res, _mm_srli_epi16(res_b, 8));
+
+    /*The C implementation just truncates the color on 255 and keeps the background on 0*/
+    __m128i cover = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(r, _mm_set1_epi16(0xF8)), 8),
+                                 _mm_slli_epi16(_mm_and_si128(g, _mm_set1_epi16(0xFC)), 3));
+    cover = _mm_or_si128(cover, _mm_srli_epi16(b, 3));
+    res = select_128(res, cover, _mm_cmpeq_epi16(mix, _mm_set1_epi16(255)));
+    return select_128(res, bg, _mm_cmpeq_epi16(mix, _mm_setzero_si128()));
+}
+
+/*Mix 8 RGB888 pixels (in 32 bit) to an RGB888 or XRGB8888 destination*/
+static inline void rgb888_mix(uint8_t * dest, uint32_t dest_px_size, __m128i fg_lo, __m128i fg_hi, __m128i mix)
+{
+    const __m128i zero = _mm_setzero_si128();
+    uint8_t * dest_hi = dest + 4 * dest_px_size;
+    __m128i res_lo = rgb888_mix_4(fg_lo, load_rgb888_4(dest, dest_px_size), _mm_unpacklo_epi16(mix, zero));
+    __m128i res_hi = rgb888_mix_4(fg_hi, load_rgb888_4(dest_hi, dest_px_size), _mm_unpackhi_epi16(mix, zero));
+    store_rgb888_4(dest, res_lo, dest_px_size);
+    store_rgb888_4(dest_hi, res_hi, dest_px_size);
+}
+
+/**
+ * Mix 4 pixels exactly like `lv_color_24_24_mix`. The mix is a 32 bit value per pixel.
+ * The 4th byte of the background is kept.
+ */
+static inline __m128i rgb888_mix_4(__m128i fg, __m128i bg, __m128i mix)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i v255 = _mm_set1_epi16(255);
+
+    /*The same mix for the 3 color bytes and 0 for the 4th*/
+    mix = _mm_or_si128(_mm_or_si128(mix, _mm_slli_epi32(mix, 8)), _mm_slli_epi32(mix, 16));
+
+    __m128i mix_lo = _mm_unpacklo_epi8(mix, zero);
+    __m128i mix_hi = _mm_unpackhi_epi8(mix, zero);
+    __m128i res_lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(fg, zero), mix_lo),
+                                   _mm_mullo_epi16(_mm_unpacklo_epi8(bg, zero), _mm_sub_epi16(v255, mix_lo)));
+    __m128i res_hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(fg, zero), mix_hi),
+                                   _mm_mullo_epi16(_mm_unpackhi_epi8(bg, zero), _mm_sub_epi16(v255, mix_hi)));
+    __m128i res = _mm_packus_epi16(_mm_srli_epi16(res_lo, 8), _mm_srli_epi16(res_hi, 8));
+
+    __m128i cover = _mm_cmpeq_epi8(_mm_max_epu8(mix, _mm_set1_epi8((char)LV_OPA_MAX)), mix);
+    res = select_128(res, fg, cover);
+    return select_128(res, bg, _mm_cmpeq_epi8(mix, zero));
+}
+
+/*Mix 8 pixels to an ARGB8888 destination. The alpha channel of `fg` is replaced by `mix`*/
+static inline void argb8888_mix(uint8_t * dest, __m128i fg_lo, __m128i fg_hi, __m128i mix)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i bg_lo = _mm_loadu_si128((const __m128i *)dest);
+    __m128i bg_hi = _mm_loadu_si128((const __m128i *)(dest + 16));
+    _mm_storeu_si128((__m128i *)dest, argb8888_mix_4(fg_lo, bg_lo, _mm_unpacklo_epi16(mix, zero)));
+    _mm_storeu_si128((__m128i *)(dest + 16), argb8888_mix_4(fg_hi, bg_hi, _mm_unpackhi_epi16(mix, zero)));
+}
+
+/**
+ * Mix 4 pixels exactly like `lv_color_32_32_mix`.
+ * The vectors handle the cases when the background is opaque or one of the colors can be picked.
+ * Pixels with semi-transparent foreground and background are mixed one by one.
+ */
+static inline __m128i argb8888_mix_4(__m128i fg, __m128i bg, __m128i alpha)
+{
+    fg = _mm_or_si128(_mm_and_si128(fg, _mm_set1_epi32(0x00FFFFFF)), _mm_slli_epi32(alpha, 24));
+
+    __m128i bg_alpha = _mm_srli_epi32(bg, 24);
+    __m128i pick_fg = _mm_or_si128(_mm_cmpgt_epi32(alpha, _mm_set1_epi32(LV_OPA_MAX - 1)),
+                                   _mm_cmplt_epi32(bg_alpha, _mm_set1_epi32(LV_OPA_MIN + 1)));
+    __m128i pick_bg = _mm_andnot_si128(pick_fg, _mm_cmplt_epi32(alpha, _mm_set1_epi32(LV_OPA_MIN + 1)));
+    __m128i picked = _mm_or_si128(pick_fg, pick_bg);
+
+    /*With opaque background the alpha channel is kept*/
+    __m128i res = rgb888_mix_4(fg, bg, alpha);
+    res = select_128(res, bg, pick_bg);
+    res = select_128(res, fg, pick_fg);
+
+    __m128i slow = _mm_andnot_si128(_mm_or_si128(picked, _mm_cmpeq_epi32(bg_alpha, _mm_set1_epi32(255))),
+                                    _mm_set1_epi32(-1));
+    if(_mm_movemask_epi8(slow) == 0) return res;
+
+    lv_color32_t fg_px[4];
+    lv_color32_t bg_px[4];
+    lv_color32_t res_px[4];
+    uint32_t slow_px[4];
+    _mm_storeu_si128((__m128i *)fg_px, fg);
+    _mm_storeu_si128((__m128i *)bg_px, bg);
+    _mm_storeu_si128((__m128i *)res_px, res);
+    _mm_storeu_si128((__m128i *)slow_px, slow);
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        if(slow_px[i]) res_px[i] = argb8888_mix_px(fg_px[i], bg_px[i]);
+    }
+    return _mm_loadu_si128((const __m128i *)res_px);
+}
+
+/*The case of `lv_color_32_32_mix` when both colors are semi-transparent*/
+static lv_color32_t argb8888_mix_px(lv_color32_t fg, lv_color32_t bg)
+{
+    lv_opa_t res_alpha = 255 - LV_OPA_MIX2(255 - fg.alpha, 255 - bg.alpha);
+    fg.alpha = (uint32_t)((uint32_t)fg.alpha * 255) / res_alpha;
+    lv_color32_t res = lv_color_mix32(fg, bg);
+    res.alpha = res_alpha;
+    return res;
+}
+
+static inline __m128i load_rgb888_4(const uint8_t * src, uint32_t px_size)
+{
+    if(px_size == 4) return _mm_loadu_si128((const __m128i *)src);
+
+    return _mm_setr_epi32(src[0] | (src[1] << 8) | (src[2] << 16),
+                          src[3] | (src[4] << 8) | (src[5] << 16),
+                          src[6] | (src[7] << 8) | (src[8] << 16),
+                          src[9] | (src[10] << 8) | (src[11] << 16));
+}
+
+static inline void store_rgb888_4(uint8_t * dest, __m128i px, uint32_t px_size)
+{
+    if(px_size == 4) {
+        _mm_storeu_si128((__m128i *)dest, px);
+        return;
+    }
+
+    uint8_t px_u8[16];
+    _mm_storeu_si128((__m128i *)px_u8, px);
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        dest[i * 3 + 0] = px_u8[i * 4 + 0];
+        dest[i * 3 + 1] = px_u8[i * 4 + 1];
+        dest[i * 3 + 2] = px_u8[i * 4 + 2];
+    }
+}
+
+/*Pick `b` where `sel` is all 1 and `a` elsewhere*/
+static inline __m128i select_128(__m128i a, __m128i b, __m128i sel)
+{
+    return _mm_or_si128(_mm_and_si128(sel, b), _mm_andnot_si128(sel, a));
+}
+
+static void fill_16(uint16_t * dest, uint16_t color, int32_t w)
+{
+    int32_t x = 0;
+#if defined(__AVX2__)
+    const __m256i c256 = _mm256_set1_epi16((int16_t)color);
+    for(; x + 16 <= w; x += 16) _mm256_storeu_si256((__m256i *)&dest[x], c256);
+#endif
+    const __m128i c128 = _mm_set1_epi16((int16_t)color);
+    for(; x + 8 <= w; x += 8) _mm_storeu_si128((__m128i *)&dest[x], c128);
+    for(; x < w; x++) dest[x] = color;
+}
+
+static void fill_32(uint32_t * dest, uint32_t color, int32_t w)
+{
+    int32_t x = 0;
+#if defined(__AVX2__)
+    const __m256i c256 = _mm256_set1_epi32((int32_t)color);
+    for(; x + 8 <= w; x += 8) _mm256_storeu_si256((__m256i *)&dest[x], c256);
+#endif
+    const __m128i c128 = _mm_set1_epi32((int32_t)color);
+    for(; x + 4 <= w; x += 4) _mm_storeu_si128((__m128i *)&dest[x], c128);
+    for(; x < w; x++) dest[x] = color;
+}
+
+static void copy_row(uint8_t * dest, const uint8_t * src, int32_t size)
+{
+    int32_t i = 0;
+#if defined(__AVX2__)
+    for(; i + 32 <= size; i += 32) {
+        _mm256_storeu_si256((__m256i *)&dest[i], _mm256_loadu_si256((const __m256i *)&src[i]));
+    }
+#endif
+    for(; i + 16 <= size; i += 16) {
+        _mm_storeu_si128((__m128i *)&dest[i], _mm_loadu_si128((const __m128i *)&src[i]));
+    }
+    for(; i < size; i++) dest[i] = src[i];
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && defined(__SSE2__)*/
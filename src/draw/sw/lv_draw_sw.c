@@ -23,8 +23,12 @@
     #endif
 #endif
 
-#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
+#if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON
+    #include "neon/lv_draw_sw_neon.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_HELIUM
     #include "arm2d/lv_draw_sw_helium.h"
+#elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86
+    #include "x86/lv_draw_sw_x86.h"
 #elif LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
@@ -34,6 +38,12 @@
  *********************/
 #define DRAW_UNIT_ID_SW     1
 
+/*Split large draw tasks into bands only if there are more threads to render them*/
+#define SPLIT_TASKS         (LV_USE_OS && LV_DRAW_SW_DRAW_UNIT_CNT > 1 && LV_DRAW_SW_SPLIT_MIN_AREA > 0)
+
+/*Don't create bands smaller than this many rows*/
+#define SPLIT_BAND_MIN_H    8
+
 #ifndef LV_DRAW_SW_RGB565_SWAP
     #define LV_DRAW_SW_RGB565_SWAP(...) LV_RESULT_INVALID
 #endif
@@ -74,6 +84,21 @@
     #define LV_DRAW_SW_ROTATE270_RGB565(...) LV_RESULT_INVALID
 #endif
 
+#ifndef LV_DRAW_SW_ROTATE90_RGB565_SWAP
+    #define LV_DRAW_SW_ROTATE90_RGB565_SWAP(...) LV_RESULT_INVALID
+#endif
+
+#ifndef LV_DRAW_SW_ROTATE180_RGB565_SWAP
+    #define LV_DRAW_SW_ROTATE180_RGB565_SWAP(...) LV_RESULT_INVALID
+#endif
+
+#ifndef LV_DRAW_SW_ROTATE270_RGB565_SWAP
+    #define LV_DRAW_SW_ROTATE270_RGB565_SWAP(...) LV_RESULT_INVALID
+#endif
+
+/*Rotate by 90 degrees in tiles which fit into the cache with both their source and destination*/
+#define ROTATE_TILE_SIZE    32
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -86,6 +111,11 @@
 #endif
 
 static void execute_drawing(lv_draw_sw_unit_t * u);
+#if SPLIT_TASKS
+    static bool band_job_init(lv_draw_sw_unit_t * u, lv_layer_t * layer, lv_draw_task_t * t);
+    static lv_draw_sw_unit_t * band_job_find(lv_layer_t * layer, lv_draw_task_t ** task);
+    static void execute_drawing_bands(lv_draw_sw_unit_t * u);
+#endif
 
 static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
 static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
@@ -107,12 +137,13 @@ static void rotate270_rgb888(const uint8_t * src, uint8_t * dst, int32_t width,
                              int32_t dstStride);
 static void rotate90_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWidth, int32_t srcHeight,
                             int32_t srcStride,
-                            int32_t dstStride);
+                            int32_t dstStride, bool swap);
 static void rotate180_rgb565(const uint16_t * src, uint16_t * dst, int32_t width, int32_t height, int32_t src_stride,
-                             int32_t dest_stride);
+                             int32_t dest_stride, bool swap);
 static void rotate270_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWidth, int32_t srcHeight,
                              int32_t srcStride,
-                             int32_t dstStride);
+                             int32_t dstStride, bool swap);
+static inline uint16_t swap_rgb565(uint16_t px);
 
 /**********************
  *  STATIC VARIABLES
@@ -143,6 +174,7 @@ void lv_draw_sw_init(void)
         draw_sw_unit->base_unit.delete_cb = LV_USE_OS ? lv_draw_sw_delete : NULL;
 
 #if LV_USE_OS
+        lv_mutex_init(&draw_sw_unit->band_job.mutex);
         lv_thread_init(&draw_sw_unit->thread, LV_THREAD_PRIO_HIGH, render_thread_cb, LV_DRAW_THREAD_STACK_SIZE, draw_sw_unit);
 #endif
     }
@@ -175,7 +207,9 @@ static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
         lv_thread_sync_signal(&draw_sw_unit->sync);
     }
 
-    return lv_thread_delete(&draw_sw_unit->thread);
+    lv_result_t res = lv_thread_delete(&draw_sw_unit->thread);
+    lv_mutex_delete(&draw_sw_unit->band_job.mutex);
+    return res;
 #else
     LV_UNUSED(draw_unit);
     return 0;
@@ -186,9 +220,17 @@ void lv_draw_sw_rgb565_swap(void * buf, uint32_t buf_size_px)
 {
     if(LV_DRAW_SW_RGB565_SWAP(buf, buf_size_px) == LV_RESULT_OK) return;
 
-    uint32_t u32_cnt = buf_size_px / 2;
     uint16_t * buf16 = buf;
-    uint32_t * buf32 = buf;
+
+    /*Swap the first pixel alone if needed to access the others as aligned 32 bit words*/
+    if(((lv_uintptr_t)buf16 & 0x3) && buf_size_px > 0) {
+        *buf16 = swap_rgb565(*buf16);
+        buf16++;
+        buf_size_px--;
+    }
+
+    uint32_t u32_cnt = buf_size_px / 2;
+    uint32_t * buf32 = (uint32_t *)buf16;
 
     while(u32_cnt >= 8) {
         buf32[0] = ((buf32[0] & 0xff00ff00) >> 8) | ((buf32[0] & 0x00ff00ff) << 8);
@@ -222,7 +264,7 @@ void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t
     if(rotation == LV_DISPLAY_ROTATION_90) {
         switch(color_format) {
             case LV_COLOR_FORMAT_RGB565:
-                rotate90_rgb565(src, dest, src_width, src_height, src_sride, dest_stride);
+                rotate90_rgb565(src, dest, src_width, src_height, src_sride, dest_stride, false);
                 break;
             case LV_COLOR_FORMAT_RGB888:
                 rotate90_rgb888(src, dest, src_width, src_height, src_sride, dest_stride);
@@ -241,7 +283,7 @@ void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t
     if(rotation == LV_DISPLAY_ROTATION_180) {
         switch(color_format) {
             case LV_COLOR_FORMAT_RGB565:
-                rotate180_rgb565(src, dest, src_width, src_height, src_sride, dest_stride);
+                rotate180_rgb565(src, dest, src_width, src_height, src_sride, dest_stride, false);
                 break;
             case LV_COLOR_FORMAT_RGB888:
                 rotate180_rgb888(src, dest, src_width, src_height, src_sride, dest_stride);
@@ -260,7 +302,7 @@ void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t
     if(rotation == LV_DISPLAY_ROTATION_270) {
         switch(color_format) {
             case LV_COLOR_FORMAT_RGB565:
-                rotate270_rgb565(src, dest, src_width, src_height, src_sride, dest_stride);
+                rotate270_rgb565(src, dest, src_width, src_height, src_sride, dest_stride, false);
                 break;
             case LV_COLOR_FORMAT_RGB888:
                 rotate270_rgb888(src, dest, src_width, src_height, src_sride, dest_stride);
@@ -277,11 +319,45 @@ void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t
     }
 }
 
+void lv_draw_sw_rgb565_rotate_swap(const void * src, void * dest, int32_t src_width, int32_t src_height,
+                                   int32_t src_stride, int32_t dest_stride, lv_display_rotation_t rotation)
+{
+    switch(rotation) {
+        case LV_DISPLAY_ROTATION_0: {
+                const uint8_t * src_row = src;
+                uint8_t * dest_row = dest;
+                for(int32_t y = 0; y < src_height; y++) {
+                    lv_memcpy(dest_row, src_row, src_width * sizeof(uint16_t));
+                    lv_draw_sw_rgb565_swap(dest_row, src_width);
+                    src_row += src_stride;
+                    dest_row += dest_stride;
+                }
+                break;
+            }
+        case LV_DISPLAY_ROTATION_90:
+            rotate90_rgb565(src, dest, src_width, src_height, src_stride, dest_stride, true);
+            break;
+        case LV_DISPLAY_ROTATION_180:
+            rotate180_rgb565(src, dest, src_width, src_height, src_stride, dest_stride, true);
+            break;
+        case LV_DISPLAY_ROTATION_270:
+            rotate270_rgb565(src, dest, src_width, src_height, src_stride, dest_stride, true);
+            break;
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 static inline void execute_drawing_unit(lv_draw_sw_unit_t * u)
 {
+#if SPLIT_TASKS
+    if(u->band_job_owner) {
+        execute_drawing_bands(u);
+        return;
+    }
+#endif
+
     execute_drawing(u);
 
     u->task_act->state = LV_DRAW_TASK_STATE_READY;
@@ -340,6 +416,19 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
         return 0;
     }
 
+#if SPLIT_TASKS
+    /*Help the other units to finish their split draw tasks first as they might block many other tasks*/
+    lv_draw_task_t * t_band = NULL;
+    lv_draw_sw_unit_t * owner = band_job_find(layer, &t_band);
+    if(owner) {
+        draw_sw_unit->band_job_owner = owner;
+        draw_sw_unit->task_act = t_band;
+        if(draw_sw_unit->inited) lv_thread_sync_signal(&draw_sw_unit->sync);
+        LV_PROFILER_END;
+        return 1;
+    }
+#endif
+
     lv_draw_task_t * t = NULL;
     t = lv_draw_get_next_available_task(layer, NULL, DRAW_UNIT_ID_SW);
     if(t == NULL) {
@@ -356,6 +445,16 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
     t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
     draw_sw_unit->base_unit.target_layer = layer;
     draw_sw_unit->base_unit.clip_area = &t->clip_area;
+
+#if SPLIT_TASKS
+    /*Set it before `task_act` as the render thread might see `task_act` immediately*/
+    if(band_job_init(draw_sw_unit, layer, t)) {
+        draw_sw_unit->band_job_owner = draw_sw_unit;
+        /*Dispatch again to let the idle units join*/
+        lv_draw_dispatch_request();
+    }
+#endif
+
     draw_sw_unit->task_act = t;
 
 #if LV_USE_OS
@@ -368,6 +467,119 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
     return 1;
 }
 
+#if SPLIT_TASKS
+/**
+ * Split a draw task into bands if it's large enough and can be rendered in parts
+ * @param u         the draw unit which has taken the task
+ * @param layer     the layer of the task
+ * @param t         the draw task
+ * @return          true: the task was split into `u->band_job`
+ */
+static bool band_job_init(lv_draw_sw_unit_t * u, lv_layer_t * layer, lv_draw_task_t * t)
+{
+    /*Only these tasks are rendered pixel-by-pixel independently from the clip area.
+     *E.g. the box shadow would calculate the whole blur for each band.*/
+    if(t->type != LV_DRAW_TASK_TYPE_FILL &&
+       t->type != LV_DRAW_TASK_TYPE_IMAGE &&
+       t->type != LV_DRAW_TASK_TYPE_LAYER) return false;
+
+    lv_area_t area;
+    if(!_lv_area_intersect(&area, &t->_real_area, &t->clip_area)) return false;
+    if(lv_area_get_size(&area) < LV_DRAW_SW_SPLIT_MIN_AREA) return false;
+
+    /*Create twice as many bands as draw units to balance the load*/
+    int32_t h = lv_area_get_height(&area);
+    int32_t band_h = (h + LV_DRAW_SW_DRAW_UNIT_CNT * 2 - 1) / (LV_DRAW_SW_DRAW_UNIT_CNT * 2);
+    if(band_h < SPLIT_BAND_MIN_H) band_h = SPLIT_BAND_MIN_H;
+    if(band_h >= h) return false;
+
+    lv_draw_sw_band_job_t * job = &u->band_job;
+    lv_mutex_lock(&job->mutex);
+    /*The previous job of the unit might be still rendered by other units*/
+    bool free_job = job->task == NULL;
+    if(free_job) {
+        job->task = t;
+        job->layer = layer;
+        job->area = area;
+        job->band_h = band_h;
+        job->band_cnt = (h + band_h - 1) / band_h;
+        job->band_next = 0;
+        job->band_ready_cnt = 0;
+    }
+    lv_mutex_unlock(&job->mutex);
+
+    return free_job;
+}
+
+/**
+ * Find a split draw task of a layer which has bands not taken yet
+ * @param layer     the layer whose draw tasks are dispatched
+ * @param task      store the split draw task here
+ * @return          the draw unit owning the band job or NULL if not found
+ */
+static lv_draw_sw_unit_t * band_job_find(lv_layer_t * layer, lv_draw_task_t ** task)
+{
+    lv_draw_unit_t * u = _draw_info.unit_head;
+    while(u) {
+        if(u->dispatch_cb == dispatch) {
+            lv_draw_sw_unit_t * sw_unit = (lv_draw_sw_unit_t *)u;
+            lv_draw_sw_band_job_t * job = &sw_unit->band_job;
+            lv_mutex_lock(&job->mutex);
+            bool found = job->task && job->layer == layer && job->band_next < job->band_cnt;
+            if(found) *task = job->task;
+            lv_mutex_unlock(&job->mutex);
+            if(found) return sw_unit;
+        }
+        u = u->next;
+    }
+
+    return NULL;
+}
+
+/**
+ * Render the bands of a split draw task until there are no more bands to take.
+ * The unit rendering the last band marks the task as ready.
+ * @param u         pointer to a draw unit with `band_job_owner` set
+ */
+static void execute_drawing_bands(lv_draw_sw_unit_t * u)
+{
+    lv_draw_sw_band_job_t * job = &u->band_job_owner->band_job;
+    lv_draw_task_t * t = u->task_act;
+
+    while(1) {
+        lv_mutex_lock(&job->mutex);
+        if(job->task != t || job->band_next >= job->band_cnt) {
+            lv_mutex_unlock(&job->mutex);
+            break;
+        }
+        uint32_t band_idx = job->band_next;
+        job->band_next++;
+        u->base_unit.target_layer = job->layer;
+        u->band_clip_area = job->area;
+        u->band_clip_area.y1 = job->area.y1 + (int32_t)band_idx * job->band_h;
+        u->band_clip_area.y2 = LV_MIN(u->band_clip_area.y1 + job->band_h - 1, job->area.y2);
+        lv_mutex_unlock(&job->mutex);
+
+        u->base_unit.clip_area = &u->band_clip_area;
+        execute_drawing(u);
+
+        lv_mutex_lock(&job->mutex);
+        job->band_ready_cnt++;
+        bool last = job->band_ready_cnt == job->band_cnt;
+        if(last) job->task = NULL;
+        lv_mutex_unlock(&job->mutex);
+
+        if(last) t->state = LV_DRAW_TASK_STATE_READY;
+    }
+
+    u->band_job_owner = NULL;
+    u->task_act = NULL;
+
+    /*The draw unit is free now. Request a new dispatching as it can get a new task*/
+    lv_draw_dispatch_request();
+}
+#endif /*SPLIT_TASKS*/
+
 #if LV_USE_OS
 static void render_thread_cb(void * ptr)
 {
@@ -500,12 +712,15 @@ static void rotate270_argb8888(const uint32_t * src, uint32_t * dst, int32_t src
     srcStride /= sizeof(uint32_t);
     dstStride /= sizeof(uint32_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = x * dstStride;
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex + (srcHeight - y - 1)] = src[srcIndex];
-            srcIndex += srcStride;
+    for(int32_t tileY = 0; tileY < srcHeight; tileY += ROTATE_TILE_SIZE) {
+        int32_t yEnd = LV_MIN(tileY + ROTATE_TILE_SIZE, srcHeight);
+        for(int32_t x = 0; x < srcWidth; ++x) {
+            int32_t dstIndex = x * dstStride;
+            int32_t srcIndex = tileY * srcStride + x;
+            for(int32_t y = tileY; y < yEnd; ++y) {
+                dst[dstIndex + (srcHeight - y - 1)] = src[srcIndex];
+                srcIndex += srcStride;
+            }
         }
     }
 }
@@ -513,15 +728,15 @@ static void rotate270_argb8888(const uint32_t * src, uint32_t * dst, int32_t src
 static void rotate180_argb8888(const uint32_t * src, uint32_t * dst, int32_t width, int32_t height, int32_t src_stride,
                                int32_t dest_stride)
 {
-    LV_UNUSED(dest_stride);
-    if(LV_RESULT_OK == LV_DRAW_SW_ROTATE180_ARGB8888(src, dst, srcWidth, srcHeight, srcStride, dstStride)) {
+    if(LV_RESULT_OK == LV_DRAW_SW_ROTATE180_ARGB8888(src, dst, width, height, src_stride, dest_stride)) {
         return ;
     }
 
     src_stride /= sizeof(uint32_t);
+    dest_stride /= sizeof(uint32_t);
 
     for(int32_t y = 0; y < height; ++y) {
-        int32_t dstIndex = (height - y - 1) * src_stride;
+        int32_t dstIndex = (height - y - 1) * dest_stride;
         int32_t srcIndex = y * src_stride;
         for(int32_t x = 0; x < width; ++x) {
             dst[dstIndex + width - x - 1] = src[srcIndex + x];
@@ -540,12 +755,15 @@ static void rotate90_argb8888(const uint32_t * src, uint32_t * dst, int32_t srcW
     srcStride /= sizeof(uint32_t);
     dstStride /= sizeof(uint32_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = (srcWidth - x - 1);
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex * dstStride + y] = src[srcIndex];
-            srcIndex += srcStride;
+    for(int32_t tileY = 0; tileY < srcHeight; tileY += ROTATE_TILE_SIZE) {
+        int32_t yEnd = LV_MIN(tileY + ROTATE_TILE_SIZE, srcHeight);
+        for(int32_t x = 0; x < srcWidth; ++x) {
+            int32_t dstIndex = (srcWidth - x - 1) * dstStride;
+            int32_t srcIndex = tileY * srcStride + x;
+            for(int32_t y = tileY; y < yEnd; ++y) {
+                dst[dstIndex + y] = src[srcIndex];
+                srcIndex += srcStride;
+            }
         }
     }
 }
@@ -557,13 +775,16 @@ static void rotate270_rgb888(const uint8_t * src, uint8_t * dst, int32_t srcWidt
         return ;
     }
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            int32_t srcIndex = y * srcStride + x * 3;
-            int32_t dstIndex = (srcWidth - x - 1) * dstStride + y * 3;
-            dst[dstIndex] = src[srcIndex];       /*Red*/
-            dst[dstIndex + 1] = src[srcIndex + 1]; /*Green*/
-            dst[dstIndex + 2] = src[srcIndex + 2]; /*Blue*/
+    for(int32_t tileY = 0; tileY < srcHeight; tileY += ROTATE_TILE_SIZE) {
+        int32_t yEnd = LV_MIN(tileY + ROTATE_TILE_SIZE, srcHeight);
+        for(int32_t x = 0; x < srcWidth; ++x) {
+            for(int32_t y = tileY; y < yEnd; ++y) {
+                int32_t srcIndex = y * srcStride + x * 3;
+                int32_t dstIndex = (srcWidth - x - 1) * dstStride + y * 3;
+                dst[dstIndex] = src[srcIndex];       /*Red*/
+                dst[dstIndex + 1] = src[srcIndex + 1]; /*Green*/
+                dst[dstIndex + 2] = src[srcIndex + 2]; /*Blue*/
+            }
         }
     }
 }
@@ -571,7 +792,7 @@ static void rotate270_rgb888(const uint8_t * src, uint8_t * dst, int32_t srcWidt
 static void rotate180_rgb888(const uint8_t * src, uint8_t * dst, int32_t width, int32_t height, int32_t src_stride,
                              int32_t dest_stride)
 {
-    if(LV_RESULT_OK == LV_DRAW_SW_ROTATE180_RGB888(src, dst, srcWidth, srcHeight, srcStride, dstStride)) {
+    if(LV_RESULT_OK == LV_DRAW_SW_ROTATE180_RGB888(src, dst, width, height, src_stride, dest_stride)) {
         return ;
     }
 
@@ -589,46 +810,62 @@ static void rotate180_rgb888(const uint8_t * src, uint8_t * dst, int32_t width,
 static void rotate90_rgb888(const uint8_t * src, uint8_t * dst, int32_t width, int32_t height, int32_t srcStride,
                             int32_t dstStride)
 {
-    if(LV_RESULT_OK == LV_DRAW_SW_ROTATE270_RGB888(src, dst, srcWidth, srcHeight, srcStride, dstStride)) {
+    if(LV_RESULT_OK == LV_DRAW_SW_ROTATE270_RGB888(src, dst, width, height, srcStride, dstStride)) {
         return ;
     }
 
-    for(int32_t x = 0; x < width; ++x) {
-        for(int32_t y = 0; y < height; ++y) {
-            int32_t srcIndex = y * srcStride + x * 3;
-            int32_t dstIndex = x * dstStride + (height - y - 1) * 3;
-            dst[dstIndex] = src[srcIndex];       /*Red*/
-            dst[dstIndex + 1] = src[srcIndex + 1]; /*Green*/
-            dst[dstIndex + 2] = src[srcIndex + 2]; /*Blue*/
+    for(int32_t tileY = 0; tileY < height; tileY += ROTATE_TILE_SIZE) {
+        int32_t yEnd = LV_MIN(tileY + ROTATE_TILE_SIZE, height);
+        for(int32_t x = 0; x < width; ++x) {
+            for(int32_t y = tileY; y < yEnd; ++y) {
+                int32_t srcIndex = y * srcStride + x * 3;
+                int32_t dstIndex = x * dstStride + (height - y - 1) * 3;
+                dst[dstIndex] = src[srcIndex];       /*Red*/
+                dst[dstIndex + 1] = src[srcIndex + 1]; /*Green*/
+                dst[dstIndex + 2] = src[srcIndex + 2]; /*Blue*/
+            }
         }
     }
 }
 
 static void rotate270_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWidth, int32_t srcHeight,
                              int32_t srcStride,
-                             int32_t dstStride)
+                             int32_t dstStride, bool swap)
 {
-    if(LV_RESULT_OK == LV_DRAW_SW_ROTATE90_RGB565(src, dst, srcWidth, srcHeight, srcStride, dstStride)) {
+    if(swap) {
+        if(LV_RESULT_OK == LV_DRAW_SW_ROTATE90_RGB565_SWAP(src, dst, srcWidth, srcHeight, srcStride, dstStride)) {
+            return ;
+        }
+    }
+    else if(LV_RESULT_OK == LV_DRAW_SW_ROTATE90_RGB565(src, dst, srcWidth, srcHeight, srcStride, dstStride)) {
         return ;
     }
 
     srcStride /= sizeof(uint16_t);
     dstStride /= sizeof(uint16_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = x * dstStride;
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex + (srcHeight - y - 1)] = src[srcIndex];
-            srcIndex += srcStride;
+    for(int32_t tileY = 0; tileY < srcHeight; tileY += ROTATE_TILE_SIZE) {
+        int32_t yEnd = LV_MIN(tileY + ROTATE_TILE_SIZE, srcHeight);
+        for(int32_t x = 0; x < srcWidth; ++x) {
+            int32_t dstIndex = x * dstStride;
+            int32_t srcIndex = tileY * srcStride + x;
+            for(int32_t y = tileY; y < yEnd; ++y) {
+                dst[dstIndex + (srcHeight - y - 1)] = swap ? swap_rgb565(src[srcIndex]) : src[srcIndex];
+                srcIndex += srcStride;
+            }
         }
     }
 }
 
 static void rotate180_rgb565(const uint16_t * src, uint16_t * dst, int32_t width, int32_t height, int32_t src_stride,
-                             int32_t dest_stride)
+                             int32_t dest_stride, bool swap)
 {
-    if(LV_RESULT_OK == LV_DRAW_SW_ROTATE180_RGB565(src, dst, srcWidth, srcHeight, srcStride, dstStride)) {
+    if(swap) {
+        if(LV_RESULT_OK == LV_DRAW_SW_ROTATE180_RGB565_SWAP(src, dst, width, height, src_stride, dest_stride)) {
+            return ;
+        }
+    }
+    else if(LV_RESULT_OK == LV_DRAW_SW_ROTATE180_RGB565(src, dst, width, height, src_stride, dest_stride)) {
         return ;
     }
 
@@ -639,30 +876,43 @@ static void rotate180_rgb565(const uint16_t * src, uint16_t * dst, int32_t width
         int32_t dstIndex = (height - y - 1) * dest_stride;
         int32_t srcIndex = y * src_stride;
         for(int32_t x = 0; x < width; ++x) {
-            dst[dstIndex + width - x - 1] = src[srcIndex + x];
+            dst[dstIndex + width - x - 1] = swap ? swap_rgb565(src[srcIndex + x]) : src[srcIndex + x];
         }
     }
 }
 
 static void rotate90_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWidth, int32_t srcHeight,
                             int32_t srcStride,
-                            int32_t dstStride)
+                            int32_t dstStride, bool swap)
 {
-    if(LV_RESULT_OK == LV_DRAW_SW_ROTATE270_RGB565(src, dst, srcWidth, srcHeight, srcStride, dstStride)) {
+    if(swap) {
+        if(LV_RESULT_OK == LV_DRAW_SW_ROTATE270_RGB565_SWAP(src, dst, srcWidth, srcHeight, srcStride, dstStride)) {
+            return ;
+        }
+    }
+    else if(LV_RESULT_OK == LV_DRAW_SW_ROTATE270_RGB565(src, dst, srcWidth, srcHeight, srcStride, dstStride)) {
         return ;
     }
 
     srcStride /= sizeof(uint16_t);
     dstStride /= sizeof(uint16_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = (srcWidth - x - 1);
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex * dstStride + y] = src[srcIndex];
-            srcIndex += srcStride;
+    for(int32_t tileY = 0; tileY < srcHeight; tileY += ROTATE_TILE_SIZE) {
+        int32_t yEnd = LV_MIN(tileY + ROTATE_TILE_SIZE, srcHeight);
+        for(int32_t x = 0; x < srcWidth; ++x) {
+            int32_t dstIndex = (srcWidth - x - 1) * dstStride;
+            int32_t srcIndex = tileY * srcStride + x;
+            for(int32_t y = tileY; y < yEnd; ++y) {
+                dst[dstIndex + y] = swap ? swap_rgb565(src[srcIndex]) : src[srcIndex];
+                srcIndex += srcStride;
+            }
         }
     }
 }
 
+static inline uint16_t swap_rgb565(uint16_t px)
+{
+    return (uint16_t)((px << 8) | (px >> 8));
+}
+
 #endif /*LV_USE_DRAW_SW*/
@@ -31,7 +31,24 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_OS
+/**
+ * A large draw task split into horizontal bands.
+ * The bands are taken one-by-one by the draw units working on the task.
+ */
 typedef struct {
+    lv_draw_task_t * task;          /**< The split draw task or NULL if there is no job*/
+    lv_layer_t * layer;             /**< The layer of the draw task*/
+    lv_area_t area;                 /**< The area to render, i.e. the real area of the task clipped*/
+    int32_t band_h;                 /**< Height of the bands*/
+    uint32_t band_cnt;              /**< Number of bands*/
+    uint32_t band_next;             /**< Index of the next band to render*/
+    uint32_t band_ready_cnt;        /**< Number of already rendered bands*/
+    lv_mutex_t mutex;
+} lv_draw_sw_band_job_t;
+#endif
+
+typedef struct _lv_draw_sw_unit_t {
     lv_draw_unit_t base_unit;
     lv_draw_task_t * task_act;
 #if LV_USE_OS
@@ -39,6 +56,15 @@ typedef struct {
     lv_thread_t thread;
     volatile bool inited;
     volatile bool exit_status;
+
+    /** The split draw task started by this unit*/
+    lv_draw_sw_band_job_t band_job;
+
+    /** The unit whose `band_job` is being rendered by this unit or NULL*/
+    struct _lv_draw_sw_unit_t * band_job_owner;
+
+    /** The area of the band being rendered. `base_unit.clip_area` points here while rendering a band*/
+    lv_area_t band_clip_area;
 #endif
     uint32_t idx;
 } lv_draw_sw_unit_t;
@@ -193,6 +219,20 @@ void lv_draw_sw_rgb565_swap(void * buf, uint32_t buf_size_px);
 void lv_draw_sw_rotate(const void * src, void * dest, int32_t src_width, int32_t src_height, int32_t src_sride,
                        int32_t dest_stride, lv_display_rotation_t rotation, lv_color_format_t color_format);
 
+/**
+ * Rotate an RGB565 buffer into an other buffer and swap the upper and lower byte of the pixels in the same pass.
+ * It's faster than calling `lv_draw_sw_rotate` and `lv_draw_sw_rgb565_swap` one after the other.
+ * @param src           the source buffer
+ * @param dest          the destination buffer
+ * @param src_width     source width in pixels
+ * @param src_height    source height in pixels
+ * @param src_stride    source stride in bytes (number of bytes in a row)
+ * @param dest_stride   destination stride in bytes (number of bytes in a row)
+ * @param rotation      LV_DISPLAY_ROTATION_0/90/180/270
+ */
+void lv_draw_sw_rgb565_rotate_swap(const void * src, void * dest, int32_t src_width, int32_t src_height,
+                                   int32_t src_stride, int32_t dest_stride, lv_display_rotation_t rotation);
+
 /***********************
  * GLOBAL VARIABLES
  ***********************/
@@ -0,0 +1,344 @@
+/**
+ * @file lv_draw_sw_neon.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_neon.h"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && defined(__ARM_NEON)
+
+#include "../../../misc/lv_math.h"
+#include <arm_neon.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Rotate the image in tiles which fit into the L1 cache with both their source and destination*/
+#define TILE_SIZE       32
+
+/*Size of the blocks transposed in registers*/
+#define BLOCK_SIZE_32   4
+#define BLOCK_SIZE_16   8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void rotate_32(const uint8_t * src, uint8_t * dst, int32_t w, int32_t h, int32_t src_stride,
+                      int32_t dst_stride, bool cw);
+static void rotate_16(const uint8_t * src, uint8_t * dst, int32_t w, int32_t h, int32_t src_stride,
+                      int32_t dst_stride, bool cw, bool swap);
+static inline void rotate_px_32(const uint8_t * src, uint8_t * dst, int32_t x1, int32_t x2, int32_t y1, int32_t y2,
+                                int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw);
+static inline void rotate_px_16(const uint8_t * src, uint8_t * dst, int32_t x1, int32_t x2, int32_t y1, int32_t y2,
+                                int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw, bool swap);
+static inline void transpose_block_32(const uint8_t * src, uint8_t * dst, int32_t x, int32_t y,
+                                      int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw);
+static inline void transpose_block_16(const uint8_t * src, uint8_t * dst, int32_t x, int32_t y,
+                                      int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw, bool swap);
+static inline uint16x8_t combine_low_32(uint32x4_t a, uint32x4_t b);
+static inline uint16x8_t combine_high_32(uint32x4_t a, uint32x4_t b);
+static inline uint16x8_t swap_16(uint16x8_t v);
+static inline uint16_t swap_px_16(uint16_t px);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t _lv_draw_sw_rgb565_swap_neon(void * buf, uint32_t buf_size_px)
+{
+    uint16_t * buf16 = buf;
+    uint32_t i = 0;
+
+    for(; i + 16 <= buf_size_px; i += 16) {
+        uint8x16_t v0 = vld1q_u8((const uint8_t *)&buf16[i]);
+        uint8x16_t v1 = vld1q_u8((const uint8_t *)&buf16[i + 8]);
+        vst1q_u8((uint8_t *)&buf16[i], vrev16q_u8(v0));
+        vst1q_u8((uint8_t *)&buf16[i + 8], vrev16q_u8(v1));
+    }
+
+    for(; i < buf_size_px; i++) {
+        buf16[i] = swap_px_16(buf16[i]);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate90_argb8888_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                               int32_t src_stride, int32_t dst_stride)
+{
+    rotate_32(src, dst, src_width, src_height, src_stride, dst_stride, true);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate180_argb8888_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                                int32_t src_stride, int32_t dst_stride)
+{
+    int32_t y;
+    for(y = 0; y < src_height; y++) {
+        const uint32_t * src32 = (const uint32_t *)((const uint8_t *)src + y * src_stride);
+        uint32_t * dst32 = (uint32_t *)((uint8_t *)dst + (src_height - y - 1) * dst_stride);
+        int32_t x = 0;
+        for(; x + 4 <= src_width; x += 4) {
+            uint32x4_t v = vrev64q_u32(vld1q_u32(&src32[x]));
+            vst1q_u32(&dst32[src_width - x - 4], vextq_u32(v, v, 2));
+        }
+        for(; x < src_width; x++) {
+            dst32[src_width - x - 1] = src32[x];
+        }
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate270_argb8888_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                                int32_t src_stride, int32_t dst_stride)
+{
+    rotate_32(src, dst, src_width, src_height, src_stride, dst_stride, false);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate90_rgb565_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                             int32_t src_stride, int32_t dst_stride, bool swap)
+{
+    rotate_16(src, dst, src_width, src_height, src_stride, dst_stride, true, swap);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate180_rgb565_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                              int32_t src_stride, int32_t dst_stride, bool swap)
+{
+    int32_t y;
+    for(y = 0; y < src_height; y++) {
+        const uint16_t * src16 = (const uint16_t *)((const uint8_t *)src + y * src_stride);
+        uint16_t * dst16 = (uint16_t *)((uint8_t *)dst + (src_height - y - 1) * dst_stride);
+        int32_t x = 0;
+        for(; x + 8 <= src_width; x += 8) {
+            uint16x8_t v = vrev64q_u16(vld1q_u16(&src16[x]));
+            v = vextq_u16(v, v, 4);
+            if(swap) v = swap_16(v);
+            vst1q_u16(&dst16[src_width - x - 8], v);
+        }
+        for(; x < src_width; x++) {
+            dst16[src_width - x - 1] = swap ? swap_px_16(src16[x]) : src16[x];
+        }
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate270_rgb565_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                              int32_t src_stride, int32_t dst_stride, bool swap)
+{
+    rotate_16(src, dst, src_width, src_height, src_stride, dst_stride, false, swap);
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Rotate by 90 degrees clockwise (`cw == true`) or counter-clockwise.
+ * The image is processed in tiles and the tiles in blocks transposed in registers.
+ */
+static void rotate_32(const uint8_t * src, uint8_t * dst, int32_t w, int32_t h, int32_t src_stride,
+                      int32_t dst_stride, bool cw)
+{
+    int32_t tile_y;
+    int32_t tile_x;
+    for(tile_y = 0; tile_y < h; tile_y += TILE_SIZE) {
+        int32_t y_end = LV_MIN(tile_y + TILE_SIZE, h);
+        for(tile_x = 0; tile_x < w; tile_x += TILE_SIZE) {
+            int32_t x_end = LV_MIN(tile_x + TILE_SIZE, w);
+            int32_t y = tile_y;
+            for(; y + BLOCK_SIZE_32 <= y_end; y += BLOCK_SIZE_32) {
+                int32_t x = tile_x;
+                for(; x + BLOCK_SIZE_32 <= x_end; x += BLOCK_SIZE_32) {
+                    transpose_block_32(src, dst, x, y, w, h, src_stride, dst_stride, cw);
+                }
+                rotate_px_32(src, dst, x, x_end, y, y + BLOCK_SIZE_32, w, h, src_stride, dst_stride, cw);
+            }
+            rotate_px_32(src, dst, tile_x, x_end, y, y_end, w, h, src_stride, dst_stride, cw);
+        }
+    }
+}
+
+static void rotate_16(const uint8_t * src, uint8_t * dst, int32_t w, int32_t h, int32_t src_stride,
+                      int32_t dst_stride, bool cw, bool swap)
+{
+    int32_t tile_y;
+    int32_t tile_x;
+    for(tile_y = 0; tile_y < h; tile_y += TILE_SIZE) {
+        int32_t y_end = LV_MIN(tile_y + TILE_SIZE, h);
+        for(tile_x = 0; tile_x < w; tile_x += TILE_SIZE) {
+            int32_t x_end = LV_MIN(tile_x + TILE_SIZE, w);
+            int32_t y = tile_y;
+            for(; y + BLOCK_SIZE_16 <= y_end; y += BLOCK_SIZE_16) {
+                int32_t x = tile_x;
+                for(; x + BLOCK_SIZE_16 <= x_end; x += BLOCK_SIZE_16) {
+                    transpose_block_16(src, dst, x, y, w, h, src_stride, dst_stride, cw, swap);
+                }
+                rotate_px_16(src, dst, x, x_end, y, y + BLOCK_SIZE_16, w, h, src_stride, dst_stride, cw, swap);
+            }
+            rotate_px_16(src, dst, tile_x, x_end, y, y_end, w, h, src_stride, dst_stride, cw, swap);
+        }
+    }
+}
+
+/**
+ * Rotate the pixels of the [x1, x2) x [y1, y2) area one by one
+ */
+static inline void rotate_px_32(const uint8_t * src, uint8_t * dst, int32_t x1, int32_t x2, int32_t y1, int32_t y2,
+                                int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw)
+{
+    int32_t x;
+    int32_t y;
+    for(y = y1; y < y2; y++) {
+        const uint32_t * src32 = (const uint32_t *)(src + y * src_stride);
+        for(x = x1; x < x2; x++) {
+            uint32_t * dst32 = cw ? (uint32_t *)(dst + x * dst_stride) + (h - y - 1) :
+                               (uint32_t *)(dst + (w - x - 1) * dst_stride) + y;
+            *dst32 = src32[x];
+        }
+    }
+}
+
+static inline void rotate_px_16(const uint8_t * src, uint8_t * dst, int32_t x1, int32_t x2, int32_t y1, int32_t y2,
+                                int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw, bool swap)
+{
+    int32_t x;
+    int32_t y;
+    for(y = y1; y < y2; y++) {
+        const uint16_t * src16 = (const uint16_t *)(src + y * src_stride);
+        for(x = x1; x < x2; x++) {
+            uint16_t * dst16 = cw ? (uint16_t *)(dst + x * dst_stride) + (h - y - 1) :
+                               (uint16_t *)(dst + (w - x - 1) * dst_stride) + y;
+            *dst16 = swap ? swap_px_16(src16[x]) : src16[x];
+        }
+    }
+}
+
+/**
+ * Transpose a block of 32 bit pixels starting at `x;y`. The columns of the source become the rows of
+ * the destination. The source rows are loaded in reverse order for clockwise rotation.
+ */
+static inline void transpose_block_32(const uint8_t * src, uint8_t * dst, int32_t x, int32_t y,
+                                      int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw)
+{
+    const uint8_t * src_px = src + y * src_stride + x * 4;
+    uint32x4_t r[BLOCK_SIZE_32];
+    int32_t i;
+    for(i = 0; i < BLOCK_SIZE_32; i++) {
+        r[i] = vld1q_u32((const uint32_t *)(src_px + (cw ? BLOCK_SIZE_32 - 1 - i : i) * src_stride));
+    }
+
+    /*Column `i` of the block goes to the row `dst_row + i * dst_row_step`*/
+    uint8_t * dst_row;
+    int32_t dst_row_step;
+    if(cw) {
+        dst_row = dst + x * dst_stride + (h - y - BLOCK_SIZE_32) * 4;
+        dst_row_step = dst_stride;
+    }
+    else {
+        dst_row = dst + (w - x - 1) * dst_stride + y * 4;
+        dst_row_step = -dst_stride;
+    }
+
+    uint32x4x2_t t01 = vtrnq_u32(r[0], r[1]);
+    uint32x4x2_t t23 = vtrnq_u32(r[2], r[3]);
+
+    vst1q_u32((uint32_t *)(dst_row + 0 * dst_row_step),
+              vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0])));
+    vst1q_u32((uint32_t *)(dst_row + 1 * dst_row_step),
+              vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1])));
+    vst1q_u32((uint32_t *)(dst_row + 2 * dst_row_step),
+              vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])));
+    vst1q_u32((uint32_t *)(dst_row + 3 * dst_row_step),
+              vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1])));
+}
+
+static inline void transpose_block_16(const uint8_t * src, uint8_t * dst, int32_t x, int32_t y,
+                                      int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw, bool swap)
+{
+    const uint8_t * src_px = src + y * src_stride + x * 2;
+    uint16x8_t r[BLOCK_SIZE_16];
+    int32_t i;
+    for(i = 0; i < BLOCK_SIZE_16; i++) {
+        r[i] = vld1q_u16((const uint16_t *)(src_px + (cw ? BLOCK_SIZE_16 - 1 - i : i) * src_stride));
+    }
+
+    uint8_t * dst_row;
+    int32_t dst_row_step;
+    if(cw) {
+        dst_row = dst + x * dst_stride + (h - y - BLOCK_SIZE_16) * 2;
+        dst_row_step = dst_stride;
+    }
+    else {
+        dst_row = dst + (w - x - 1) * dst_stride + y * 2;
+        dst_row_step = -dst_stride;
+    }
+
+    /*Transpose the 2x2 blocks of pixels, then the 2x2 blocks of pixel pairs, then swap the 4x4 blocks*/
+    uint16x8x2_t t01 = vtrnq_u16(r[0], r[1]);
+    uint16x8x2_t t23 = vtrnq_u16(r[2], r[3]);
+    uint16x8x2_t t45 = vtrnq_u16(r[4], r[5]);
+    uint16x8x2_t t67 = vtrnq_u16(r[6], r[7]);
+
+    uint32x4x2_t u0 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]), vreinterpretq_u32_u16(t23.val[0]));
+    uint32x4x2_t u1 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]), vreinterpretq_u32_u16(t23.val[1]));
+    uint32x4x2_t u2 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]), vreinterpretq_u32_u16(t67.val[0]));
+    uint32x4x2_t u3 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]), vreinterpretq_u32_u16(t67.val[1]));
+
+    uint16x8_t c[BLOCK_SIZE_16];
+    c[0] = combine_low_32(u0.val[0], u2.val[0]);
+    c[1] = combine_low_32(u1.val[0], u3.val[0]);
+    c[2] = combine_low_32(u0.val[1], u2.val[1]);
+    c[3] = combine_low_32(u1.val[1], u3.val[1]);
+    c[4] = combine_high_32(u0.val[0], u2.val[0]);
+    c[5] = combine_high_32(u1.val[0], u3.val[0]);
+    c[6] = combine_high_32(u0.val[1], u2.val[1]);
+    c[7] = combine_high_32(u1.val[1], u3.val[1]);
+
+    for(i = 0; i < BLOCK_SIZE_16; i++) {
+        vst1q_u16((uint16_t *)(dst_row + i * dst_row_step), swap ? swap_16(c[i]) : c[i]);
+    }
+}
+
+static inline uint16x8_t combine_low_32(uint32x4_t a, uint32x4_t b)
+{
+    return vreinterpretq_u16_u32(vcombine_u32(vget_low_u32(a), vget_low_u32(b)));
+}
+
+static inline uint16x8_t combine_high_32(uint32x4_t a, uint32x4_t b)
+{
+    return vreinterpretq_u16_u32(vcombine_u32(vget_high_u32(a), vget_high_u32(b)));
+}
+
+static inline uint16x8_t swap_16(uint16x8_t v)
+{
+    return vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(v)));
+}
+
+static inline uint16_t swap_px_16(uint16_t px)
+{
+    return (uint16_t)((px << 8) | (px >> 8));
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && defined(__ARM_NEON)*/
@@ -0,0 +1,113 @@
+/**
+ * @file lv_draw_sw_neon.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_NEON_H
+#define LV_DRAW_SW_NEON_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../../../lv_conf_internal.h"
+
+/* Use NEON if the compiler targets it */
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && defined(__ARM_NEON)
+
+#include "../../../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#ifndef LV_DRAW_SW_RGB565_SWAP
+#define LV_DRAW_SW_RGB565_SWAP(buf, buf_size_px) \
+    _lv_draw_sw_rgb565_swap_neon(buf, buf_size_px)
+#endif
+
+#ifndef LV_DRAW_SW_ROTATE90_ARGB8888
+#define LV_DRAW_SW_ROTATE90_ARGB8888(src, dst, src_width, src_height, src_stride, dst_stride) \
+    _lv_draw_sw_rotate90_argb8888_neon(src, dst, src_width, src_height, src_stride, dst_stride)
+#endif
+
+#ifndef LV_DRAW_SW_ROTATE180_ARGB8888
+#define LV_DRAW_SW_ROTATE180_ARGB8888(src, dst, src_width, src_height, src_stride, dst_stride) \
+    _lv_draw_sw_rotate180_argb8888_neon(src, dst, src_width, src_height, src_stride, dst_stride)
+#endif
+
+#ifndef LV_DRAW_SW_ROTATE270_ARGB8888
+#define LV_DRAW_SW_ROTATE270_ARGB8888(src, dst, src_width, src_height, src_stride, dst_stride) \
+    _lv_draw_sw_rotate270_argb8888_neon(src, dst, src_width, src_height, src_stride, dst_stride)
+#endif
+
+#ifndef LV_DRAW_SW_ROTATE90_RGB565
+#define LV_DRAW_SW_ROTATE90_RGB565(src, dst, src_width, src_height, src_stride, dst_stride) \
+    _lv_draw_sw_rotate90_rgb565_neon(src, dst, src_width, src_height, src_stride, dst_stride, false)
+#endif
+
+#ifndef LV_DRAW_SW_ROTATE180_RGB565
+#define LV_DRAW_SW_ROTATE180_RGB565(src, dst, src_width, src_height, src_stride, dst_stride) \
+    _lv_draw_sw_rotate180_rgb565_neon(src, dst, src_width, src_height, src_stride, dst_stride, false)
+#endif
+
+#ifndef LV_DRAW_SW_ROTATE270_RGB565
+#define LV_DRAW_SW_ROTATE270_RGB565(src, dst, src_width, src_height, src_stride, dst_stride) \
+    _lv_draw_sw_rotate270_rgb565_neon(src, dst, src_width, src_height, src_stride, dst_stride, false)
+#endif
+
+#ifndef LV_DRAW_SW_ROTATE90_RGB565_SWAP
+#define LV_DRAW_SW_ROTATE90_RGB565_SWAP(src, dst, src_width, src_height, src_stride, dst_stride) \
+    _lv_draw_sw_rotate90_rgb565_neon(src, dst, src_width, src_height, src_stride, dst_stride, true)
+#endif
+
+#ifndef LV_DRAW_SW_ROTATE180_RGB565_SWAP
+#define LV_DRAW_SW_ROTATE180_RGB565_SWAP(src, dst, src_width, src_height, src_stride, dst_stride) \
+    _lv_draw_sw_rotate180_rgb565_neon(src, dst, src_width, src_height, src_stride, dst_stride, true)
+#endif
+
+#ifndef LV_DRAW_SW_ROTATE270_RGB565_SWAP
+#define LV_DRAW_SW_ROTATE270_RGB565_SWAP(src, dst, src_width, src_height, src_stride, dst_stride) \
+    _lv_draw_sw_rotate270_rgb565_neon(src, dst, src_width, src_height, src_stride, dst_stride, true)
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+lv_result_t _lv_draw_sw_rgb565_swap_neon(void * buf, uint32_t buf_size_px);
+
+/* The rotations are clockwise like in the name of the hooks */
+lv_result_t _lv_draw_sw_rotate90_argb8888_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                              int32_t src_stride, int32_t dst_stride);
+
+lv_result_t _lv_draw_sw_rotate180_argb8888_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                               int32_t src_stride, int32_t dst_stride);
+
+lv_result_t _lv_draw_sw_rotate270_argb8888_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                               int32_t src_stride, int32_t dst_stride);
+
+lv_result_t _lv_draw_sw_rotate90_rgb565_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                            int32_t src_stride, int32_t dst_stride, bool swap);
+
+lv_result_t _lv_draw_sw_rotate180_rgb565_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                             int32_t src_stride, int32_t dst_stride, bool swap);
+
+lv_result_t _lv_draw_sw_rotate270_rgb565_neon(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                             int32_t src_stride, int32_t dst_stride, bool swap);
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_NEON && defined(__ARM_NEON)*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_NEON_H*/
@@ -0,0 +1,423 @@
+/**
+ * @file lv_draw_sw_x86.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_x86.h"
+
+#if LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && defined(__SSE2__)
+
+#include "../../../misc/lv_math.h"
+#include <emmintrin.h>
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Rotate the image in tiles which fit into the L1 cache with both their source and destination*/
+#define TILE_SIZE       32
+
+/*Size of the blocks transposed in registers*/
+#if defined(__AVX2__)
+    #define BLOCK_SIZE_32   8
+#else
+    #define BLOCK_SIZE_32   4
+#endif
+#define BLOCK_SIZE_16   8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void rotate_32(const uint8_t * src, uint8_t * dst, int32_t w, int32_t h, int32_t src_stride,
+                      int32_t dst_stride, bool cw);
+static void rotate_16(const uint8_t * src, uint8_t * dst, int32_t w, int32_t h, int32_t src_stride,
+                      int32_t dst_stride, bool cw, bool swap);
+static inline void rotate_px_32(const uint8_t * src, uint8_t * dst, int32_t x1, int32_t x2, int32_t y1, int32_t y2,
+                                int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw);
+static inline void rotate_px_16(const uint8_t * src, uint8_t * dst, int32_t x1, int32_t x2, int32_t y1, int32_t y2,
+                                int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw, bool swap);
+static inline void transpose_block_32(const uint8_t * src, uint8_t * dst, int32_t x, int32_t y,
+                                      int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw);
+static inline void transpose_block_16(const uint8_t * src, uint8_t * dst, int32_t x, int32_t y,
+                                      int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw, bool swap);
+static inline __m128i swap_16(__m128i v);
+static inline uint16_t swap_px_16(uint16_t px);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t _lv_draw_sw_rgb565_swap_x86(void * buf, uint32_t buf_size_px)
+{
+    uint16_t * buf16 = buf;
+    uint32_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i swap_mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                               1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for(; i + 16 <= buf_size_px; i += 16) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)&buf16[i]);
+        _mm256_storeu_si256((__m256i *)&buf16[i], _mm256_shuffle_epi8(v, swap_mask));
+    }
+#endif
+
+    for(; i + 8 <= buf_size_px; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)&buf16[i]);
+        _mm_storeu_si128((__m128i *)&buf16[i], swap_16(v));
+    }
+
+    for(; i < buf_size_px; i++) {
+        buf16[i] = swap_px_16(buf16[i]);
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate90_argb8888_x86(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                              int32_t src_stride, int32_t dst_stride)
+{
+    rotate_32(src, dst, src_width, src_height, src_stride, dst_stride, true);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate180_argb8888_x86(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                               int32_t src_stride, int32_t dst_stride)
+{
+#if defined(__AVX2__)
+    const __m256i reverse_idx = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+#endif
+
+    int32_t y;
+    for(y = 0; y < src_height; y++) {
+        const uint32_t * src32 = (const uint32_t *)((const uint8_t *)src + y * src_stride);
+        uint32_t * dst32 = (uint32_t *)((uint8_t *)dst + (src_height - y - 1) * dst_stride);
+        int32_t x = 0;
+#if defined(__AVX2__)
+        for(; x + 8 <= src_width; x += 8) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)&src32[x]);
+            _mm256_storeu_si256((__m256i *)&dst32[src_width - x - 8], _mm256_permutevar8x32_epi32(v, reverse_idx));
+        }
+#endif
+        for(; x + 4 <= src_width; x += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i *)&src32[x]);
+            _mm_storeu_si128((__m128i *)&dst32[src_width - x - 4], _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+        for(; x < src_width; x++) {
+            dst32[src_width - x - 1] = src32[x];
+        }
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate270_argb8888_x86(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                               int32_t src_stride, int32_t dst_stride)
+{
+    rotate_32(src, dst, src_width, src_height, src_stride, dst_stride, false);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate90_rgb565_x86(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                            int32_t src_stride, int32_t dst_stride, bool swap)
+{
+    rotate_16(src, dst, src_width, src_height, src_stride, dst_stride, true, swap);
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate180_rgb565_x86(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                             int32_t src_stride, int32_t dst_stride, bool swap)
+{
+#if defined(__AVX2__)
+    /*Reverse the pixels in the 128 bit lanes. Reversing all bytes also swaps the bytes of the pixels.*/
+    const __m256i reverse_mask = swap ?
+                                 _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                                  15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0) :
+                                 _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                                                  14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+#endif
+
+    int32_t y;
+    for(y = 0; y < src_height; y++) {
+        const uint16_t * src16 = (const uint16_t *)((const uint8_t *)src + y * src_stride);
+        uint16_t * dst16 = (uint16_t *)((uint8_t *)dst + (src_height - y - 1) * dst_stride);
+        int32_t x = 0;
+#if defined(__AVX2__)
+        for(; x + 16 <= src_width; x += 16) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)&src16[x]);
+            v = _mm256_shuffle_epi8(v, reverse_mask);
+            v = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2));
+            _mm256_storeu_si256((__m256i *)&dst16[src_width - x - 16], v);
+        }
+#endif
+        for(; x + 8 <= src_width; x += 8) {
+            __m128i v = _mm_loadu_si128((const __m128i *)&src16[x]);
+            v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+            v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+            v = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+            if(swap) v = swap_16(v);
+            _mm_storeu_si128((__m128i *)&dst16[src_width - x - 8], v);
+        }
+        for(; x < src_width; x++) {
+            dst16[src_width - x - 1] = swap ? swap_px_16(src16[x]) : src16[x];
+        }
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t _lv_draw_sw_rotate270_rgb565_x86(const void * src, void * dst, int32_t src_width, int32_t src_height,
+                                             int32_t src_stride, int32_t dst_stride, bool swap)
+{
+    rotate_16(src, dst, src_width, src_height, src_stride, dst_stride, false, swap);
+    return LV_RESULT_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Rotate by 90 degrees clockwise (`cw == true`) or counter-clockwise.
+ * The image is processed in tiles and the tiles in blocks transposed in registers.
+ */
+static void rotate_32(const uint8_t * src, uint8_t * dst, int32_t w, int32_t h, int32_t src_stride,
+                      int32_t dst_stride, bool cw)
+{
+    int32_t tile_y;
+    int32_t tile_x;
+    for(tile_y = 0; tile_y < h; tile_y += TILE_SIZE) {
+        int32_t y_end = LV_MIN(tile_y + TILE_SIZE, h);
+        for(tile_x = 0; tile_x < w; tile_x += TILE_SIZE) {
+            int32_t x_end = LV_MIN(tile_x + TILE_SIZE, w);
+            int32_t y = tile_y;
+            for(; y + BLOCK_SIZE_32 <= y_end; y += BLOCK_SIZE_32) {
+                int32_t x = tile_x;
+                for(; x + BLOCK_SIZE_32 <= x_end; x += BLOCK_SIZE_32) {
+                    transpose_block_32(src, dst, x, y, w, h, src_stride, dst_stride, cw);
+                }
+                rotate_px_32(src, dst, x, x_end, y, y + BLOCK_SIZE_32, w, h, src_stride, dst_stride, cw);
+            }
+            rotate_px_32(src, dst, tile_x, x_end, y, y_end, w, h, src_stride, dst_stride, cw);
+        }
+    }
+}
+
+static void rotate_16(const uint8_t * src, uint8_t * dst, int32_t w, int32_t h, int32_t src_stride,
+                      int32_t dst_stride, bool cw, bool swap)
+{
+    int32_t tile_y;
+    int32_t tile_x;
+    for(tile_y = 0; tile_y < h; tile_y += TILE_SIZE) {
+        int32_t y_end = LV_MIN(tile_y + TILE_SIZE, h);
+        for(tile_x = 0; tile_x < w; tile_x += TILE_SIZE) {
+            int32_t x_end = LV_MIN(tile_x + TILE_SIZE, w);
+            int32_t y = tile_y;
+            for(; y + BLOCK_SIZE_16 <= y_end; y += BLOCK_SIZE_16) {
+                int32_t x = tile_x;
+                for(; x + BLOCK_SIZE_16 <= x_end; x += BLOCK_SIZE_16) {
+                    transpose_block_16(src, dst, x, y, w, h, src_stride, dst_stride, cw, swap);
+                }
+                rotate_px_16(src, dst, x, x_end, y, y + BLOCK_SIZE_16, w, h, src_stride, dst_stride, cw, swap);
+            }
+            rotate_px_16(src, dst, tile_x, x_end, y, y_end, w, h, src_stride, dst_stride, cw, swap);
+        }
+    }
+}
+
+/**
+ * Rotate the pixels of the [x1, x2) x [y1, y2) area one by one
+ */
+static inline void rotate_px_32(const uint8_t * src, uint8_t * dst, int32_t x1, int32_t x2, int32_t y1, int32_t y2,
+                                int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw)
+{
+    int32_t x;
+    int32_t y;
+    for(y = y1; y < y2; y++) {
+        const uint32_t * src32 = (const uint32_t *)(src + y * src_stride);
+        for(x = x1; x < x2; x++) {
+            uint32_t * dst32 = cw ? (uint32_t *)(dst + x * dst_stride) + (h - y - 1) :
+                               (uint32_t *)(dst + (w - x - 1) * dst_stride) + y;
+            *dst32 = src32[x];
+        }
+    }
+}
+
+static inline void rotate_px_16(const uint8_t * src, uint8_t * dst, int32_t x1, int32_t x2, int32_t y1, int32_t y2,
+                                int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw, bool swap)
+{
+    int32_t x;
+    int32_t y;
+    for(y = y1; y < y2; y++) {
+        const uint16_t * src16 = (const uint16_t *)(src + y * src_stride);
+        for(x = x1; x < x2; x++) {
+            uint16_t * dst16 = cw ? (uint16_t *)(dst + x * dst_stride) + (h - y - 1) :
+                               (uint16_t *)(dst + (w - x - 1) * dst_stride) + y;
+            *dst16 = swap ? swap_px_16(src16[x]) : src16[x];
+        }
+    }
+}
+
+/**
+ * Transpose a block of 32 bit pixels starting at `x;y`. The columns of the source become the rows of
+ * the destination. The source rows are loaded in reverse order for clockwise rotation.
+ */
+static inline void transpose_block_32(const uint8_t * src, uint8_t * dst, int32_t x, int32_t y,
+                                      int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw)
+{
+    const uint8_t * src_px = src + y * src_stride + x * 4;
+    const uint8_t * row[BLOCK_SIZE_32];
+    int32_t i;
+    for(i = 0; i < BLOCK_SIZE_32; i++) {
+        row[i] = src_px + (cw ? BLOCK_SIZE_32 - 1 - i : i) * src_stride;
+    }
+
+    /*Column `i` of the block goes to the row `dst_row + i * dst_row_step`*/
+    uint8_t * dst_row;
+    int32_t dst_row_step;
+    if(cw) {
+        dst_row = dst + x * dst_stride + (h - y - BLOCK_SIZE_32) * 4;
+        dst_row_step = dst_stride;
+    }
+    else {
+        dst_row = dst + (w - x - 1) * dst_stride + y * 4;
+        dst_row_step = -dst_stride;
+    }
+
+#if defined(__AVX2__)
+    __m256i r0 = _mm256_loadu_si256((const __m256i *)row[0]);
+    __m256i r1 = _mm256_loadu_si256((const __m256i *)row[1]);
+    __m256i r2 = _mm256_loadu_si256((const __m256i *)row[2]);
+    __m256i r3 = _mm256_loadu_si256((const __m256i *)row[3]);
+    __m256i r4 = _mm256_loadu_si256((const __m256i *)row[4]);
+    __m256i r5 = _mm256_loadu_si256((const __m256i *)row[5]);
+    __m256i r6 = _mm256_loadu_si256((const __m256i *)row[6]);
+    __m256i r7 = _mm256_loadu_si256((const __m256i *)row[7]);
+
+    __m256i t0 = _mm256_unpacklo_epi32(r0, r1);
+    __m256i t1 = _mm256_unpackhi_epi32(r0, r1);
+    __m256i t2 = _mm256_unpacklo_epi32(r2, r3);
+    __m256i t3 = _mm256_unpackhi_epi32(r2, r3);
+    __m256i t4 = _mm256_unpacklo_epi32(r4, r5);
+    __m256i t5 = _mm256_unpackhi_epi32(r4, r5);
+    __m256i t6 = _mm256_unpacklo_epi32(r6, r7);
+    __m256i t7 = _mm256_unpackhi_epi32(r6, r7);
+
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+    _mm256_storeu_si256((__m256i *)(dst_row + 0 * dst_row_step), _mm256_permute2x128_si256(u0, u4, 0x20));
+    _mm256_storeu_si256((__m256i *)(dst_row + 1 * dst_row_step), _mm256_permute2x128_si256(u1, u5, 0x20));
+    _mm256_storeu_si256((__m256i *)(dst_row + 2 * dst_row_step), _mm256_permute2x128_si256(u2, u6, 0x20));
+    _mm256_storeu_si256((__m256i *)(dst_row + 3 * dst_row_step), _mm256_permute2x128_si256(u3, u7, 0x20));
+    _mm256_storeu_si256((__m256i *)(dst_row + 4 * dst_row_step), _mm256_permute2x128_si256(u0, u4, 0x31));
+    _mm256_storeu_si256((__m256i *)(dst_row + 5 * dst_row_step), _mm256_permute2x128_si256(u1, u5, 0x31));
+    _mm256_storeu_si256((__m256i *)(dst_row + 6 * dst_row_step), _mm256_permute2x128_si256(u2, u6, 0x31));
+    _mm256_storeu_si256((__m256i *)(dst_row + 7 * dst_row_step), _mm256_permute2x128_si256(u3, u7, 0x31));
+#else
+    __m128i r0 = _mm_loadu_si128((const __m128i *)row[0]);
+    __m128i r1 = _mm_loadu_si128((const __m128i *)row[1]);
+    __m128i r2 = _mm_loadu_si128((const __m128i *)row[2]);
+    __m128i r3 = _mm_loadu_si128((const __m128i *)row[3]);
+
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    __m128i t1 = _mm_unpackhi_epi32(r0, r1);
+    __m128i t2 = _mm_unpacklo_epi32(r2, r3);
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+
+    _mm_storeu_si128((__m128i *)(dst_row + 0 * dst_row_step), _mm_unpacklo_epi64(t0, t2));
+    _mm_storeu_si128((__m128i *)(dst_row + 1 * dst_row_step), _mm_unpackhi_epi64(t0, t2));
+    _mm_storeu_si128((__m128i *)(dst_row + 2 * dst_row_step), _mm_unpacklo_epi64(t1, t3));
+    _mm_storeu_si128((__m128i *)(dst_row + 3 * dst_row_step), _mm_unpackhi_epi64(t1, t3));
+#endif
+}
+
+static inline void transpose_block_16(const uint8_t * src, uint8_t * dst, int32_t x, int32_t y,
+                                      int32_t w, int32_t h, int32_t src_stride, int32_t dst_stride, bool cw, bool swap)
+{
+    const uint8_t * src_px = src + y * src_stride + x * 2;
+    __m128i r[BLOCK_SIZE_16];
+    int32_t i;
+    for(i = 0; i < BLOCK_SIZE_16; i++) {
+        r[i] = _mm_loadu_si128((const __m128i *)(src_px + (cw ? BLOCK_SIZE_16 - 1 - i : i) * src_stride));
+    }
+
+    uint8_t * dst_row;
+    int32_t dst_row_step;
+    if(cw) {
+        dst_row = dst + x * dst_stride + (h - y - BLOCK_SIZE_16) * 2;
+        dst_row_step = dst_stride;
+    }
+    else {
+        dst_row = dst + (w - x - 1) * dst_stride + y * 2;
+        dst_row_step = -dst_stride;
+    }
+
+    __m128i t0 = _mm_unpacklo_epi16(r[0], r[1]);
+    __m128i t1 = _mm_unpackhi_epi16(r[0], r[1]);
+    __m128i t2 = _mm_unpacklo_epi16(r[2], r[3]);
+    __m128i t3 = _mm_unpackhi_epi16(r[2], r[3]);
+    __m128i t4 = _mm_unpacklo_epi16(r[4], r[5]);
+    __m128i t5 = _mm_unpackhi_epi16(r[4], r[5]);
+    __m128i t6 = _mm_unpacklo_epi16(r[6], r[7]);
+    __m128i t7 = _mm_unpackhi_epi16(r[6], r[7]);
+
+    __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+    __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+    __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+    __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+    __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+    __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+    __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+    __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+
+    __m128i c[BLOCK_SIZE_16];
+    c[0] = _mm_unpacklo_epi64(u0, u4);
+    c[1] = _mm_unpackhi_epi64(u0, u4);
+    c[2] = _mm_unpacklo_epi64(u1, u5);
+    c[3] = _mm_unpackhi_epi64(u1, u5);
+    c[4] = _mm_unpacklo_epi64(u2, u6);
+    c[5] = _mm_unpackhi_epi64(u2, u6);
+    c[6] = _mm_unpacklo_epi64(u3, u7);
+    c[7] = _mm_unpackhi_epi64(u3, u7);
+
+    for(i = 0; i < BLOCK_SIZE_16; i++) {
+        _mm_storeu_si128((__m128i *)(dst_row + i * dst_row_step), swap ? swap_16(c[i]) : c[i]);
+    }
+}
+
+static inline __m128i swap_16(__m128i v)
+{
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+static inline uint16_t swap_px_16(uint16_t px)
+{
+    return (uint16_t)((px << 8) | (px >> 8));
+}
+
+#endif /*LV_USE_DRAW_SW && LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_X86 && defined(__SSE2__)*/
@@ -65,6 +65,11 @@ typedef struct {
     long int screensize;
     int fbfd;
     bool force_refresh;
+    bool page_flip;             /*Render to the pages of the framebuffer and pan between them*/
+    uint8_t * draw_buf;         /*The buffers allocated for the copy mode*/
+    uint8_t * draw_buf_2;
+    lv_draw_buf_t page_buf_1;   /*The pages of the framebuffer in page flip mode*/
+    lv_draw_buf_t page_buf_2;
 } lv_linux_fb_t;
 
 /**********************
@@ -73,6 +78,11 @@ typedef struct {
 
 static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * color_p);
 static uint32_t tick_get_cb(void);
+static void display_release_cb(lv_event_t * e);
+#if LV_LINUX_FBDEV_PAGE_FLIP && !LV_LINUX_FBDEV_BSD
+    static bool page_flip_init(lv_display_t * disp, lv_linux_fb_t * dsc);
+    static void page_flip_flush(lv_linux_fb_t * dsc, uint8_t * color_p);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -113,6 +123,7 @@ lv_display_t * lv_linux_fbdev_create(void)
     }
     dsc->fbfd = -1;
     lv_display_set_driver_data(disp, dsc);
+    lv_display_add_event_cb(disp, display_release_cb, LV_EVENT_DELETE, disp);
     lv_display_set_flush_cb(disp, flush_cb);
 
     return disp;
@@ -126,8 +137,13 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
     lv_strcpy(devname, file);
 
     lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+    lv_free((void *)dsc->devname);
     dsc->devname = devname;
 
+    if(dsc->fbp) {
+        munmap(dsc->fbp, dsc->screensize);
+        dsc->fbp = NULL;
+    }
     if(dsc->fbfd > 0) close(dsc->fbfd);
 
     /* Open the file for reading and writing*/
@@ -191,6 +207,7 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
     dsc->fbp = (char *)mmap(0, dsc->screensize, PROT_READ | PROT_WRITE, MAP_SHARED, dsc->fbfd, 0);
     if((intptr_t)dsc->fbp == -1) {
         perror("Error: failed to map framebuffer device to memory");
+        dsc->fbp = NULL;
         return;
     }
 
@@ -217,6 +234,21 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
     int32_t hor_res = dsc->vinfo.xres;
     int32_t ver_res = dsc->vinfo.yres;
     int32_t width = dsc->vinfo.width;
+
+    lv_display_set_resolution(disp, hor_res, ver_res);
+
+    if(width > 0) {
+        lv_display_set_dpi(disp, DIV_ROUND_UP(hor_res * 254, width * 10));
+    }
+
+    LV_LOG_INFO("Resolution is set to %" LV_PRId32 "x%" LV_PRId32 " at %" LV_PRId32 "dpi",
+                hor_res, ver_res, lv_display_get_dpi(disp));
+
+#if LV_LINUX_FBDEV_PAGE_FLIP && !LV_LINUX_FBDEV_BSD
+    dsc->page_flip = page_flip_init(disp, dsc);
+    if(dsc->page_flip) return;
+#endif
+
     uint32_t draw_buf_size = hor_res * (dsc->vinfo.bits_per_pixel >> 3);
     if(LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
         draw_buf_size *= LV_LINUX_FBDEV_BUFFER_SIZE;
@@ -225,23 +257,20 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
         draw_buf_size *= ver_res;
     }
 
-    uint8_t * draw_buf = NULL;
-    uint8_t * draw_buf_2 = NULL;
-    draw_buf = malloc(draw_buf_size);
+    /*Leave room to align the buffers to LV_DRAW_BUF_ALIGN*/
+    free(dsc->draw_buf);
+    free(dsc->draw_buf_2);
+    dsc->draw_buf = malloc(draw_buf_size + LV_DRAW_BUF_ALIGN - 1);
+    dsc->draw_buf_2 = NULL;
 
     if(LV_LINUX_FBDEV_BUFFER_COUNT == 2) {
-        draw_buf_2 = malloc(draw_buf_size);
+        dsc->draw_buf_2 = malloc(draw_buf_size + LV_DRAW_BUF_ALIGN - 1);
     }
 
-    lv_display_set_resolution(disp, hor_res, ver_res);
-    lv_display_set_buffers(disp, draw_buf, draw_buf_2, draw_buf_size, LV_LINUX_FBDEV_RENDER_MODE);
-
-    if(width > 0) {
-        lv_display_set_dpi(disp, DIV_ROUND_UP(hor_res * 254, width * 10));
-    }
-
-    LV_LOG_INFO("Resolution is set to %" LV_PRId32 "x%" LV_PRId32 " at %" LV_PRId32 "dpi",
-                hor_res, ver_res, lv_display_get_dpi(disp));
+    lv_color_format_t cf = lv_display_get_color_format(disp);
+    lv_display_set_buffers(disp, lv_draw_buf_align(dsc->draw_buf, cf),
+                           dsc->draw_buf_2 ? lv_draw_buf_align(dsc->draw_buf_2, cf) : NULL,
+                           draw_buf_size, LV_LINUX_FBDEV_RENDER_MODE);
 }
 
 void lv_linux_fbdev_set_force_refresh(lv_display_t * disp, bool enabled)
@@ -263,6 +292,15 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * colo
         return;
     }
 
+#if LV_LINUX_FBDEV_PAGE_FLIP && !LV_LINUX_FBDEV_BSD
+    if(dsc->page_flip) {
+        /*The areas are rendered directly to the framebuffer, only the page needs to be shown*/
+        if(lv_display_flush_is_last(disp)) page_flip_flush(dsc, color_p);
+        lv_display_flush_ready(disp);
+        return;
+    }
+#endif
+
     int32_t w = lv_area_get_width(area);
     int32_t h = lv_area_get_height(area);
     lv_color_format_t cf = lv_display_get_color_format(disp);
@@ -272,16 +310,17 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * colo
 
     /* Not all framebuffer kernel drivers support hardware rotation, so we need to handle it in software here */
     if(rotation != LV_DISPLAY_ROTATION_0 && LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        uint32_t w_stride = lv_draw_buf_width_to_stride(w, cf);
+        uint32_t h_stride = lv_draw_buf_width_to_stride(h, cf);
+
         /* (Re)allocate temporary buffer if needed */
-        size_t buf_size = w * h * px_size;
+        size_t buf_size = rotation == LV_DISPLAY_ROTATION_180 ? h * w_stride : w * h_stride;
         if(!dsc->rotated_buf || dsc->rotated_buf_size != buf_size) {
             dsc->rotated_buf = realloc(dsc->rotated_buf, buf_size);
             dsc->rotated_buf_size = buf_size;
         }
 
         /* Rotate the pixel buffer */
-        uint32_t w_stride = lv_draw_buf_width_to_stride(w, cf);
-        uint32_t h_stride = lv_draw_buf_width_to_stride(h, cf);
 
         switch(rotation) {
             case LV_DISPLAY_ROTATION_0:
@@ -319,22 +358,24 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * colo
     uint8_t * fbp = (uint8_t *)dsc->fbp;
     int32_t y;
     if(LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_DIRECT) {
+        uint32_t color_stride = lv_draw_buf_width_to_stride(disp->hor_res, cf);
         uint32_t color_pos =
             area->x1 * px_size +
-            area->y1 * disp->hor_res * px_size;
+            area->y1 * color_stride;
 
         for(y = area->y1; y <= area->y2; y++) {
             lv_memcpy(&fbp[fb_pos], &color_p[color_pos], w * px_size);
             fb_pos += dsc->finfo.line_length;
-            color_pos += disp->hor_res * px_size;
+            color_pos += color_stride;
         }
     }
     else {
         w = lv_area_get_width(area);
+        uint32_t color_stride = lv_draw_buf_width_to_stride(w, cf);
         for(y = area->y1; y <= area->y2; y++) {
             lv_memcpy(&fbp[fb_pos], color_p, w * px_size);
             fb_pos += dsc->finfo.line_length;
-            color_p += w * px_size;
+            color_p += color_stride;
         }
     }
 
@@ -348,6 +389,98 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * colo
     lv_display_flush_ready(disp);
 }
 
+#if LV_LINUX_FBDEV_PAGE_FLIP && !LV_LINUX_FBDEV_BSD
+
+/**
+ * Use two pages of the virtual framebuffer as draw buffers in direct mode if the driver supports panning.
+ * LVGL renders into the off-screen page and synchronizes the changed areas between the pages.
+ * @param disp      pointer to a display
+ * @param dsc       the driver data of the display
+ * @return          true: page flip mode is used; false: it's not supported, use copy mode
+ */
+static bool page_flip_init(lv_display_t * disp, lv_linux_fb_t * dsc)
+{
+    uint32_t page_size = dsc->finfo.line_length * dsc->vinfo.yres;
+    if(page_size * 2 > (uint32_t)dsc->screensize) {
+        LV_LOG_INFO("The framebuffer memory is too small for two pages");
+        return false;
+    }
+
+    /*Ask for a virtual screen with two pages if it's not set up yet*/
+    if(dsc->vinfo.yres_virtual < dsc->vinfo.yres * 2) {
+        struct fb_var_screeninfo vinfo = dsc->vinfo;
+        vinfo.yres_virtual = dsc->vinfo.yres * 2;
+        if(ioctl(dsc->fbfd, FBIOPUT_VSCREENINFO, &vinfo) == -1 ||
+           ioctl(dsc->fbfd, FBIOGET_VSCREENINFO, &vinfo) == -1 ||
+           vinfo.yres_virtual < dsc->vinfo.yres * 2) {
+            LV_LOG_INFO("The virtual resolution can't be set for two pages");
+            return false;
+        }
+        dsc->vinfo = vinfo;
+    }
+
+    /*Show the first page, LVGL will render to the second one first*/
+    dsc->vinfo.xoffset = 0;
+    dsc->vinfo.yoffset = 0;
+    if(ioctl(dsc->fbfd, FBIOPAN_DISPLAY, &dsc->vinfo) == -1) {
+        LV_LOG_INFO("Panning is not supported");
+        return false;
+    }
+
+    uint32_t hor_res = dsc->vinfo.xres;
+    uint32_t ver_res = dsc->vinfo.yres;
+    lv_color_format_t cf = lv_display_get_color_format(disp);
+    uint8_t * page_1 = (uint8_t *)dsc->fbp + page_size;
+    uint8_t * page_2 = (uint8_t *)dsc->fbp;
+    lv_draw_buf_init(&dsc->page_buf_1, hor_res, ver_res, cf, dsc->finfo.line_length, page_1, page_size);
+    lv_draw_buf_init(&dsc->page_buf_2, hor_res, ver_res, cf, dsc->finfo.line_length, page_2, page_size);
+
+    /*Render to the pages where they are, their alignment is given by the framebuffer*/
+    dsc->page_buf_1.data = page_1;
+    dsc->page_buf_2.data = page_2;
+
+    lv_display_set_draw_buffers(disp, &dsc->page_buf_1, &dsc->page_buf_2);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+
+    LV_LOG_INFO("Page flip mode is used");
+    return true;
+}
+
+static void page_flip_flush(lv_linux_fb_t * dsc, uint8_t * color_p)
+{
+    dsc->vinfo.yoffset = (color_p - (uint8_t *)dsc->fbp) / dsc->finfo.line_length;
+    if(ioctl(dsc->fbfd, FBIOPAN_DISPLAY, &dsc->vinfo) == -1) {
+        perror("ioctl(FBIOPAN_DISPLAY)");
+        return;
+    }
+
+    /*Don't render to the previous page while it's still scanned out.
+     *Not all drivers support it, so the error is ignored.*/
+    uint32_t crtc = 0;
+    ioctl(dsc->fbfd, FBIO_WAITFORVSYNC, &crtc);
+}
+
+#endif /*LV_LINUX_FBDEV_PAGE_FLIP*/
+
+static void display_release_cb(lv_event_t * e)
+{
+    lv_display_t * disp = (lv_display_t *) lv_event_get_user_data(e);
+    lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+    if(dsc == NULL) return;
+
+    lv_display_set_driver_data(disp, NULL);
+    lv_display_set_flush_cb(disp, NULL);
+
+    if(dsc->fbp) munmap(dsc->fbp, dsc->screensize);
+    if(dsc->fbfd >= 0) close(dsc->fbfd);
+
+    free(dsc->rotated_buf);
+    free(dsc->draw_buf);
+    free(dsc->draw_buf_2);
+    lv_free((void *)dsc->devname);
+    lv_free(dsc);
+}
+
 static uint32_t tick_get_cb(void)
 {
     struct timeval tv_now;
@@ -14,6 +14,7 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
 
 /*********************
  *      DEFINES
@@ -22,6 +23,24 @@
     #define font_rle LV_GLOBAL_DEFAULT()->font_fmt_rle
 #endif /*LV_USE_FONT_COMPRESSED*/
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    #if LV_FONT_FMT_TXT_CACHE_SIZE < 256 || (LV_FONT_FMT_TXT_CACHE_SIZE & (LV_FONT_FMT_TXT_CACHE_SIZE - 1))
+        #error "LV_FONT_FMT_TXT_CACHE_SIZE should be a power of 2 >= 256"
+    #endif
+
+    #define cache_state LV_GLOBAL_DEFAULT()->font_fmt_txt_cache
+    #define CACHE_MASK (LV_FONT_FMT_TXT_CACHE_SIZE - 1)
+
+    /*A glyph ID entry: (letter / LV_FONT_FMT_TXT_CACHE_SIZE + 1) << CACHE_GID_BITS | glyph_id
+     *The letter's low bits are the index. The tag fits into the upper 13 bits with the size >= 256.*/
+    #define CACHE_GID_BITS      19
+    #define CACHE_LETTER_MAX    0x10FFFF
+
+    /*A kerning entry: (gid_left + 1) << 16 | (gid_right / LV_FONT_FMT_TXT_CACHE_SIZE) << 8 | value
+     *`gid_right`'s low bits can be calculated from the index and `gid_left`.*/
+    #define CACHE_KERN_INDEX(gid_left, gid_right) (((gid_right) ^ ((gid_left) * 31)) & CACHE_MASK)
+#endif /*LV_FONT_FMT_TXT_CACHE_SIZE*/
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -34,11 +53,17 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t find_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
+static int8_t find_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    static lv_font_fmt_txt_cache_t * get_cache(const lv_font_fmt_txt_dsc_t * fdsc);
+#endif
+
 #if LV_USE_FONT_COMPRESSED
     static void decompress(const uint8_t * in, uint8_t * out, int32_t w, int32_t h, uint8_t bpp, bool prefilter);
     static inline void decompress_line(uint8_t * out, int32_t w);
@@ -210,6 +235,44 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+void lv_font_fmt_txt_drop_cache(const lv_font_t * font)
+{
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    lv_mutex_lock(&cache_state.lock);
+    lv_font_fmt_txt_cache_t * cache;
+    for(cache = cache_state.head; cache; cache = cache->next) {
+        if(cache->fdsc == font->dsc) {
+            /*Keep it in the list because the draw threads might read it. It will be reused by an other font.*/
+            cache->fdsc = NULL;
+            break;
+        }
+    }
+    lv_mutex_unlock(&cache_state.lock);
+#else
+    LV_UNUSED(font);
+#endif
+}
+
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+void _lv_font_fmt_txt_cache_init(void)
+{
+    cache_state.head = NULL;
+    lv_mutex_init(&cache_state.lock);
+}
+
+void _lv_font_fmt_txt_cache_deinit(void)
+{
+    lv_font_fmt_txt_cache_t * cache = cache_state.head;
+    while(cache) {
+        lv_font_fmt_txt_cache_t * next = cache->next;
+        lv_free(cache);
+        cache = next;
+    }
+    cache_state.head = NULL;
+    lv_mutex_delete(&cache_state.lock);
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -218,6 +281,29 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 {
     if(letter == '\0') return 0;
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    if(letter > CACHE_LETTER_MAX) return find_glyph_dsc_id(font, letter);
+
+    lv_font_fmt_txt_cache_t * cache = get_cache(font->dsc);
+    if(cache == NULL) return find_glyph_dsc_id(font, letter);
+
+    /*Not found letters are cached too, as they are looked up in every font of a fallback chain*/
+    uint32_t tag = (letter / LV_FONT_FMT_TXT_CACHE_SIZE + 1) << CACHE_GID_BITS;
+    volatile uint32_t * entry_p = &cache->glyph_ids[letter & CACHE_MASK];
+    uint32_t entry = *entry_p;
+    if((entry & ~((1UL << CACHE_GID_BITS) - 1)) == tag) return entry & ((1UL << CACHE_GID_BITS) - 1);
+
+    uint32_t gid = find_glyph_dsc_id(font, letter);
+    if(gid < (1UL << CACHE_GID_BITS)) *entry_p = tag | gid;
+    return gid;
+#else
+    return find_glyph_dsc_id(font, letter);
+#endif
+}
+
+static uint32_t find_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
+{
+
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
     uint16_t i;
@@ -264,6 +350,29 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 }
 
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
+{
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    /*The kern classes are found without search, only the pairs are worth to be cached*/
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    if(fdsc->kern_classes || gid_left >= 0xFFFF || gid_right > 0xFFFF) return find_kern_value(font, gid_left, gid_right);
+
+    lv_font_fmt_txt_cache_t * cache = get_cache(fdsc);
+    if(cache == NULL) return find_kern_value(font, gid_left, gid_right);
+
+    uint32_t tag = ((gid_left + 1) << 16) | ((gid_right / LV_FONT_FMT_TXT_CACHE_SIZE) << 8);
+    volatile uint32_t * entry_p = &cache->kern_values[CACHE_KERN_INDEX(gid_left, gid_right)];
+    uint32_t entry = *entry_p;
+    if((entry & 0xFFFFFF00) == tag) return (int8_t)(entry & 0xFF);
+
+    int8_t value = find_kern_value(font, gid_left, gid_right);
+    *entry_p = tag | (uint8_t)value;
+    return value;
+#else
+    return find_kern_value(font, gid_left, gid_right);
+#endif
+}
+
+static int8_t find_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
@@ -319,6 +428,54 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     return value;
 }
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+/**
+ * Get the cache of a font or add a new one.
+ * The list of the caches is read without locking: a cache is never removed
+ * and it's added to the head only after it's initialized.
+ * @param fdsc      the descriptor of the font
+ * @return          the cache or NULL if it couldn't be allocated
+ */
+static lv_font_fmt_txt_cache_t * get_cache(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    lv_font_fmt_txt_cache_t * cache;
+    for(cache = cache_state.head; cache; cache = cache->next) {
+        if(cache->fdsc == fdsc) return cache;
+    }
+
+    lv_mutex_lock(&cache_state.lock);
+
+    /*An other thread might have added it meanwhile*/
+    lv_font_fmt_txt_cache_t * unused = NULL;
+    for(cache = cache_state.head; cache; cache = cache->next) {
+        if(cache->fdsc == fdsc) break;
+        if(cache->fdsc == NULL && unused == NULL) unused = cache;
+    }
+
+    if(cache == NULL) {
+        if(unused) {
+            cache = unused;
+            lv_memzero((void *)cache->glyph_ids, sizeof(cache->glyph_ids));
+            lv_memzero((void *)cache->kern_values, sizeof(cache->kern_values));
+            cache->fdsc = fdsc;
+        }
+        else {
+            cache = lv_malloc_zeroed(sizeof(lv_font_fmt_txt_cache_t));
+            LV_ASSERT_MALLOC(cache);
+            if(cache) {
+                cache->fdsc = fdsc;
+                cache->next = cache_state.head;
+                cache_state.head = cache;
+            }
+        }
+    }
+
+    lv_mutex_unlock(&cache_state.lock);
+
+    return cache;
+}
+#endif /*LV_FONT_FMT_TXT_CACHE_SIZE*/
+
 static int32_t kern_pair_8_compare(const void * ref, const void * element)
 {
     const kern_pair_ref_t * ref8_p = ref;
@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 #include "lv_font.h"
 #include "../misc/lv_types.h"
+#include "../osal/lv_os.h"
 
 /*********************
  *      DEFINES
@@ -208,6 +209,22 @@ typedef struct {
 } lv_font_fmt_rle_t;
 #endif
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+/*Direct mapped cache of the glyph IDs and kerning values of a font.
+ *The entries are single words to be read and written by the draw threads without locking.*/
+typedef struct _lv_font_fmt_txt_cache_t {
+    struct _lv_font_fmt_txt_cache_t * next;
+    const lv_font_fmt_txt_dsc_t * volatile fdsc;    /*NULL if the cache is unused*/
+    volatile uint32_t glyph_ids[LV_FONT_FMT_TXT_CACHE_SIZE];
+    volatile uint32_t kern_values[LV_FONT_FMT_TXT_CACHE_SIZE];
+} lv_font_fmt_txt_cache_t;
+
+typedef struct {
+    lv_font_fmt_txt_cache_t * volatile head;    /*New caches are added to the head only*/
+    lv_mutex_t lock;                            /*Protects adding and reusing the caches*/
+} lv_font_fmt_txt_cache_state_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -232,6 +249,26 @@ const void * lv_font_get_bitmap_fmt_txt(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Drop the cached glyph IDs and kerning values of a font.
+ * Needs to be called before a font created in run time is freed or modified.
+ * Does nothing if `LV_FONT_FMT_TXT_CACHE_SIZE` is 0.
+ * @param font      pointer to a font using `lv_font_fmt_txt_dsc_t`
+ */
+void lv_font_fmt_txt_drop_cache(const lv_font_t * font);
+
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+/**
+ * Initialize the glyph ID and kerning caches of the fonts
+ */
+void _lv_font_fmt_txt_cache_init(void);
+
+/**
+ * Free the glyph ID and kerning caches of the fonts
+ */
+void _lv_font_fmt_txt_cache_deinit(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
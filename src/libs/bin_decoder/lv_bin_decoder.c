@@ -55,6 +55,8 @@ typedef struct {
     lv_draw_buf_t * decompressed;       /*Decompressed data could be used directly, thus must also be draw buf*/
     lv_draw_buf_t c_array;              /*An C-array image that need to be converted to a draw buf*/
     lv_draw_buf_t * decoded_partial;    /*A draw buf for decoded image via get_area_cb*/
+    const void * mapped;                /*The content of the file mapped by the file system driver*/
+    uint32_t mapped_size;
 } decoder_data_t;
 
 /**********************
@@ -68,6 +70,7 @@ static lv_result_t load_indexed(lv_image_decoder_t * decoder, lv_image_decoder_d
     static lv_result_t decode_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 #endif
 static lv_result_t decode_alpha_only(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static lv_result_t map_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static lv_result_t decode_indexed_line(lv_color_format_t color_format, const lv_color32_t * palette, int32_t x,
                                        int32_t w_px, const uint8_t * in, lv_color32_t * out);
 static lv_result_t decode_compressed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
@@ -229,6 +232,11 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
         else if(LV_COLOR_FORMAT_IS_ALPHA_ONLY(cf)) {
             res = decode_alpha_only(decoder, dsc);
         }
+        else if(map_rgb(decoder, dsc) == LV_RESULT_OK) {
+            /*The pixels are read from the mapped file, no need to copy them to the cache*/
+            res = LV_RESULT_OK;
+            use_directly = true;
+        }
 #if LV_BIN_DECODER_RAM_LOAD
         else if(cf == LV_COLOR_FORMAT_ARGB8888      \
                 || cf == LV_COLOR_FORMAT_XRGB8888   \
@@ -532,6 +540,7 @@ static void free_decoder_data(lv_image_decoder_dsc_t * dsc)
     if(decoder_data == NULL) return;
 
     if(decoder_data->f) {
+        if(decoder_data->mapped) lv_fs_unmap(decoder_data->f, decoder_data->mapped, decoder_data->mapped_size);
         lv_fs_close(decoder_data->f);
         lv_free(decoder_data->f);
     }
@@ -795,6 +804,63 @@ static lv_result_t decode_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc
 }
 #endif
 
+/**
+ * Use the pixels of an RGB image file directly from the memory if the file system driver can map it.
+ * @param decoder pointer to the decoder
+ * @param dsc     pointer to the decoder descriptor
+ * @return LV_RESULT_OK: the file is mapped; LV_RESULT_INVALID: it should be read instead
+ */
+static lv_result_t map_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    decoder_data_t * decoder_data = dsc->user_data;
+    lv_color_format_t cf = dsc->header.cf;
+
+    if(cf != LV_COLOR_FORMAT_ARGB8888       \
+       && cf != LV_COLOR_FORMAT_XRGB8888    \
+       && cf != LV_COLOR_FORMAT_RGB888      \
+       && cf != LV_COLOR_FORMAT_RGB565      \
+       && cf != LV_COLOR_FORMAT_RGB565A8    \
+       && cf != LV_COLOR_FORMAT_ARGB8565) {
+        return LV_RESULT_INVALID;
+    }
+
+    /*The mapped memory is read-only so the stride can't be adjusted in place*/
+    if(dsc->args.stride_align && cf != LV_COLOR_FORMAT_RGB565A8 &&
+       dsc->header.stride != lv_draw_buf_width_to_stride(dsc->header.w, cf)) {
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t len = dsc->header.stride * dsc->header.h;
+    if(cf == LV_COLOR_FORMAT_RGB565A8) {
+        len += (dsc->header.stride / 2) * dsc->header.h; /*A8 mask*/
+    }
+
+    const void * buf;
+    uint32_t size;
+    if(lv_fs_map(decoder_data->f, &buf, &size) != LV_FS_RES_OK) return LV_RESULT_INVALID;
+
+    if(size < sizeof(lv_image_header_t) + len) {
+        LV_LOG_WARN("The file is too small: %" LV_PRIu32 " bytes", size);
+        lv_fs_unmap(decoder_data->f, buf, size);
+        return LV_RESULT_INVALID;
+    }
+
+    decoder_data->mapped = buf; /*Unmapped when decoder closes*/
+    decoder_data->mapped_size = size;
+
+    lv_image_dsc_t image;
+    lv_memzero(&image, sizeof(image));
+    image.header = dsc->header;
+    image.header.flags &= ~LV_IMAGE_FLAGS_MODIFIABLE;
+    image.data_size = len;
+    image.data = (const uint8_t *)buf + sizeof(lv_image_header_t);
+
+    lv_draw_buf_from_image(&decoder_data->c_array, &image);
+    dsc->decoded = &decoder_data->c_array;
+    return LV_RESULT_OK;
+}
+
 /**
  * Extend A1/2/4 to A8 with interpolation to reduce rounding error.
  */
@@ -60,6 +60,7 @@ static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p);
 static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
 static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
 static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t fs_map(lv_fs_drv_t * drv, void * file_p, const void ** buf, uint32_t * size);
 
 /**********************
  *  STATIC VARIABLES
@@ -96,6 +97,7 @@ void lv_fs_memfs_init(void)
     fs_drv.write_cb = NULL;
     fs_drv.seek_cb = fs_seek;
     fs_drv.tell_cb = fs_tell;
+    fs_drv.map_cb = fs_map;
 
     fs_drv.dir_close_cb = NULL;
     fs_drv.dir_open_cb = NULL;
@@ -205,6 +207,24 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
     return LV_FS_RES_OK;
 }
 
+/**
+ * Get the memory buffer of the file. It's not copied so there is nothing to unmap.
+ * @param drv       pointer to a driver where this function belongs
+ * @param file_p    pointer to a FILE variable
+ * @param buf       pointer to store the address of the buffer
+ * @param size      pointer to store the size of the buffer
+ * @return LV_FS_RES_OK: no error
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_map(lv_fs_drv_t * drv, void * file_p, const void ** buf, uint32_t * size)
+{
+    LV_UNUSED(drv);
+    lv_fs_file_t * fp = (lv_fs_file_t *)file_p;
+    *buf = fp->cache->buffer;
+    *size = fp->cache->end;
+    return LV_FS_RES_OK;
+}
+
 #else /*LV_USE_FS_MEMFS == 0*/
 
 #if defined(LV_FS_MEMFS_LETTER) && LV_FS_MEMFS_LETTER != '\0'
@@ -17,6 +17,14 @@
 #include <unistd.h>
 #include <errno.h>
 
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #define FS_POSIX_USE_MMAP 1
+#else
+    #define FS_POSIX_USE_MMAP 0
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -44,6 +52,10 @@ static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_
 static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
 static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
 static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+#if FS_POSIX_USE_MMAP
+    static lv_fs_res_t fs_map(lv_fs_drv_t * drv, void * file_p, const void ** buf, uint32_t * size);
+    static lv_fs_res_t fs_unmap(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t size);
+#endif
 static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
 static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn, uint32_t fn_len);
 static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
@@ -82,6 +94,10 @@ void lv_fs_posix_init(void)
     fs_drv_p->write_cb = fs_write;
     fs_drv_p->seek_cb = fs_seek;
     fs_drv_p->tell_cb = fs_tell;
+#if FS_POSIX_USE_MMAP
+    fs_drv_p->map_cb = fs_map;
+    fs_drv_p->unmap_cb = fs_unmap;
+#endif
 
     fs_drv_p->dir_close_cb = fs_dir_close;
     fs_drv_p->dir_open_cb = fs_dir_open;
@@ -252,6 +268,62 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
     return LV_FS_RES_OK;
 }
 
+#if FS_POSIX_USE_MMAP
+/**
+ * Map the whole file to the memory as read-only
+ * @param drv       pointer to a driver where this function belongs
+ * @param file_p    a file handle variable
+ * @param buf       pointer to store the address of the mapped content
+ * @param size      pointer to store the size of the file
+ * @return LV_FS_RES_OK: no error
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_map(lv_fs_drv_t * drv, void * file_p, const void ** buf, uint32_t * size)
+{
+    LV_UNUSED(drv);
+
+    int fd = FILEP2FD(file_p);
+    struct stat st;
+    if(fstat(fd, &st) < 0) {
+        LV_LOG_WARN("Could not get the size of file: %d, errno: %d", fd, errno);
+        return LV_FS_RES_FS_ERR;
+    }
+
+    if(st.st_size <= 0 || (uint64_t)st.st_size > UINT32_MAX) return LV_FS_RES_NOT_IMP;
+
+    void * addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(addr == MAP_FAILED) {
+        LV_LOG_WARN("Could not map file: %d, errno: %d", fd, errno);
+        return LV_FS_RES_FS_ERR;
+    }
+
+    *buf = addr;
+    *size = (uint32_t)st.st_size;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Unmap the content mapped by `fs_map`
+ * @param drv       pointer to a driver where this function belongs
+ * @param file_p    a file handle variable
+ * @param buf       the address of the mapped content
+ * @param size      the size of the mapped content
+ * @return LV_FS_RES_OK: no error
+ *         any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_unmap(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t size)
+{
+    LV_UNUSED(drv);
+
+    if(munmap((void *)buf, size) < 0) {
+        LV_LOG_WARN("Could not unmap file: %d, errno: %d", (int)FILEP2FD(file_p), errno);
+        return LV_FS_RES_FS_ERR;
+    }
+
+    return LV_FS_RES_OK;
+}
+#endif /*FS_POSIX_USE_MMAP*/
+
 /**
  * Initialize a 'fs_read_dir_t' variable for directory reading
  * @param drv   pointer to a driver where this function belongs
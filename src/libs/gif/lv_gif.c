@@ -16,6 +16,10 @@
  *********************/
 #define MY_CLASS (&lv_gif_class)
 
+#if LV_GIF_PREDECODE_FRAME_CNT
+    #define FRAME_CNT (LV_GIF_PREDECODE_FRAME_CNT + 1)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -26,6 +30,16 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static int decode_frame(gd_GIF * gif, lv_area_t * changed_area);
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * area);
+#if LV_GIF_PREDECODE_FRAME_CNT
+    static lv_result_t predecode_start(lv_gif_t * gifobj);
+    static void predecode_stop(lv_gif_t * gifobj);
+    static void predecode_rewind(lv_gif_t * gifobj);
+    static void predecode_frame(lv_gif_t * gifobj, lv_gif_frame_t * frame);
+    static void predecode_thread_cb(void * user_data);
+    static void next_predecoded_frame(lv_obj_t * obj);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -64,6 +78,9 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     if(gifobj->gif) {
         lv_image_cache_drop(lv_image_get_src(obj));
 
+#if LV_GIF_PREDECODE_FRAME_CNT
+        predecode_stop(gifobj);
+#endif
         gd_close_gif(gifobj->gif);
         gifobj->gif = NULL;
         gifobj->imgdsc.data = NULL;
@@ -92,8 +109,12 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
 
-    next_frame_task_cb(gifobj->timer);
+#if LV_GIF_PREDECODE_FRAME_CNT
+    /*Decode the first frame right away and the next ones in the background*/
+    if(predecode_start(gifobj) == LV_RESULT_OK) return;
+#endif
 
+    next_frame_task_cb(gifobj->timer);
 }
 
 void lv_gif_restart(lv_obj_t * obj)
@@ -105,7 +126,12 @@ void lv_gif_restart(lv_obj_t * obj)
         return;
     }
 
+#if LV_GIF_PREDECODE_FRAME_CNT
+    if(gifobj->thread_started) predecode_rewind(gifobj);
+    else gd_rewind(gifobj->gif);
+#else
     gd_rewind(gifobj->gif);
+#endif
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
 }
@@ -150,6 +176,9 @@ static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     lv_image_cache_drop(lv_image_get_src(obj));
 
+#if LV_GIF_PREDECODE_FRAME_CNT
+    predecode_stop(gifobj);
+#endif
     if(gifobj->gif)
         gd_close_gif(gifobj->gif);
     lv_timer_delete(gifobj->timer);
@@ -159,12 +188,21 @@ static void next_frame_task_cb(lv_timer_t * t)
 {
     lv_obj_t * obj = t->user_data;
     lv_gif_t * gifobj = (lv_gif_t *) obj;
+
+#if LV_GIF_PREDECODE_FRAME_CNT
+    if(gifobj->thread_started) {
+        next_predecoded_frame(obj);
+        return;
+    }
+#endif
+
     uint32_t elaps = lv_tick_elaps(gifobj->last_call);
     if(elaps < gifobj->gif->gce.delay * 10) return;
 
     gifobj->last_call = lv_tick_get();
 
-    int has_next = gd_get_frame(gifobj->gif);
+    lv_area_t changed_area;
+    int has_next = decode_frame(gifobj->gif, &changed_area);
     if(has_next == 0) {
         /*It was the last repeat*/
         lv_result_t res = lv_obj_send_event(obj, LV_EVENT_READY, NULL);
@@ -172,10 +210,241 @@ static void next_frame_task_cb(lv_timer_t * t)
         if(res != LV_FS_RES_OK) return;
     }
 
-    gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
+    lv_image_cache_drop(lv_image_get_src(obj));
+    invalidate_frame_area(obj, &changed_area);
+}
+
+/**
+ * Decode the next frame to the canvas
+ * @param gif           pointer to a gif decoder
+ * @param changed_area  store the area of the canvas which has changed since the previous frame
+ * @return              1: got a frame; 0: it was the last repeat; -1: error
+ */
+static int decode_frame(gd_GIF * gif, lv_area_t * changed_area)
+{
+    /*The area of the previous frame changes only if it's restored to the background*/
+    bool prev_disposed = gif->gce.disposal == 2 && gif->fw > 0 && gif->fh > 0;
+    lv_area_t prev_area;
+    lv_area_set(&prev_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+
+    int has_next = gd_get_frame(gif);
+    gd_render_frame(gif, gif->canvas);
+
+    lv_area_set(changed_area, gif->fx, gif->fy, gif->fx + gif->fw - 1, gif->fy + gif->fh - 1);
+    if(prev_disposed) _lv_area_join(changed_area, changed_area, &prev_area);
+
+    return has_next;
+}
+
+/**
+ * Invalidate the changed area of the canvas on the object
+ * @param obj       pointer to a gif object
+ * @param area      the changed area relative to the canvas
+ */
+static void invalidate_frame_area(lv_obj_t * obj, const lv_area_t * area)
+{
+    lv_image_t * img = (lv_image_t *)obj;
+
+    if(lv_area_get_width(area) <= 0 || lv_area_get_height(area) <= 0) return;
+
+    /*It's complicated to find the area if the image is transformed or tiled*/
+    if(img->scale_x != LV_SCALE_NONE || img->scale_y != LV_SCALE_NONE || img->rotation != 0 ||
+       img->align >= _LV_IMAGE_ALIGN_AUTO_TRANSFORM) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    /*Find the image's position in the same way as the image widget draws it*/
+    lv_area_t img_area;
+    lv_area_set(&img_area, 0, 0, img->w - 1, img->h - 1);
+    lv_area_align(&obj->coords, &img_area, img->align, img->offset.x, img->offset.y);
+
+    lv_area_t inv_area = *area;
+    lv_area_move(&inv_area, img_area.x1, img_area.y1);
+    if(_lv_area_intersect(&inv_area, &inv_area, &obj->coords)) {
+        lv_obj_invalidate_area(obj, &inv_area);
+    }
+}
+
+#if LV_GIF_PREDECODE_FRAME_CNT
+
+static lv_result_t predecode_start(lv_gif_t * gifobj)
+{
+    gd_GIF * gif = gifobj->gif;
+
+    uint32_t i;
+    for(i = 0; i < FRAME_CNT; i++) {
+        gifobj->frames[i].buf = lv_draw_buf_create(gif->width, gif->height, LV_COLOR_FORMAT_ARGB8888, gif->width * 4);
+        if(gifobj->frames[i].buf == NULL) break;
+    }
+
+    /*The thread waits until the first frame is decoded here*/
+    gifobj->frame_act = 0;
+    gifobj->frame_write = 0;
+    gifobj->exit = 0;
+    gifobj->rewind = 0;
+    gifobj->decoded_all = 0;
+
+    lv_result_t res = LV_RESULT_INVALID;
+    if(i == FRAME_CNT) {
+        lv_mutex_init(&gifobj->lock);
+        lv_thread_sync_init(&gifobj->sync);
+        res = lv_thread_init(&gifobj->thread, LV_THREAD_PRIO_LOW, predecode_thread_cb, LV_DRAW_THREAD_STACK_SIZE, gifobj);
+        if(res != LV_RESULT_OK) {
+            lv_thread_sync_delete(&gifobj->sync);
+            lv_mutex_delete(&gifobj->lock);
+        }
+    }
+
+    if(res != LV_RESULT_OK) {
+        LV_LOG_WARN("Couldn't start decoding in the background, decode the frames when they are due");
+        for(i = 0; i < FRAME_CNT; i++) {
+            if(gifobj->frames[i].buf) lv_draw_buf_destroy(gifobj->frames[i].buf);
+            gifobj->frames[i].buf = NULL;
+        }
+        return LV_RESULT_INVALID;
+    }
+
+    gifobj->thread_started = 1;
+
+    predecode_frame(gifobj, &gifobj->frames[0]);
+    gifobj->imgdsc.data = gifobj->frames[0].buf->data;
+    gifobj->last_call = lv_tick_get();
+
+    lv_mutex_lock(&gifobj->lock);
+    gifobj->frame_write = 1;
+    gifobj->decoded_all = gifobj->frames[0].last;
+    lv_mutex_unlock(&gifobj->lock);
+    lv_thread_sync_signal(&gifobj->sync);
+
+    return LV_RESULT_OK;
+}
+
+static void predecode_stop(lv_gif_t * gifobj)
+{
+    if(!gifobj->thread_started) return;
+
+    lv_mutex_lock(&gifobj->lock);
+    gifobj->exit = 1;
+    lv_mutex_unlock(&gifobj->lock);
+
+    lv_thread_sync_signal(&gifobj->sync);
+    lv_thread_delete(&gifobj->thread);
+    lv_thread_sync_delete(&gifobj->sync);
+    lv_mutex_delete(&gifobj->lock);
+    gifobj->thread_started = 0;
+
+    uint32_t i;
+    for(i = 0; i < FRAME_CNT; i++) {
+        lv_draw_buf_destroy(gifobj->frames[i].buf);
+        gifobj->frames[i].buf = NULL;
+    }
+}
+
+static void predecode_rewind(lv_gif_t * gifobj)
+{
+    /*Drop the frames decoded ahead and let the thread rewind the GIF*/
+    lv_mutex_lock(&gifobj->lock);
+    gifobj->rewind = 1;
+    gifobj->generation++;
+    gifobj->frame_write = (gifobj->frame_act + 1) % FRAME_CNT;
+    lv_mutex_unlock(&gifobj->lock);
+
+    lv_thread_sync_signal(&gifobj->sync);
+}
+
+static void predecode_frame(lv_gif_t * gifobj, lv_gif_frame_t * frame)
+{
+    gd_GIF * gif = gifobj->gif;
+
+    int has_next = decode_frame(gif, &frame->changed_area);
+    lv_memcpy(frame->buf->data, gif->canvas, (uint32_t)gif->width * gif->height * 4);
+    frame->delay = gif->gce.delay;
+
+    /*Stop on error too, instead of decoding the broken frames again and again*/
+    frame->last = has_next != 1;
+}
+
+static void predecode_thread_cb(void * user_data)
+{
+    lv_gif_t * gifobj = user_data;
+    bool changed_all = false;
+
+    while(1) {
+        lv_mutex_lock(&gifobj->lock);
+        if(gifobj->rewind) {
+            gd_rewind(gifobj->gif);
+            gifobj->rewind = 0;
+            gifobj->decoded_all = 0;
+
+            /*The canvas might be ahead of the displayed frame*/
+            changed_all = true;
+        }
+
+        bool exit = gifobj->exit;
+        bool idle = gifobj->frame_write == gifobj->frame_act || gifobj->decoded_all;
+        uint32_t generation = gifobj->generation;
+        lv_gif_frame_t * frame = &gifobj->frames[gifobj->frame_write];
+        lv_mutex_unlock(&gifobj->lock);
+
+        if(exit) break;
+        if(idle) {
+            lv_thread_sync_wait(&gifobj->sync);
+            continue;
+        }
+
+        predecode_frame(gifobj, frame);
+        if(changed_all) {
+            lv_area_set(&frame->changed_area, 0, 0, gifobj->gif->width - 1, gifobj->gif->height - 1);
+        }
+
+        lv_mutex_lock(&gifobj->lock);
+        /*Drop the frame if the GIF was restarted meanwhile*/
+        if(generation == gifobj->generation) {
+            gifobj->frame_write = (gifobj->frame_write + 1) % FRAME_CNT;
+            gifobj->decoded_all = frame->last;
+            changed_all = false;
+        }
+        lv_mutex_unlock(&gifobj->lock);
+    }
+}
+
+static void next_predecoded_frame(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+
+    /*Only this function changes the displayed frame so it can be read without locking*/
+    lv_gif_frame_t * frame = &gifobj->frames[gifobj->frame_act];
+    uint32_t elaps = lv_tick_elaps(gifobj->last_call);
+    if(elaps < frame->delay * 10) return;
+
+    lv_mutex_lock(&gifobj->lock);
+    uint32_t next = (gifobj->frame_act + 1) % FRAME_CNT;
+    bool ready = next != gifobj->frame_write;
+    if(ready) gifobj->frame_act = next;
+    lv_mutex_unlock(&gifobj->lock);
+
+    /*Not decoded yet, show it as soon as it's ready*/
+    if(!ready) return;
+
+    /*The previous frame can be overwritten now*/
+    lv_thread_sync_signal(&gifobj->sync);
+
+    gifobj->last_call = lv_tick_get();
+    frame = &gifobj->frames[next];
+    gifobj->imgdsc.data = frame->buf->data;
+
+    if(frame->last) {
+        /*It was the last repeat*/
+        lv_result_t res = lv_obj_send_event(obj, LV_EVENT_READY, NULL);
+        lv_timer_pause(gifobj->timer);
+        if(res != LV_RESULT_OK) return;
+    }
 
     lv_image_cache_drop(lv_image_get_src(obj));
-    lv_obj_invalidate(obj);
+    invalidate_frame_area(obj, &frame->changed_area);
 }
 
+#endif /*LV_GIF_PREDECODE_FRAME_CNT*/
+
 #endif /*LV_USE_GIF*/
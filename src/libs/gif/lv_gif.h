@@ -27,12 +27,36 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+#if LV_GIF_PREDECODE_FRAME_CNT
+typedef struct {
+    lv_draw_buf_t * buf;
+    lv_area_t changed_area;     /**< The area which has changed since the previous frame*/
+    uint16_t delay;             /**< Show the frame for this long [10 ms]*/
+    uint8_t last : 1;           /**< It was the last repeat, no more frames*/
+} lv_gif_frame_t;
+#endif
+
 typedef struct {
     lv_image_t img;
     gd_GIF * gif;
     lv_timer_t * timer;
     lv_draw_buf_t imgdsc;
     uint32_t last_call;
+#if LV_GIF_PREDECODE_FRAME_CNT
+    /*Ring of the decoded frames. The worker thread fills the frames from `frame_write` until
+     *it reaches `frame_act`, which is the displayed one*/
+    lv_gif_frame_t frames[LV_GIF_PREDECODE_FRAME_CNT + 1];
+    uint32_t frame_act;
+    uint32_t frame_write;
+    uint32_t generation;        /**< Incremented on restart to drop the frames being decoded*/
+    lv_thread_t thread;
+    lv_thread_sync_t sync;
+    lv_mutex_t lock;
+    uint32_t thread_started : 1;
+    uint32_t exit : 1;
+    uint32_t rewind : 1;
+    uint32_t decoded_all : 1;   /**< The last frame was decoded, wait for a rewind*/
+#endif
 } lv_gif_t;
 
 LV_ATTRIBUTE_EXTERN_DATA extern const lv_obj_class_t lv_gif_class;
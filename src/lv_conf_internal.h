@@ -27,8 +27,14 @@
 #define LV_DRAW_SW_ASM_NONE         0
 #define LV_DRAW_SW_ASM_NEON         1
 #define LV_DRAW_SW_ASM_HELIUM       2
+#define LV_DRAW_SW_ASM_X86          3
 #define LV_DRAW_SW_ASM_CUSTOM       255
 
+#define LV_CACHE_POLICY_LRU         0
+#define LV_CACHE_POLICY_2Q          1
+#define LV_CACHE_POLICY_COST        2
+#define LV_CACHE_POLICY_HASH        3
+
 /* Handle special Kconfig options */
 #ifndef LV_KCONFIG_IGNORE
     #include "lv_conf_kconfig.h"
@@ -212,6 +218,17 @@
             #endif
         #endif
     #endif
+
+    /*Keep the small freed blocks of each thread to allocate them again without locking the heap.
+     *Size of the cache of a thread in bytes (e.g. 4096). 0: disable
+     *Used only with LV_USE_OS and requires compiler support for thread local variables*/
+    #ifndef LV_MEM_THREAD_CACHE_SIZE
+        #ifdef CONFIG_LV_MEM_THREAD_CACHE_SIZE
+            #define LV_MEM_THREAD_CACHE_SIZE CONFIG_LV_MEM_THREAD_CACHE_SIZE
+        #else
+            #define LV_MEM_THREAD_CACHE_SIZE 0
+        #endif
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -237,6 +254,16 @@
     #endif
 #endif
 
+/*The overhead of refreshing one more area (e.g. starting a flush) expressed in pixels.
+ *Invalidated areas are joined if redrawing the joined area is cheaper than redrawing them separately.*/
+#ifndef LV_REFR_AREA_OVERHEAD
+    #ifdef CONFIG_LV_REFR_AREA_OVERHEAD
+        #define LV_REFR_AREA_OVERHEAD CONFIG_LV_REFR_AREA_OVERHEAD
+    #else
+        #define LV_REFR_AREA_OVERHEAD 1024     /*[px]*/
+    #endif
+#endif
+
 /*=================
  * OPERATING SYSTEM
  *=================*/
@@ -345,6 +372,17 @@
         #endif
     #endif
 
+    /* Split the draw tasks covering at least this many pixels into horizontal bands.
+     * The idle draw units can render the bands of the same draw task in parallel.
+     * Has effect only if LV_DRAW_SW_DRAW_UNIT_CNT > 1. 0: disable splitting */
+    #ifndef LV_DRAW_SW_SPLIT_MIN_AREA
+        #ifdef CONFIG_LV_DRAW_SW_SPLIT_MIN_AREA
+            #define LV_DRAW_SW_SPLIT_MIN_AREA CONFIG_LV_DRAW_SW_SPLIT_MIN_AREA
+        #else
+            #define LV_DRAW_SW_SPLIT_MIN_AREA   (32 * 1024)
+        #endif
+    #endif
+
     /* Use Arm-2D to accelerate the sw render */
     #ifndef LV_USE_DRAW_ARM2D_SYNC
         #ifdef CONFIG_LV_USE_DRAW_ARM2D_SYNC
@@ -907,6 +945,50 @@
     #endif
 #endif
 
+/*Eviction policy of the image cache and the image header cache
+ * - LV_CACHE_POLICY_LRU:  evict the least recently used image
+ * - LV_CACHE_POLICY_2Q:   keep the images used in more frames when many images are shown only once (e.g. scrolling a gallery)
+ * - LV_CACHE_POLICY_COST: evict the images which use more memory and are faster to decode again
+ * - LV_CACHE_POLICY_HASH: approximate LRU with a hash table. With an OS the cached images are found without locking*/
+#ifndef LV_IMAGE_CACHE_POLICY
+    #ifdef CONFIG_LV_IMAGE_CACHE_POLICY
+        #define LV_IMAGE_CACHE_POLICY CONFIG_LV_IMAGE_CACHE_POLICY
+    #else
+        #define LV_IMAGE_CACHE_POLICY           LV_CACHE_POLICY_LRU
+    #endif
+#endif
+#ifndef LV_IMAGE_HEADER_CACHE_POLICY
+    #ifdef CONFIG_LV_IMAGE_HEADER_CACHE_POLICY
+        #define LV_IMAGE_HEADER_CACHE_POLICY CONFIG_LV_IMAGE_HEADER_CACHE_POLICY
+    #else
+        #define LV_IMAGE_HEADER_CACHE_POLICY    LV_CACHE_POLICY_LRU
+    #endif
+#endif
+
+/*Number of threads decoding the not cached images in the background.
+ *While an image is being decoded nothing is drawn in its place and the area is redrawn when it's ready.
+ *Requires `LV_USE_OS` and `LV_CACHE_DEF_SIZE > 0`. Enable it with `lv_image_decoder_enable_async(true)`.
+ *0: decode the images synchronously while drawing*/
+#ifndef LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    #ifdef CONFIG_LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+        #define LV_IMAGE_DECODER_ASYNC_THREAD_CNT CONFIG_LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+    #else
+        #define LV_IMAGE_DECODER_ASYNC_THREAD_CNT 0
+    #endif
+#endif
+
+/*Size of the tiles in which the images decoded by `get_area_cb` are cached (e.g. RGB bin files if
+ *`LV_BIN_DECODER_RAM_LOAD == 0` or JPGs decoded by TJPGD). Only the tiles which are drawn are decoded,
+ *so the memory usage depends on the visible part of an image instead of its size.
+ *Requires `LV_CACHE_DEF_SIZE > 0`. 0: don't cache the partially decoded images*/
+#ifndef LV_IMAGE_DECODER_TILE_SIZE
+    #ifdef CONFIG_LV_IMAGE_DECODER_TILE_SIZE
+        #define LV_IMAGE_DECODER_TILE_SIZE CONFIG_LV_IMAGE_DECODER_TILE_SIZE
+    #else
+        #define LV_IMAGE_DECODER_TILE_SIZE 0
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -936,6 +1018,18 @@
     #endif
 #endif
 
+/* Cache the resolved style values (found in the styles, inherited or default) per object
+ * to make getting style properties O(1) in the steady state.
+ * The cache is invalidated when any style, state or parent changes.
+ * Set the number of cached values per object (power of 2, e.g. 64) or 0 to disable.*/
+#ifndef LV_OBJ_STYLE_VALUE_CACHE
+    #ifdef CONFIG_LV_OBJ_STYLE_VALUE_CACHE
+        #define LV_OBJ_STYLE_VALUE_CACHE CONFIG_LV_OBJ_STYLE_VALUE_CACHE
+    #else
+        #define LV_OBJ_STYLE_VALUE_CACHE 0
+    #endif
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -1388,6 +1482,17 @@
     #endif
 #endif
 
+/*Cache the glyph IDs and the kerning values of the fonts with many characters (e.g. CJK fonts).
+ *It's the number of entries per font. Each entry takes 8 bytes and a cache is allocated for the used fonts.
+ *0: disable, else a power of 2 >= 256*/
+#ifndef LV_FONT_FMT_TXT_CACHE_SIZE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+        #define LV_FONT_FMT_TXT_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+    #else
+        #define LV_FONT_FMT_TXT_CACHE_SIZE 0
+    #endif
+#endif
+
 /*Enable drawing placeholders when glyph dsc is not found*/
 #ifndef LV_USE_FONT_PLACEHOLDER
     #ifdef _LV_KCONFIG_PRESENT
@@ -2386,6 +2491,16 @@
         #define LV_GIF_CACHE_DECODE_DATA 0
     #endif
 #endif
+/*Decode this many frames ahead in a background thread to avoid frame time spikes.
+ *It needs (LV_GIF_PREDECODE_FRAME_CNT + 1) * width * height * 4 bytes extra RAM per GIF.
+ *Requires an OS (`LV_USE_OS`). 0: decode the frames in a timer when they are due*/
+#ifndef LV_GIF_PREDECODE_FRAME_CNT
+    #ifdef CONFIG_LV_GIF_PREDECODE_FRAME_CNT
+        #define LV_GIF_PREDECODE_FRAME_CNT CONFIG_LV_GIF_PREDECODE_FRAME_CNT
+    #else
+        #define LV_GIF_PREDECODE_FRAME_CNT 0
+    #endif
+#endif
 #endif
 
 
@@ -2650,7 +2765,7 @@
         #endif
     #endif
     #if LV_USE_PROFILER_BUILTIN
-        /*Default profiler trace buffer size*/
+        /*Default profiler trace buffer size of each thread*/
         #ifndef LV_PROFILER_BUILTIN_BUF_SIZE
             #ifdef CONFIG_LV_PROFILER_BUILTIN_BUF_SIZE
                 #define LV_PROFILER_BUILTIN_BUF_SIZE CONFIG_LV_PROFILER_BUILTIN_BUF_SIZE
@@ -3005,6 +3120,15 @@
             #define LV_LINUX_FBDEV_BUFFER_SIZE   60
         #endif
     #endif
+    /*Render directly to two pages of the framebuffer and show them with `FBIOPAN_DISPLAY`
+     *instead of copying the rendered areas. The copy mode is used if panning is not supported.*/
+    #ifndef LV_LINUX_FBDEV_PAGE_FLIP
+        #ifdef CONFIG_LV_LINUX_FBDEV_PAGE_FLIP
+            #define LV_LINUX_FBDEV_PAGE_FLIP CONFIG_LV_LINUX_FBDEV_PAGE_FLIP
+        #else
+            #define LV_LINUX_FBDEV_PAGE_FLIP     0
+        #endif
+    #endif
 #endif
 
 /*Use Nuttx to open window and handle touchscreen*/
@@ -172,6 +172,10 @@ void lv_init(void)
 
     _lv_anim_core_init();
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    _lv_font_fmt_txt_cache_init();
+#endif
+
     _lv_group_init();
 
     lv_draw_init();
@@ -399,6 +403,10 @@ void lv_deinit(void)
 
     _lv_group_deinit();
 
+#if LV_FONT_FMT_TXT_CACHE_SIZE
+    _lv_font_fmt_txt_cache_deinit();
+#endif
+
     _lv_anim_core_deinit();
 
     _lv_layout_deinit();
@@ -0,0 +1,453 @@
+/**
+* @file _lv_cache_2q_rb.c
+*
+*/
+
+/*
+ * 2Q cache: the new entries are added to a FIFO queue ("in") and get to the LRU
+ * queue ("main") only if they are used again later. The victims are taken from
+ * the "in" queue first while it's larger than a quarter of the cache,
+ * so scanning through many entries used only once doesn't evict the frequently used ones.
+ *
+ * The original 2Q keeps the keys of the evicted entries to promote them when they are added again.
+ * Here the keys are not valid after `free_cb` (e.g. the image sources), so instead the entries are
+ * promoted if they are used again after the correlated reference period, which is one refresh period.
+ * This way using an entry several times to draw a single frame counts as one reference.
+ *
+ * The entries are found in a red-black tree just like in `_lv_cache_lru_rb.c`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "_lv_cache_2q_rb.h"
+#include "../../stdlib/lv_sprintf.h"
+#include "../../stdlib/lv_string.h"
+#include "../../tick/lv_tick.h"
+#include "../lv_ll.h"
+#include "../lv_rb.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*References in this period are considered as one (e.g. drawing the same image in the same frame)*/
+#define CORRELATED_REF_PERIOD   LV_DEF_REFR_PERIOD
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef uint32_t (get_data_size_cb_t)(const void * data);
+
+/*Stored after the cache entry in the nodes of the red-black tree*/
+typedef struct {
+    void * ll_node;         /*The node in `in_ll` or `main_ll`*/
+    uint32_t add_time;      /*When it was added to the cache*/
+    bool in_main;           /*true: it's in `main_ll`, false: it's in `in_ll`*/
+} node_ext_t;
+
+struct _lv_2q_rb_t {
+    lv_cache_t cache;
+
+    lv_rb_t rb;
+    lv_ll_t in_ll;          /*FIFO of the entries used only once*/
+    lv_ll_t main_ll;        /*LRU of the entries used more times*/
+    uint32_t in_size;       /*The size of the entries in `in_ll`*/
+
+    get_data_size_cb_t * get_data_size_cb;
+};
+typedef struct _lv_2q_rb_t lv_2q_rb_t_;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void * alloc_cb(void);
+static bool init_cnt_cb(lv_cache_t * cache);
+static bool init_size_cb(lv_cache_t * cache);
+static void  destroy_cb(lv_cache_t * cache, void * user_data);
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data);
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void drop_all_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data);
+
+static bool init_common(lv_2q_rb_t_ * q, get_data_size_cb_t * get_data_size_cb);
+static void unlink_node(lv_2q_rb_t_ * q, lv_rb_node_t * node);
+static lv_cache_entry_t * get_unused_tail(lv_2q_rb_t_ * q, lv_ll_t * ll);
+static void free_unused_nodes(lv_2q_rb_t_ * q, lv_ll_t * ll, void * user_data, uint32_t * used_cnt);
+inline static node_ext_t * get_node_ext(lv_2q_rb_t_ * q, lv_rb_node_t * node);
+
+static uint32_t cnt_get_data_size_cb(const void * data);
+static uint32_t size_get_data_size_cb(const void * data);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_cache_class_t lv_cache_class_2q_rb_count = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_cnt_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb
+};
+
+const lv_cache_class_t lv_cache_class_2q_rb_size = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_size_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb
+};
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+inline static node_ext_t * get_node_ext(lv_2q_rb_t_ * q, lv_rb_node_t * node)
+{
+    return (node_ext_t *)((char *)node->data + q->rb.size - sizeof(node_ext_t));
+}
+
+static void * alloc_cb(void)
+{
+    void * res = lv_malloc(sizeof(lv_2q_rb_t_));
+    LV_ASSERT_MALLOC(res);
+    if(res == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    lv_memzero(res, sizeof(lv_2q_rb_t_));
+    return res;
+}
+
+static bool init_common(lv_2q_rb_t_ * q, get_data_size_cb_t * get_data_size_cb)
+{
+    LV_ASSERT_NULL(q->cache.ops.compare_cb);
+    LV_ASSERT_NULL(q->cache.ops.free_cb);
+    LV_ASSERT(q->cache.node_size > 0);
+
+    if(q->cache.node_size <= 0 || q->cache.ops.compare_cb == NULL || q->cache.ops.free_cb == NULL) {
+        return false;
+    }
+
+    /*add node_ext_t to store the ll node pointer and the state*/
+    if(!lv_rb_init(&q->rb, q->cache.ops.compare_cb, lv_cache_entry_get_size(q->cache.node_size) + sizeof(node_ext_t))) {
+        return false;
+    }
+    _lv_ll_init(&q->in_ll, sizeof(void *));
+    _lv_ll_init(&q->main_ll, sizeof(void *));
+
+    q->get_data_size_cb = get_data_size_cb;
+
+    return true;
+}
+
+static bool init_cnt_cb(lv_cache_t * cache)
+{
+    return init_common((lv_2q_rb_t_ *)cache, cnt_get_data_size_cb);
+}
+
+static bool init_size_cb(lv_cache_t * cache)
+{
+    return init_common((lv_2q_rb_t_ *)cache, size_get_data_size_cb);
+}
+
+static void destroy_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_2q_rb_t_ * q = (lv_2q_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+
+    if(q == NULL) {
+        return;
+    }
+
+    cache->clz->drop_all_cb(cache, user_data);
+}
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_2q_rb_t_ * q = (lv_2q_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+    LV_ASSERT_NULL(key);
+
+    if(q == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&q->rb, key);
+    /*cache miss*/
+    if(node == NULL) {
+        return NULL;
+    }
+
+    node_ext_t * ext = get_node_ext(q, node);
+    if(ext->in_main) {
+        _lv_ll_move_before(&q->main_ll, ext->ll_node, _lv_ll_get_head(&q->main_ll));
+    }
+    else if(lv_tick_elaps(ext->add_time) >= CORRELATED_REF_PERIOD) {
+        /*Used again later, so move it to the frequently used ones*/
+        _lv_ll_chg_list(&q->in_ll, &q->main_ll, ext->ll_node, true);
+        ext->in_main = true;
+        q->in_size -= q->get_data_size_cb(node->data);
+    }
+
+    return lv_cache_entry_get_entry(node->data, cache->node_size);
+}
+
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_2q_rb_t_ * q = (lv_2q_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+    LV_ASSERT_NULL(key);
+
+    if(q == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_insert(&q->rb, (void *)key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    void * data = node->data;
+    lv_memcpy(data, key, cache->node_size);
+
+    void * ll_node = _lv_ll_ins_head(&q->in_ll);
+    if(ll_node == NULL) {
+        lv_rb_drop_node(&q->rb, node);
+        return NULL;
+    }
+    lv_memcpy(ll_node, &node, sizeof(void *));
+
+    node_ext_t * ext = get_node_ext(q, node);
+    ext->ll_node = ll_node;
+    ext->add_time = lv_tick_get();
+    ext->in_main = false;
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+    lv_cache_entry_init(entry, cache, cache->node_size);
+
+    uint32_t data_size = q->get_data_size_cb(key);
+    cache->size += data_size;
+    q->in_size += data_size;
+
+    return entry;
+}
+
+/**
+ * Remove a node from its queue and update the sizes but keep the node in the tree
+ */
+static void unlink_node(lv_2q_rb_t_ * q, lv_rb_node_t * node)
+{
+    node_ext_t * ext = get_node_ext(q, node);
+    uint32_t data_size = q->get_data_size_cb(node->data);
+
+    if(ext->in_main) {
+        _lv_ll_remove(&q->main_ll, ext->ll_node);
+    }
+    else {
+        _lv_ll_remove(&q->in_ll, ext->ll_node);
+        q->in_size -= data_size;
+    }
+    lv_free(ext->ll_node);
+
+    q->cache.size -= data_size;
+}
+
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_2q_rb_t_ * q = (lv_2q_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+    LV_ASSERT_NULL(entry);
+
+    if(q == NULL || entry == NULL) {
+        return;
+    }
+
+    void * data = lv_cache_entry_get_data(entry);
+    lv_rb_node_t * node = lv_rb_find(&q->rb, data);
+    if(node == NULL) {
+        return;
+    }
+
+    unlink_node(q, node);
+    lv_rb_remove_node(&q->rb, node);
+}
+
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    lv_2q_rb_t_ * q = (lv_2q_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+    LV_ASSERT_NULL(key);
+
+    if(q == NULL || key == NULL) {
+        return;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&q->rb, key);
+    if(node == NULL) {
+        return;
+    }
+
+    void * data = node->data;
+
+    q->cache.ops.free_cb(data, user_data);
+    unlink_node(q, node);
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+    lv_rb_remove_node(&q->rb, node);
+    lv_cache_entry_delete(entry);
+}
+
+static void free_unused_nodes(lv_2q_rb_t_ * q, lv_ll_t * ll, void * user_data, uint32_t * used_cnt)
+{
+    lv_rb_node_t ** node;
+    _LV_LL_READ(ll, node) {
+        /*free user handled data and do other clean up*/
+        void * search_key = (*node)->data;
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry(search_key, q->cache.node_size);
+        if(lv_cache_entry_get_ref(entry) == 0) {
+            q->cache.ops.free_cb(search_key, user_data);
+        }
+        else {
+            LV_LOG_WARN("entry (%p) is still referenced (%" LV_PRId32 ")", (void *)entry, lv_cache_entry_get_ref(entry));
+            (*used_cnt)++;
+        }
+    }
+}
+
+static void drop_all_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_2q_rb_t_ * q = (lv_2q_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+
+    if(q == NULL) {
+        return;
+    }
+
+    uint32_t used_cnt = 0;
+    free_unused_nodes(q, &q->in_ll, user_data, &used_cnt);
+    free_unused_nodes(q, &q->main_ll, user_data, &used_cnt);
+    if(used_cnt > 0) {
+        LV_LOG_WARN("%" LV_PRId32 " entries are still referenced", used_cnt);
+    }
+
+    lv_rb_destroy(&q->rb);
+    _lv_ll_clear(&q->in_ll);
+    _lv_ll_clear(&q->main_ll);
+
+    cache->size = 0;
+    q->in_size = 0;
+}
+
+static lv_cache_entry_t * get_unused_tail(lv_2q_rb_t_ * q, lv_ll_t * ll)
+{
+    lv_rb_node_t ** tail;
+    _LV_LL_READ_BACK(ll, tail) {
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry((*tail)->data, q->cache.node_size);
+        if(lv_cache_entry_get_ref(entry) == 0) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_2q_rb_t_ * q = (lv_2q_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+
+    /*Keep at most a quarter of the cache for the entries used only once*/
+    lv_cache_entry_t * entry = NULL;
+    if(q->in_size > cache->max_size / 4 || _lv_ll_is_empty(&q->main_ll)) {
+        entry = get_unused_tail(q, &q->in_ll);
+    }
+
+    if(entry == NULL) entry = get_unused_tail(q, &q->main_ll);
+    if(entry == NULL) entry = get_unused_tail(q, &q->in_ll);
+
+    return entry;
+}
+
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_2q_rb_t_ * q = (lv_2q_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(q);
+
+    if(q == NULL) {
+        return LV_CACHE_RESERVE_COND_ERROR;
+    }
+
+    uint32_t data_size = key ? q->get_data_size_cb(key) : 0;
+    if(data_size > q->cache.max_size) {
+        LV_LOG_ERROR("data size (%" LV_PRIu32 ") is larger than max size (%" LV_PRIu32 ")", data_size, q->cache.max_size);
+        return LV_CACHE_RESERVE_COND_TOO_LARGE;
+    }
+
+    return cache->size + reserved_size + data_size > q->cache.max_size
+           ? LV_CACHE_RESERVE_COND_NEED_VICTIM
+           : LV_CACHE_RESERVE_COND_OK;
+}
+
+static uint32_t cnt_get_data_size_cb(const void * data)
+{
+    LV_UNUSED(data);
+    return 1;
+}
+
+static uint32_t size_get_data_size_cb(const void * data)
+{
+    lv_cache_slot_size_t * slot = (lv_cache_slot_size_t *)data;
+    return slot->size;
+}
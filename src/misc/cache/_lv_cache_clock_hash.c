@@ -0,0 +1,638 @@
+/**
+* @file _lv_cache_clock_hash.c
+*
+*/
+
+/*
+ * Hash indexed cache: the entries are stored in an open addressing hash table with linear probing.
+ * The hash of the keys is calculated once by `hash_cb` when an entry is added and stored next to it,
+ * so `compare_cb` (e.g. `strcmp` on file paths) is called only on the entries with the same hash.
+ *
+ * The victims are selected by the CLOCK algorithm which approximates LRU: the entries are marked
+ * as visited when they are used, and the "hand" sweeping the table evicts the first not visited entry
+ * while clearing the marks of the visited ones. Unlike moving the entry in an LRU list, marking it
+ * doesn't need the lock.
+ *
+ * So with an OS the entries can be acquired without taking the cache lock.
+ * The readers only increment `reader_cnt` while looking up the entry and incrementing its reference count.
+ * The writers (holding the cache lock) remove the entries from the table first and before freeing them
+ * (or an old table after resizing) wait until there are no readers in the table.
+ * While a writer waits, the new readers fall back to the locked path, so the writers are not starved.
+ * An entry acquired by a reader while it was being removed is freed by `lv_cache_release`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "_lv_cache_clock_hash.h"
+#include "lv_cache_entry_private.h"
+#include "../lv_assert.h"
+#include "../../stdlib/lv_mem.h"
+#include "../../stdlib/lv_sprintf.h"
+#include "../../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Number of slots in a new table. Should be power of 2.*/
+#define TABLE_MIN_CAP   16
+
+/*Marks the slots of the removed entries to continue the probing after them*/
+#define REMOVED_SLOT    ((lv_cache_entry_t *)&removed_slot_marker)
+
+#if LV_CACHE_USE_ATOMIC
+    #define ATOMIC_LOAD(p)      __atomic_load_n(p, __ATOMIC_SEQ_CST)
+    #define ATOMIC_STORE(p, v)  __atomic_store_n(p, v, __ATOMIC_SEQ_CST)
+    #define ATOMIC_ADD(p, v)    __atomic_add_fetch(p, v, __ATOMIC_SEQ_CST)
+#else
+    #define ATOMIC_LOAD(p)      (*(p))
+    #define ATOMIC_STORE(p, v)  (*(p) = (v))
+    #define ATOMIC_ADD(p, v)    (*(p) += (v))
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef uint32_t (get_data_size_cb_t)(const void * data);
+
+/*Stored after the cache entry*/
+typedef struct {
+    uint32_t hash;          /*The hash of the key calculated when the entry was added*/
+    bool visited;           /*Used since the CLOCK hand passed it*/
+} node_ext_t;
+
+typedef struct {
+    uint32_t cap;                   /*Number of slots, power of 2*/
+    lv_cache_entry_t ** slots;      /*NULL: empty, `REMOVED_SLOT`: removed, else the entry*/
+} table_t;
+
+struct _lv_clock_hash_t {
+    lv_cache_t cache;
+
+    table_t * table;
+    uint32_t used_cnt;      /*Number of entries in the table*/
+    uint32_t removed_cnt;   /*Number of slots marked as removed*/
+    uint32_t hand;          /*The next slot to check by the CLOCK hand*/
+
+    int32_t reader_cnt;     /*Number of lock-free readers in the table*/
+    int32_t writer_waiting; /*A writer waits for the readers to leave the table*/
+
+    get_data_size_cb_t * get_data_size_cb;
+};
+typedef struct _lv_clock_hash_t lv_clock_hash_t_;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void * alloc_cb(void);
+static bool init_cnt_cb(lv_cache_t * cache);
+static bool init_size_cb(lv_cache_t * cache);
+static void  destroy_cb(lv_cache_t * cache, void * user_data);
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data);
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void drop_all_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data);
+#if LV_CACHE_USE_ATOMIC
+static lv_cache_entry_t * acquire_lock_free_cb(lv_cache_t * cache, const void * key, void * user_data);
+#endif
+
+static bool init_common(lv_clock_hash_t_ * ch, get_data_size_cb_t * get_data_size_cb);
+static table_t * table_create(uint32_t cap);
+static void table_insert(table_t * table, lv_cache_entry_t * entry, uint32_t hash);
+static lv_cache_entry_t * table_find(lv_clock_hash_t_ * ch, table_t * table, const void * key, uint32_t hash,
+                                     uint32_t * slot_idx);
+static bool reserve_slot(lv_clock_hash_t_ * ch);
+static void unlink_entry(lv_clock_hash_t_ * ch, uint32_t slot_idx);
+static void write_begin(lv_clock_hash_t_ * ch);
+static void write_end(lv_clock_hash_t_ * ch);
+inline static node_ext_t * get_ext(lv_clock_hash_t_ * ch, lv_cache_entry_t * entry);
+
+static uint32_t cnt_get_data_size_cb(const void * data);
+static uint32_t size_get_data_size_cb(const void * data);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_cache_class_t lv_cache_class_clock_hash_count = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_cnt_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb,
+#if LV_CACHE_USE_ATOMIC
+    .acquire_lock_free_cb = acquire_lock_free_cb,
+#endif
+};
+
+const lv_cache_class_t lv_cache_class_clock_hash_size = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_size_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb,
+#if LV_CACHE_USE_ATOMIC
+    .acquire_lock_free_cb = acquire_lock_free_cb,
+#endif
+};
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint8_t removed_slot_marker;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * alloc_cb(void)
+{
+    void * res = lv_malloc(sizeof(lv_clock_hash_t_));
+    LV_ASSERT_MALLOC(res);
+    if(res == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    lv_memzero(res, sizeof(lv_clock_hash_t_));
+    return res;
+}
+
+static bool init_cnt_cb(lv_cache_t * cache)
+{
+    return init_common((lv_clock_hash_t_ *)cache, cnt_get_data_size_cb);
+}
+
+static bool init_size_cb(lv_cache_t * cache)
+{
+    return init_common((lv_clock_hash_t_ *)cache, size_get_data_size_cb);
+}
+
+static bool init_common(lv_clock_hash_t_ * ch, get_data_size_cb_t * get_data_size_cb)
+{
+    LV_ASSERT_NULL(ch->cache.ops.compare_cb);
+    LV_ASSERT_NULL(ch->cache.ops.hash_cb);
+    LV_ASSERT_NULL(ch->cache.ops.free_cb);
+    LV_ASSERT(ch->cache.node_size > 0);
+
+    if(ch->cache.node_size <= 0 || ch->cache.ops.compare_cb == NULL || ch->cache.ops.hash_cb == NULL ||
+       ch->cache.ops.free_cb == NULL) {
+        return false;
+    }
+
+    ch->table = table_create(TABLE_MIN_CAP);
+    if(ch->table == NULL) {
+        return false;
+    }
+
+    ch->get_data_size_cb = get_data_size_cb;
+
+    return true;
+}
+
+static void destroy_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_clock_hash_t_ * ch = (lv_clock_hash_t_ *)cache;
+
+    LV_ASSERT_NULL(ch);
+
+    if(ch == NULL) {
+        return;
+    }
+
+    cache->clz->drop_all_cb(cache, user_data);
+
+    lv_free(ch->table);
+    ch->table = NULL;
+}
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_clock_hash_t_ * ch = (lv_clock_hash_t_ *)cache;
+
+    LV_ASSERT_NULL(ch);
+    LV_ASSERT_NULL(key);
+
+    if(ch == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_cache_entry_t * entry = table_find(ch, ch->table, key, cache->ops.hash_cb(key), NULL);
+    if(entry == NULL) {
+        return NULL;
+    }
+
+    ATOMIC_STORE(&get_ext(ch, entry)->visited, true);
+    return entry;
+}
+
+#if LV_CACHE_USE_ATOMIC
+static lv_cache_entry_t * acquire_lock_free_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_clock_hash_t_ * ch = (lv_clock_hash_t_ *)cache;
+
+    /*The data of the entries created by `create_cb` is set only after adding them, under the lock*/
+    if(cache->ops.create_cb != NULL) {
+        return NULL;
+    }
+
+    uint32_t hash = cache->ops.hash_cb(key);
+    lv_cache_entry_t * entry = NULL;
+
+    ATOMIC_ADD(&ch->reader_cnt, 1);
+    if(ATOMIC_LOAD(&ch->writer_waiting) == 0) {
+        entry = table_find(ch, ATOMIC_LOAD(&ch->table), key, hash, NULL);
+        if(entry) {
+            lv_cache_entry_acquire_data(entry);
+            ATOMIC_STORE(&get_ext(ch, entry)->visited, true);
+        }
+    }
+    ATOMIC_ADD(&ch->reader_cnt, -1);
+
+    return entry;
+}
+#endif
+
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_clock_hash_t_ * ch = (lv_clock_hash_t_ *)cache;
+
+    LV_ASSERT_NULL(ch);
+    LV_ASSERT_NULL(key);
+
+    if(ch == NULL || key == NULL) {
+        return NULL;
+    }
+
+    if(reserve_slot(ch) == false) {
+        return NULL;
+    }
+
+    uint32_t entry_size = lv_cache_entry_get_size(cache->node_size);
+    uint8_t * data = lv_malloc(entry_size + sizeof(node_ext_t));
+    LV_ASSERT_MALLOC(data);
+    if(data == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    lv_memcpy(data, key, cache->node_size);
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+    lv_cache_entry_init(entry, cache, cache->node_size);
+
+    node_ext_t * ext = get_ext(ch, entry);
+    ext->hash = cache->ops.hash_cb(key);
+    ext->visited = false;   /*Evicted first if it's not used again, like the entries used only once*/
+
+    /*Everything is set, it can be found by the readers now*/
+    table_insert(ch->table, entry, ext->hash);
+    ch->used_cnt++;
+
+    cache->size += ch->get_data_size_cb(key);
+
+    return entry;
+}
+
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_clock_hash_t_ * ch = (lv_clock_hash_t_ *)cache;
+
+    LV_ASSERT_NULL(ch);
+    LV_ASSERT_NULL(entry);
+
+    if(ch == NULL || entry == NULL) {
+        return;
+    }
+
+    table_t * table = ch->table;
+    uint32_t mask = table->cap - 1;
+    uint32_t i = get_ext(ch, entry)->hash & mask;
+    uint32_t n;
+    for(n = 0; n < table->cap && table->slots[i] != NULL; n++) {
+        if(table->slots[i] == entry) {
+            unlink_entry(ch, i);
+
+            /*The caller frees the entry, so wait for the readers which might have found it*/
+            write_begin(ch);
+            write_end(ch);
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    lv_clock_hash_t_ * ch = (lv_clock_hash_t_ *)cache;
+
+    LV_ASSERT_NULL(ch);
+    LV_ASSERT_NULL(key);
+
+    if(ch == NULL || key == NULL) {
+        return;
+    }
+
+    uint32_t slot_idx;
+    lv_cache_entry_t * entry = table_find(ch, ch->table, key, cache->ops.hash_cb(key), &slot_idx);
+    if(entry == NULL) {
+        return;
+    }
+
+    unlink_entry(ch, slot_idx);
+
+    write_begin(ch);
+    write_end(ch);
+
+    /*Acquired by a reader in the meantime, it will be freed when released*/
+    if(lv_cache_entry_get_ref(entry) != 0) {
+        lv_cache_entry_set_invalid(entry, true);
+        return;
+    }
+
+    cache->ops.free_cb(lv_cache_entry_get_data(entry), user_data);
+    lv_cache_entry_delete(entry);
+}
+
+static void drop_all_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_clock_hash_t_ * ch = (lv_clock_hash_t_ *)cache;
+
+    LV_ASSERT_NULL(ch);
+
+    if(ch == NULL) {
+        return;
+    }
+
+    /*Keep the readers out while freeing the entries*/
+    write_begin(ch);
+
+    table_t * table = ch->table;
+    uint32_t used_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < table->cap; i++) {
+        lv_cache_entry_t * entry = table->slots[i];
+        if(entry == NULL || entry == REMOVED_SLOT) {
+            continue;
+        }
+
+        /*free user handled data and do other clean up*/
+        if(lv_cache_entry_get_ref(entry) == 0) {
+            cache->ops.free_cb(lv_cache_entry_get_data(entry), user_data);
+        }
+        else {
+            LV_LOG_WARN("entry (%p) is still referenced (%" LV_PRId32 ")", (void *)entry, lv_cache_entry_get_ref(entry));
+            used_cnt++;
+        }
+
+        lv_cache_entry_delete(entry);
+    }
+    if(used_cnt > 0) {
+        LV_LOG_WARN("%" LV_PRId32 " entries are still referenced", used_cnt);
+    }
+
+    lv_memzero(table->slots, table->cap * sizeof(lv_cache_entry_t *));
+    ch->used_cnt = 0;
+    ch->removed_cnt = 0;
+    ch->hand = 0;
+    cache->size = 0;
+
+    write_end(ch);
+}
+
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_clock_hash_t_ * ch = (lv_clock_hash_t_ *)cache;
+
+    LV_ASSERT_NULL(ch);
+
+    table_t * table = ch->table;
+    uint32_t mask = table->cap - 1;
+
+    /*In the first round the visited entries are only marked as not visited*/
+    uint32_t n;
+    for(n = 0; n < table->cap * 2; n++) {
+        lv_cache_entry_t * entry = table->slots[ch->hand];
+        ch->hand = (ch->hand + 1) & mask;
+
+        if(entry == NULL || entry == REMOVED_SLOT || lv_cache_entry_get_ref(entry) != 0) {
+            continue;
+        }
+
+        node_ext_t * ext = get_ext(ch, entry);
+        if(ATOMIC_LOAD(&ext->visited)) {
+            ATOMIC_STORE(&ext->visited, false);
+            continue;
+        }
+
+        return entry;
+    }
+
+    return NULL;
+}
+
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_clock_hash_t_ * ch = (lv_clock_hash_t_ *)cache;
+
+    LV_ASSERT_NULL(ch);
+
+    if(ch == NULL) {
+        return LV_CACHE_RESERVE_COND_ERROR;
+    }
+
+    uint32_t data_size = key ? ch->get_data_size_cb(key) : 0;
+    if(data_size > ch->cache.max_size) {
+        LV_LOG_ERROR("data size (%" LV_PRIu32 ") is larger than max size (%" LV_PRIu32 ")", data_size, ch->cache.max_size);
+        return LV_CACHE_RESERVE_COND_TOO_LARGE;
+    }
+
+    return cache->size + reserved_size + data_size > ch->cache.max_size
+           ? LV_CACHE_RESERVE_COND_NEED_VICTIM
+           : LV_CACHE_RESERVE_COND_OK;
+}
+
+static table_t * table_create(uint32_t cap)
+{
+    table_t * table = lv_malloc_zeroed(sizeof(table_t) + cap * sizeof(lv_cache_entry_t *));
+    LV_ASSERT_MALLOC(table);
+    if(table == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    table->cap = cap;
+    table->slots = (lv_cache_entry_t **)(table + 1);
+    return table;
+}
+
+static void table_insert(table_t * table, lv_cache_entry_t * entry, uint32_t hash)
+{
+    uint32_t mask = table->cap - 1;
+    uint32_t i = hash & mask;
+    while(table->slots[i] != NULL && table->slots[i] != REMOVED_SLOT) {
+        i = (i + 1) & mask;
+    }
+
+    ATOMIC_STORE(&table->slots[i], entry);
+}
+
+/**
+ * Find the slot of an entry. Used by the writers and the lock-free readers too.
+ * @param ch        pointer to the cache
+ * @param table     the table to search in
+ * @param key       the key to find
+ * @param hash      hash of `key`
+ * @param slot_idx  store the index of the entry's slot here if not NULL
+ * @return          the entry or NULL if not found
+ */
+static lv_cache_entry_t * table_find(lv_clock_hash_t_ * ch, table_t * table, const void * key, uint32_t hash,
+                                     uint32_t * slot_idx)
+{
+    uint32_t mask = table->cap - 1;
+    uint32_t i = hash & mask;
+    uint32_t n;
+    for(n = 0; n < table->cap; n++) {
+        lv_cache_entry_t * entry = ATOMIC_LOAD(&table->slots[i]);
+        if(entry == NULL) {
+            break;
+        }
+
+        if(entry != REMOVED_SLOT && get_ext(ch, entry)->hash == hash &&
+           ch->cache.ops.compare_cb(lv_cache_entry_get_data(entry), key) == 0) {
+            if(slot_idx) *slot_idx = i;
+            return entry;
+        }
+
+        i = (i + 1) & mask;
+    }
+
+    return NULL;
+}
+
+/**
+ * Make sure there is a free slot and the table is at most half full, so the probing is short.
+ * Grow the table or just clean up the removed slots if needed.
+ * @param ch    pointer to the cache
+ * @return      false if the table needed to grow but it couldn't be allocated
+ */
+static bool reserve_slot(lv_clock_hash_t_ * ch)
+{
+    table_t * old_table = ch->table;
+    if((ch->used_cnt + ch->removed_cnt + 1) * 2 <= old_table->cap) {
+        return true;
+    }
+
+    uint32_t cap = old_table->cap;
+    while((ch->used_cnt + 1) * 4 > cap) {
+        cap *= 2;
+    }
+
+    table_t * new_table = table_create(cap);
+    if(new_table == NULL) {
+        return false;
+    }
+
+    uint32_t i;
+    for(i = 0; i < old_table->cap; i++) {
+        lv_cache_entry_t * entry = old_table->slots[i];
+        if(entry != NULL && entry != REMOVED_SLOT) {
+            table_insert(new_table, entry, get_ext(ch, entry)->hash);
+        }
+    }
+
+    ATOMIC_STORE(&ch->table, new_table);
+    ch->removed_cnt = 0;
+    ch->hand = 0;
+
+    /*Wait for the readers which might still be in the old table*/
+    write_begin(ch);
+    write_end(ch);
+    lv_free(old_table);
+
+    return true;
+}
+
+static void unlink_entry(lv_clock_hash_t_ * ch, uint32_t slot_idx)
+{
+    lv_cache_entry_t * entry = ch->table->slots[slot_idx];
+
+    ATOMIC_STORE(&ch->table->slots[slot_idx], REMOVED_SLOT);
+    ch->used_cnt--;
+    ch->removed_cnt++;
+
+    ch->cache.size -= ch->get_data_size_cb(lv_cache_entry_get_data(entry));
+}
+
+/**
+ * Send away the new readers and wait until the current ones leave the table.
+ * After this the removed entries and the old tables are not used by the readers anymore.
+ * @param ch    pointer to the cache
+ */
+static void write_begin(lv_clock_hash_t_ * ch)
+{
+    ATOMIC_STORE(&ch->writer_waiting, 1);
+    while(ATOMIC_LOAD(&ch->reader_cnt) != 0) {
+        /*The readers only look up an entry, so it's very short*/
+    }
+}
+
+static void write_end(lv_clock_hash_t_ * ch)
+{
+    ATOMIC_STORE(&ch->writer_waiting, 0);
+}
+
+inline static node_ext_t * get_ext(lv_clock_hash_t_ * ch, lv_cache_entry_t * entry)
+{
+    return (node_ext_t *)((uint8_t *)lv_cache_entry_get_data(entry) + lv_cache_entry_get_size(ch->cache.node_size));
+}
+
+static uint32_t cnt_get_data_size_cb(const void * data)
+{
+    LV_UNUSED(data);
+    return 1;
+}
+
+static uint32_t size_get_data_size_cb(const void * data)
+{
+    lv_cache_slot_size_t * slot = (lv_cache_slot_size_t *)data;
+    return slot->size;
+}
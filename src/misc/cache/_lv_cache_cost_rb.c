@@ -0,0 +1,427 @@
+/**
+* @file _lv_cache_cost_rb.c
+*
+*/
+
+/*
+ * Cost-aware cache based on the GreedyDual-Size algorithm: the victim is the entry with the
+ * smallest `L + cost / size` where `cost` is set by `lv_cache_entry_set_cost()` (e.g. the time
+ * of decoding an image), and `L` is the priority of the last victim at the time when the entry
+ * was added or used. This way the entries which are cheap to create again and use a lot of
+ * memory are evicted first, and the unused entries age as `L` increases.
+ *
+ * The entries are found in a red-black tree just like in `_lv_cache_lru_rb.c`, and they are also
+ * kept in an LRU list to evict the least recently used one from the entries of the same priority.
+ * Finding the victim is O(n) for the number of entries.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "_lv_cache_cost_rb.h"
+#include "../../stdlib/lv_sprintf.h"
+#include "../../stdlib/lv_string.h"
+#include "../lv_ll.h"
+#include "../lv_rb.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Fixed point shift of `cost / size` to not lose the cost of the large entries*/
+#define COST_SHIFT  24
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef uint32_t (get_data_size_cb_t)(const void * data);
+
+/*Stored after the cache entry in the nodes of the red-black tree*/
+typedef struct {
+    void * ll_node;         /*The node in the LRU list*/
+    uint64_t base;          /*`L` when it was added or used last time*/
+} node_ext_t;
+
+struct _lv_cost_rb_t {
+    lv_cache_t cache;
+
+    lv_rb_t rb;
+    lv_ll_t ll;
+    uint64_t inflation;     /*`L`, the priority of the last victim*/
+
+    get_data_size_cb_t * get_data_size_cb;
+};
+typedef struct _lv_cost_rb_t lv_cost_rb_t_;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void * alloc_cb(void);
+static bool init_cnt_cb(lv_cache_t * cache);
+static bool init_size_cb(lv_cache_t * cache);
+static void  destroy_cb(lv_cache_t * cache, void * user_data);
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data);
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data);
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data);
+static void drop_all_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data);
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data);
+
+static bool init_common(lv_cost_rb_t_ * c, get_data_size_cb_t * get_data_size_cb);
+static void unlink_node(lv_cost_rb_t_ * c, lv_rb_node_t * node);
+static uint64_t get_priority(lv_cost_rb_t_ * c, lv_rb_node_t * node);
+inline static node_ext_t * get_node_ext(lv_cost_rb_t_ * c, lv_rb_node_t * node);
+
+static uint32_t cnt_get_data_size_cb(const void * data);
+static uint32_t size_get_data_size_cb(const void * data);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_cache_class_t lv_cache_class_cost_rb_count = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_cnt_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb
+};
+
+const lv_cache_class_t lv_cache_class_cost_rb_size = {
+    .alloc_cb = alloc_cb,
+    .init_cb = init_size_cb,
+    .destroy_cb = destroy_cb,
+
+    .get_cb = get_cb,
+    .add_cb = add_cb,
+    .remove_cb = remove_cb,
+    .drop_cb = drop_cb,
+    .drop_all_cb = drop_all_cb,
+    .get_victim_cb = get_victim_cb,
+    .reserve_cond_cb = reserve_cond_cb
+};
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+inline static node_ext_t * get_node_ext(lv_cost_rb_t_ * c, lv_rb_node_t * node)
+{
+    return (node_ext_t *)((char *)node->data + c->rb.size - sizeof(node_ext_t));
+}
+
+static uint64_t get_priority(lv_cost_rb_t_ * c, lv_rb_node_t * node)
+{
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(node->data, c->cache.node_size);
+    uint32_t data_size = c->get_data_size_cb(node->data);
+    if(data_size == 0) data_size = 1;
+
+    return get_node_ext(c, node)->base + (((uint64_t)lv_cache_entry_get_cost(entry) << COST_SHIFT) / data_size);
+}
+
+static void * alloc_cb(void)
+{
+    void * res = lv_malloc(sizeof(lv_cost_rb_t_));
+    LV_ASSERT_MALLOC(res);
+    if(res == NULL) {
+        LV_LOG_ERROR("malloc failed");
+        return NULL;
+    }
+
+    lv_memzero(res, sizeof(lv_cost_rb_t_));
+    return res;
+}
+
+static bool init_common(lv_cost_rb_t_ * c, get_data_size_cb_t * get_data_size_cb)
+{
+    LV_ASSERT_NULL(c->cache.ops.compare_cb);
+    LV_ASSERT_NULL(c->cache.ops.free_cb);
+    LV_ASSERT(c->cache.node_size > 0);
+
+    if(c->cache.node_size <= 0 || c->cache.ops.compare_cb == NULL || c->cache.ops.free_cb == NULL) {
+        return false;
+    }
+
+    /*add node_ext_t to store the ll node pointer and the priority*/
+    if(!lv_rb_init(&c->rb, c->cache.ops.compare_cb, lv_cache_entry_get_size(c->cache.node_size) + sizeof(node_ext_t))) {
+        return false;
+    }
+    _lv_ll_init(&c->ll, sizeof(void *));
+
+    c->get_data_size_cb = get_data_size_cb;
+
+    return true;
+}
+
+static bool init_cnt_cb(lv_cache_t * cache)
+{
+    return init_common((lv_cost_rb_t_ *)cache, cnt_get_data_size_cb);
+}
+
+static bool init_size_cb(lv_cache_t * cache)
+{
+    return init_common((lv_cost_rb_t_ *)cache, size_get_data_size_cb);
+}
+
+static void destroy_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cost_rb_t_ * c = (lv_cost_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(c);
+
+    if(c == NULL) {
+        return;
+    }
+
+    cache->clz->drop_all_cb(cache, user_data);
+}
+
+static lv_cache_entry_t * get_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cost_rb_t_ * c = (lv_cost_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(c);
+    LV_ASSERT_NULL(key);
+
+    if(c == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&c->rb, key);
+    /*cache miss*/
+    if(node == NULL) {
+        return NULL;
+    }
+
+    node_ext_t * ext = get_node_ext(c, node);
+    ext->base = c->inflation;
+    _lv_ll_move_before(&c->ll, ext->ll_node, _lv_ll_get_head(&c->ll));
+
+    return lv_cache_entry_get_entry(node->data, cache->node_size);
+}
+
+static lv_cache_entry_t * add_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cost_rb_t_ * c = (lv_cost_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(c);
+    LV_ASSERT_NULL(key);
+
+    if(c == NULL || key == NULL) {
+        return NULL;
+    }
+
+    lv_rb_node_t * node = lv_rb_insert(&c->rb, (void *)key);
+    if(node == NULL) {
+        return NULL;
+    }
+
+    void * data = node->data;
+    lv_memcpy(data, key, cache->node_size);
+
+    void * ll_node = _lv_ll_ins_head(&c->ll);
+    if(ll_node == NULL) {
+        lv_rb_drop_node(&c->rb, node);
+        return NULL;
+    }
+    lv_memcpy(ll_node, &node, sizeof(void *));
+
+    node_ext_t * ext = get_node_ext(c, node);
+    ext->ll_node = ll_node;
+    ext->base = c->inflation;
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+    lv_cache_entry_init(entry, cache, cache->node_size);
+
+    cache->size += c->get_data_size_cb(key);
+
+    return entry;
+}
+
+/**
+ * Remove a node from the LRU list and update the size but keep the node in the tree
+ */
+static void unlink_node(lv_cost_rb_t_ * c, lv_rb_node_t * node)
+{
+    node_ext_t * ext = get_node_ext(c, node);
+    _lv_ll_remove(&c->ll, ext->ll_node);
+    lv_free(ext->ll_node);
+
+    c->cache.size -= c->get_data_size_cb(node->data);
+}
+
+static void remove_cb(lv_cache_t * cache, lv_cache_entry_t * entry, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cost_rb_t_ * c = (lv_cost_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(c);
+    LV_ASSERT_NULL(entry);
+
+    if(c == NULL || entry == NULL) {
+        return;
+    }
+
+    void * data = lv_cache_entry_get_data(entry);
+    lv_rb_node_t * node = lv_rb_find(&c->rb, data);
+    if(node == NULL) {
+        return;
+    }
+
+    unlink_node(c, node);
+    lv_rb_remove_node(&c->rb, node);
+}
+
+static void drop_cb(lv_cache_t * cache, const void * key, void * user_data)
+{
+    lv_cost_rb_t_ * c = (lv_cost_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(c);
+    LV_ASSERT_NULL(key);
+
+    if(c == NULL || key == NULL) {
+        return;
+    }
+
+    lv_rb_node_t * node = lv_rb_find(&c->rb, key);
+    if(node == NULL) {
+        return;
+    }
+
+    void * data = node->data;
+
+    c->cache.ops.free_cb(data, user_data);
+    unlink_node(c, node);
+
+    lv_cache_entry_t * entry = lv_cache_entry_get_entry(data, cache->node_size);
+    lv_rb_remove_node(&c->rb, node);
+    lv_cache_entry_delete(entry);
+}
+
+static void drop_all_cb(lv_cache_t * cache, void * user_data)
+{
+    lv_cost_rb_t_ * c = (lv_cost_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(c);
+
+    if(c == NULL) {
+        return;
+    }
+
+    uint32_t used_cnt = 0;
+    lv_rb_node_t ** node;
+    _LV_LL_READ(&c->ll, node) {
+        /*free user handled data and do other clean up*/
+        void * search_key = (*node)->data;
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry(search_key, cache->node_size);
+        if(lv_cache_entry_get_ref(entry) == 0) {
+            c->cache.ops.free_cb(search_key, user_data);
+        }
+        else {
+            LV_LOG_WARN("entry (%p) is still referenced (%" LV_PRId32 ")", (void *)entry, lv_cache_entry_get_ref(entry));
+            used_cnt++;
+        }
+    }
+    if(used_cnt > 0) {
+        LV_LOG_WARN("%" LV_PRId32 " entries are still referenced", used_cnt);
+    }
+
+    lv_rb_destroy(&c->rb);
+    _lv_ll_clear(&c->ll);
+
+    cache->size = 0;
+    c->inflation = 0;
+}
+
+static lv_cache_entry_t * get_victim_cb(lv_cache_t * cache, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cost_rb_t_ * c = (lv_cost_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(c);
+
+    lv_cache_entry_t * victim = NULL;
+    uint64_t victim_priority = UINT64_MAX;
+
+    /*From the least recently used to keep the older one if the priorities are the same*/
+    lv_rb_node_t ** tail;
+    _LV_LL_READ_BACK(&c->ll, tail) {
+        lv_cache_entry_t * entry = lv_cache_entry_get_entry((*tail)->data, cache->node_size);
+        if(lv_cache_entry_get_ref(entry) != 0) continue;
+
+        uint64_t priority = get_priority(c, *tail);
+        if(priority < victim_priority) {
+            victim = entry;
+            victim_priority = priority;
+        }
+    }
+
+    /*The remaining entries age relative to the victim*/
+    if(victim) c->inflation = victim_priority;
+
+    return victim;
+}
+
+static lv_cache_reserve_cond_res_t reserve_cond_cb(lv_cache_t * cache, const void * key, size_t reserved_size,
+                                                   void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    lv_cost_rb_t_ * c = (lv_cost_rb_t_ *)cache;
+
+    LV_ASSERT_NULL(c);
+
+    if(c == NULL) {
+        return LV_CACHE_RESERVE_COND_ERROR;
+    }
+
+    uint32_t data_size = key ? c->get_data_size_cb(key) : 0;
+    if(data_size > c->cache.max_size) {
+        LV_LOG_ERROR("data size (%" LV_PRIu32 ") is larger than max size (%" LV_PRIu32 ")", data_size, c->cache.max_size);
+        return LV_CACHE_RESERVE_COND_TOO_LARGE;
+    }
+
+    return cache->size + reserved_size + data_size > c->cache.max_size
+           ? LV_CACHE_RESERVE_COND_NEED_VICTIM
+           : LV_CACHE_RESERVE_COND_OK;
+}
+
+static uint32_t cnt_get_data_size_cb(const void * data)
+{
+    LV_UNUSED(data);
+    return 1;
+}
+
+static uint32_t size_get_data_size_cb(const void * data)
+{
+    lv_cache_slot_size_t * slot = (lv_cache_slot_size_t *)data;
+    return slot->size;
+}
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_cache.h"
 #include "../../stdlib/lv_sprintf.h"
+#include "../../stdlib/lv_string.h"
 #include "../lv_assert.h"
 #include "lv_cache_entry_private.h"
 
@@ -25,6 +26,7 @@
 static void cache_drop_internal_no_lock(lv_cache_t * cache, const void * key, void * user_data);
 static bool cache_evict_one_internal_no_lock(lv_cache_t * cache, void * user_data);
 static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const void * key, void * user_data);
+static void stats_inc(uint32_t * cnt);
 /**********************
  *  GLOBAL VARIABLES
  **********************/
@@ -53,6 +55,8 @@ lv_cache_t * lv_cache_create(const lv_cache_class_t * cache_class,
     cache->max_size = max_size;
     cache->size = 0;
     cache->ops = ops;
+    cache->name = NULL;
+    lv_memzero(&cache->stats, sizeof(cache->stats));
 
     if(cache->clz->init_cb(cache) == false) {
         LV_LOG_ERROR("Cache init failed");
@@ -83,18 +87,34 @@ lv_cache_entry_t * lv_cache_acquire(lv_cache_t * cache, const void * key, void *
 
     LV_PROFILER_BEGIN;
 
+    lv_cache_entry_t * entry;
+    if(cache->clz->acquire_lock_free_cb) {
+        entry = cache->clz->acquire_lock_free_cb(cache, key, user_data);
+        if(entry != NULL) {
+            stats_inc(&cache->stats.hit_cnt);
+
+            LV_PROFILER_END;
+            return entry;
+        }
+    }
+
     lv_mutex_lock(&cache->lock);
 
     if(cache->size == 0) {
+        stats_inc(&cache->stats.miss_cnt);
         lv_mutex_unlock(&cache->lock);
 
         LV_PROFILER_END;
         return NULL;
     }
 
-    lv_cache_entry_t * entry = cache->clz->get_cb(cache, key, user_data);
+    entry = cache->clz->get_cb(cache, key, user_data);
     if(entry != NULL) {
         lv_cache_entry_acquire_data(entry);
+        stats_inc(&cache->stats.hit_cnt);
+    }
+    else {
+        stats_inc(&cache->stats.miss_cnt);
     }
     lv_mutex_unlock(&cache->lock);
 
@@ -149,13 +169,24 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
 
     LV_PROFILER_BEGIN;
 
-    lv_mutex_lock(&cache->lock);
     lv_cache_entry_t * entry = NULL;
+    if(cache->clz->acquire_lock_free_cb) {
+        entry = cache->clz->acquire_lock_free_cb(cache, key, user_data);
+        if(entry != NULL) {
+            stats_inc(&cache->stats.hit_cnt);
+
+            LV_PROFILER_END;
+            return entry;
+        }
+    }
+
+    lv_mutex_lock(&cache->lock);
 
     if(cache->size != 0) {
         entry = cache->clz->get_cb(cache, key, user_data);
         if(entry != NULL) {
             lv_cache_entry_acquire_data(entry);
+            stats_inc(&cache->stats.hit_cnt);
             lv_mutex_unlock(&cache->lock);
 
             LV_PROFILER_END;
@@ -163,6 +194,8 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
         }
     }
 
+    stats_inc(&cache->stats.miss_cnt);
+
     if(cache->max_size == 0) {
         lv_mutex_unlock(&cache->lock);
 
@@ -282,6 +315,22 @@ void lv_cache_set_free_cb(lv_cache_t * cache, lv_cache_free_cb_t free_cb, void *
     LV_UNUSED(user_data);
     cache->ops.free_cb = free_cb;
 }
+void lv_cache_get_stats(lv_cache_t * cache, lv_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(cache);
+
+    lv_mutex_lock(&cache->lock);
+    *stats = cache->stats;
+    lv_mutex_unlock(&cache->lock);
+}
+void lv_cache_reset_stats(lv_cache_t * cache)
+{
+    LV_ASSERT_NULL(cache);
+
+    lv_mutex_lock(&cache->lock);
+    lv_memzero(&cache->stats, sizeof(cache->stats));
+    lv_mutex_unlock(&cache->lock);
+}
 void lv_cache_set_name(lv_cache_t * cache, const char * name)
 {
     if(cache == NULL) return;
@@ -303,14 +352,15 @@ static void cache_drop_internal_no_lock(lv_cache_t * cache, const void * key, vo
         return;
     }
 
+    /*Remove it first, as it might be acquired without locking till it's removed*/
+    cache->clz->remove_cb(cache, entry, user_data);
+
     if(lv_cache_entry_get_ref(entry) == 0) {
-        cache->clz->remove_cb(cache, entry, user_data);
         cache->ops.free_cb(lv_cache_entry_get_data(entry), user_data);
         lv_cache_entry_delete(entry);
     }
     else {
         lv_cache_entry_set_invalid(entry, true);
-        cache->clz->remove_cb(cache, entry, user_data);
     }
 }
 
@@ -324,13 +374,25 @@ static bool cache_evict_one_internal_no_lock(lv_cache_t * cache, void * user_dat
     }
 
     cache->clz->remove_cb(cache, victim, user_data);
-    cache->ops.free_cb(lv_cache_entry_get_data(victim), user_data);
-    lv_cache_entry_delete(victim);
+
+    /*Acquired without locking before it was removed. Free it when it's released.*/
+    if(lv_cache_entry_get_ref(victim) != 0) {
+        lv_cache_entry_set_invalid(victim, true);
+    }
+    else {
+        cache->ops.free_cb(lv_cache_entry_get_data(victim), user_data);
+        lv_cache_entry_delete(victim);
+    }
+    stats_inc(&cache->stats.evict_cnt);
     return true;
 }
 
 static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const void * key, void * user_data)
 {
+    /*Another thread might have added the same data in the meantime (e.g. decoded the same image).
+     *Replace the old entry to not leak its data. It's freed when it's not used anymore.*/
+    cache_drop_internal_no_lock(cache, key, user_data);
+
     lv_cache_reserve_cond_res_t reserve_cond_res = cache->clz->reserve_cond_cb(cache, key, 0, user_data);
     if(reserve_cond_res == LV_CACHE_RESERVE_COND_TOO_LARGE) {
         LV_LOG_ERROR("data %p is too large that exceeds max size (%" LV_PRIu32 ")", key, cache->max_size);
@@ -346,3 +408,13 @@ static lv_cache_entry_t * cache_add_internal_no_lock(lv_cache_t * cache, const v
 
     return entry;
 }
+
+static void stats_inc(uint32_t * cnt)
+{
+#if LV_CACHE_USE_ATOMIC
+    /*The hits of the lock-free path are counted without locking*/
+    __atomic_add_fetch(cnt, 1, __ATOMIC_RELAXED);
+#else
+    (*cnt)++;
+#endif
+}
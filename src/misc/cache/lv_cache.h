@@ -18,6 +18,9 @@ extern "C" {
 #include "../lv_types.h"
 
 #include "_lv_cache_lru_rb.h"
+#include "_lv_cache_2q_rb.h"
+#include "_lv_cache_cost_rb.h"
+#include "_lv_cache_clock_hash.h"
 
 #include "lv_image_cache.h"
 #include "lv_image_header_cache.h"
@@ -35,13 +38,17 @@ extern "C" {
 
 /**
  * Create a cache object with the given parameters.
- * @param cache_class   The class of the cache. Currently only support one two builtin classes:
- *                          @lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
- *                          @lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy.
+ * @param cache_class   The class of the cache. The builtin classes are:
+ *                          @lv_cache_class_lru_rb_count/size: evict the least recently used entry.
+ *                          @lv_cache_class_2q_rb_count/size: keep the entries used more times when many entries are used only once.
+ *                          @lv_cache_class_cost_rb_count/size: evict the entry with the smallest cost per size,
+ *                          see @lv_cache_entry_set_cost.
+ *                          @lv_cache_class_clock_hash_count/size: approximate LRU with a hash table,
+ *                          the entries are acquired without locking if there is an OS. Needs `hash_cb`.
  * @param node_size     The node size is the size of the data stored in the cache..
  * @param max_size      The max size is the maximum amount of memory or count that the cache can hold.
- *                          @lv_cache_class_lru_rb_count: max_size is the maximum count of nodes in the cache.
- *                          @lv_cache_class_lru_rb_size: max_size is the maximum size of the cache in bytes.
+ *                          `*_count`: max_size is the maximum count of nodes in the cache.
+ *                          `*_size`: max_size is the maximum size of the cache in bytes.
  * @param ops           A set of operations that can be performed on the cache. See @lv_cache_ops_t for details.
  * @return              Returns a pointer to the created cache object on success, @NULL on error.
  */
@@ -81,6 +88,7 @@ lv_cache_entry_t * lv_cache_acquire_or_create(lv_cache_t * cache, const void * k
 
 /**
  * Add a new cache entry with the given key and data. If the cache is full, the cache's policy will be used to evict an entry.
+ * If an entry with the same key already exists, it will be dropped first.
  * @param cache         The cache object pointer to add the entry.
  * @param key           The key of the entry to add.
  * @param user_data     A user data pointer that will be passed to the create callback.
@@ -201,6 +209,19 @@ void   lv_cache_set_create_cb(lv_cache_t * cache, lv_cache_create_cb_t alloc_cb,
  */
 void   lv_cache_set_free_cb(lv_cache_t * cache, lv_cache_free_cb_t free_cb, void * user_data);
 
+/**
+ * Get the hit, miss and eviction counters of the cache.
+ * @param cache         The cache object pointer to get the counters of.
+ * @param stats         Pointer to store the counters.
+ */
+void lv_cache_get_stats(lv_cache_t * cache, lv_cache_stats_t * stats);
+
+/**
+ * Reset the hit, miss and eviction counters of the cache to 0.
+ * @param cache         The cache object pointer to reset the counters of.
+ */
+void lv_cache_reset_stats(lv_cache_t * cache);
+
 /**
  * Give a name for a cache object. Only the pointer of the string is saved.
  * @param cache         The cache object pointer to set the name.
@@ -23,6 +23,7 @@ struct _lv_cache_entry_t {
     const lv_cache_t * cache;
     int32_t ref_cnt;
     uint32_t node_size;
+    uint32_t cost;
 
     bool is_invalid;
 };
@@ -49,26 +50,43 @@ struct _lv_cache_entry_t {
 void lv_cache_entry_reset_ref(lv_cache_entry_t * entry)
 {
     LV_ASSERT_NULL(entry);
+#if LV_CACHE_USE_ATOMIC
+    __atomic_store_n(&entry->ref_cnt, 0, __ATOMIC_SEQ_CST);
+#else
     entry->ref_cnt = 0;
+#endif
 }
 void lv_cache_entry_inc_ref(lv_cache_entry_t * entry)
 {
     LV_ASSERT_NULL(entry);
+#if LV_CACHE_USE_ATOMIC
+    /*The lock-free readers might increment it at the same time*/
+    __atomic_add_fetch(&entry->ref_cnt, 1, __ATOMIC_SEQ_CST);
+#else
     entry->ref_cnt++;
+#endif
 }
 void lv_cache_entry_dec_ref(lv_cache_entry_t * entry)
 {
     LV_ASSERT_NULL(entry);
-    entry->ref_cnt--;
-    if(entry->ref_cnt < 0) {
-        LV_LOG_WARN("ref_cnt(%" LV_PRIu32 ") < 0", entry->ref_cnt);
-        entry->ref_cnt = 0;
+#if LV_CACHE_USE_ATOMIC
+    int32_t ref_cnt = __atomic_sub_fetch(&entry->ref_cnt, 1, __ATOMIC_SEQ_CST);
+#else
+    int32_t ref_cnt = --entry->ref_cnt;
+#endif
+    if(ref_cnt < 0) {
+        LV_LOG_WARN("ref_cnt(%" LV_PRIu32 ") < 0", ref_cnt);
+        lv_cache_entry_reset_ref(entry);
     }
 }
 int32_t lv_cache_entry_get_ref(lv_cache_entry_t * entry)
 {
     LV_ASSERT_NULL(entry);
+#if LV_CACHE_USE_ATOMIC
+    return __atomic_load_n(&entry->ref_cnt, __ATOMIC_SEQ_CST);
+#else
     return entry->ref_cnt;
+#endif
 }
 uint32_t lv_cache_entry_get_node_size(lv_cache_entry_t * entry)
 {
@@ -89,6 +107,16 @@ bool lv_cache_entry_is_invalid(lv_cache_entry_t * entry)
     LV_ASSERT_NULL(entry);
     return entry->is_invalid;
 }
+void lv_cache_entry_set_cost(lv_cache_entry_t * entry, uint32_t cost)
+{
+    LV_ASSERT_NULL(entry);
+    entry->cost = cost;
+}
+uint32_t lv_cache_entry_get_cost(lv_cache_entry_t * entry)
+{
+    LV_ASSERT_NULL(entry);
+    return entry->cost;
+}
 void * lv_cache_entry_get_data(lv_cache_entry_t * entry)
 {
     LV_ASSERT_NULL(entry);
@@ -97,6 +125,7 @@ void * lv_cache_entry_get_data(lv_cache_entry_t * entry)
 void * lv_cache_entry_acquire_data(lv_cache_entry_t * entry)
 {
     LV_ASSERT_NULL(entry);
+    if(entry == NULL) return NULL;
 
     lv_cache_entry_inc_ref(entry);
     return lv_cache_entry_get_data(entry);
@@ -106,8 +135,10 @@ void lv_cache_entry_release_data(lv_cache_entry_t * entry, void * user_data)
     LV_UNUSED(user_data);
 
     LV_ASSERT_NULL(entry);
+    if(entry == NULL) return;
+
     if(lv_cache_entry_get_ref(entry) == 0) {
-        LV_LOG_ERROR("ref_cnt(%" LV_PRIu32 ") == 0", entry->ref_cnt);
+        LV_LOG_ERROR("ref_cnt(%" LV_PRIu32 ") == 0", lv_cache_entry_get_ref(entry));
         return;
     }
 
@@ -153,6 +184,7 @@ void lv_cache_entry_init(lv_cache_entry_t * entry, const lv_cache_t * cache, con
     entry->cache = cache;
     entry->node_size = node_size;
     entry->ref_cnt = 0;
+    entry->cost = 1;
     entry->is_invalid = false;
 }
 void lv_cache_entry_delete(lv_cache_entry_t * entry)
@@ -56,6 +56,22 @@ uint32_t lv_cache_entry_get_node_size(lv_cache_entry_t * entry);
  */
 bool     lv_cache_entry_is_invalid(lv_cache_entry_t * entry);
 
+/**
+ * Set the cost of creating the data of a cache entry again, e.g. the time of decoding an image in milliseconds.
+ * It's used by the cost-aware caches (@lv_cache_class_cost_rb_count and @lv_cache_class_cost_rb_size)
+ * to keep the entries which are expensive to create. The default cost is 1.
+ * @param entry        The cache entry to set the cost of.
+ * @param cost         The cost of the cache entry.
+ */
+void     lv_cache_entry_set_cost(lv_cache_entry_t * entry, uint32_t cost);
+
+/**
+ * Get the cost of a cache entry set by @lv_cache_entry_set_cost.
+ * @param entry        The cache entry to get the cost of.
+ * @return             The cost of the cache entry.
+ */
+uint32_t lv_cache_entry_get_cost(lv_cache_entry_t * entry);
+
 /**
  * Get the data of a cache entry.
  * @param entry        The cache entry to get the data of.
@@ -20,6 +20,13 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/*The lock-free read path of the cache classes needs atomic operations which are used only with an OS*/
+#if LV_USE_OS != LV_OS_NONE && defined(__GNUC__)
+    #define LV_CACHE_USE_ATOMIC 1
+#else
+    #define LV_CACHE_USE_ATOMIC 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -48,6 +55,7 @@ typedef int8_t lv_cache_compare_res_t;
 typedef bool (*lv_cache_create_cb_t)(void * node, void * user_data);
 typedef void (*lv_cache_free_cb_t)(void * node, void * user_data);
 typedef lv_cache_compare_res_t (*lv_cache_compare_cb_t)(const void * a, const void * b);
+typedef uint32_t (*lv_cache_hash_cb_t)(const void * key);
 
 /**
  * The cache instance allocation function, used by the cache class to allocate memory for cache instances.
@@ -72,6 +80,14 @@ typedef void (*lv_cache_destroy_cb_t)(lv_cache_t * cache, void * user_data);
  */
 typedef lv_cache_entry_t * (*lv_cache_get_cb_t)(lv_cache_t * cache, const void * key, void * user_data);
 
+/**
+ * The cache lock-free acquire function, used by the cache class to find a cache entry and increment its reference
+ * count without holding the cache lock.
+ * @return @NULL if the key is not found or the entry can't be acquired now. The cache lock is taken in this case.
+ */
+typedef lv_cache_entry_t * (*lv_cache_acquire_lock_free_cb_t)(lv_cache_t * cache, const void * key,
+                                                                void * user_data);
+
 /**
  * The cache add function, used by the cache class to add a cache entry with a given key.
  * This function only cares about how to add the entry, it doesn't check if the entry already exists and doesn't care about is it a victim or not.
@@ -107,6 +123,15 @@ typedef lv_cache_entry_t * (*lv_cache_get_victim_cb)(lv_cache_t * cache, void *
 typedef lv_cache_reserve_cond_res_t (*lv_cache_reserve_cond_cb)(lv_cache_t * cache, const void * key, size_t size,
                                                                 void * user_data);
 
+/**
+ * The cache statistics, see @lv_cache_get_stats
+ */
+typedef struct {
+    uint32_t hit_cnt;                    /**< Number of times an entry was found by @lv_cache_acquire or @lv_cache_acquire_or_create */
+    uint32_t miss_cnt;                   /**< Number of times an entry was not found by them */
+    uint32_t evict_cnt;                  /**< Number of entries evicted to make room for the new ones */
+} lv_cache_stats_t;
+
 /**
  * The cache operations struct
  */
@@ -114,15 +139,20 @@ struct _lv_cache_ops_t {
     lv_cache_compare_cb_t compare_cb;    /**< Compare function for keys */
     lv_cache_create_cb_t create_cb;      /**< Create function for nodes */
     lv_cache_free_cb_t free_cb;          /**< Free function for nodes */
+    lv_cache_hash_cb_t hash_cb;          /**< Hash function for keys, needed by the hash-based classes.
+                                          *   The keys which are equal by `compare_cb` must have the same hash. */
 };
 
 /**
  * The cache entry struct
  */
 struct _lv_cache_t {
-    const lv_cache_class_t * clz;     /**< The cache class. There are two built-in classes:
-                                       * @lv_cache_class_lru_rb_count for LRU-based cache with count-based eviction policy.
-                                       * @lv_cache_class_lru_rb_size for LRU-based cache with size-based eviction policy. */
+    const lv_cache_class_t * clz;     /**< The cache class. The built-in classes are:
+                                       * @lv_cache_class_lru_rb_count/size for LRU-based cache,
+                                       * @lv_cache_class_2q_rb_count/size for scan resistant 2Q cache,
+                                       * @lv_cache_class_cost_rb_count/size for cost-aware cache,
+                                       * @lv_cache_class_clock_hash_count/size for hash indexed cache with lock-free lookup,
+                                       * with count or size-based eviction policy. */
 
     uint32_t node_size;               /**< The size of a node */
 
@@ -134,6 +164,8 @@ struct _lv_cache_t {
     lv_mutex_t lock;                  /**< The cache lock used to protect the cache in multithreading environments */
 
     const char * name;                /**< The name of the cache */
+
+    lv_cache_stats_t stats;           /**< The hit, miss and eviction counters */
 };
 
 /**
@@ -153,6 +185,8 @@ struct _lv_cache_class_t {
     lv_cache_drop_all_cb_t drop_all_cb;              /**< The drop all function for cache entries */
     lv_cache_get_victim_cb get_victim_cb;         /**< The get victim function for cache entries */
     lv_cache_reserve_cond_cb reserve_cond_cb;     /**< The reserve condition function for cache entries */
+
+    lv_cache_acquire_lock_free_cb_t acquire_lock_free_cb; /**< Optional function to acquire entries without locking */
 };
 
 /*-----------------
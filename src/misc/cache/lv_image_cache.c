@@ -21,6 +21,19 @@
 
 #define img_cache_p (LV_GLOBAL_DEFAULT()->img_cache)
 
+#if LV_IMAGE_CACHE_POLICY == LV_CACHE_POLICY_2Q
+    #define CACHE_CLASS lv_cache_class_2q_rb_size
+#elif LV_IMAGE_CACHE_POLICY == LV_CACHE_POLICY_COST
+    #define CACHE_CLASS lv_cache_class_cost_rb_size
+#elif LV_IMAGE_CACHE_POLICY == LV_CACHE_POLICY_HASH
+    #define CACHE_CLASS lv_cache_class_clock_hash_size
+#else
+    #define CACHE_CLASS lv_cache_class_lru_rb_size
+#endif
+
+/*Matches the whole image and all of its tiles*/
+#define TILE_ID_ANY UINT32_MAX
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -29,6 +42,7 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static uint32_t image_cache_hash_cb(const lv_image_cache_data_t * key);
 static lv_cache_compare_res_t image_cache_compare_cb(const lv_image_cache_data_t * lhs,
                                                      const lv_image_cache_data_t * rhs);
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data);
@@ -55,9 +69,10 @@ lv_result_t lv_image_cache_init(uint32_t size)
         return LV_RESULT_OK;
     }
 
-    img_cache_p = lv_cache_create(&lv_cache_class_lru_rb_size,
+    img_cache_p = lv_cache_create(&CACHE_CLASS,
     sizeof(lv_image_cache_data_t), size, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_cache_compare_cb,
+        .hash_cb = (lv_cache_hash_cb_t) image_cache_hash_cb,
         .create_cb = NULL,
         .free_cb = (lv_cache_free_cb_t) image_cache_free_cb,
     });
@@ -89,7 +104,18 @@ void lv_image_cache_drop(const void * src)
         .src_type = lv_image_src_get_type(src),
     };
 
+#if LV_IMAGE_DECODER_TILE_SIZE
+    /*Drop the tiles too if it was decoded in tiles.
+     *Don't read the image's header here as the source might be already freed.*/
+    search_key.tile_id = TILE_ID_ANY;
+    lv_cache_entry_t * entry;
+    while((entry = lv_cache_acquire(img_cache_p, &search_key, NULL)) != NULL) {
+        lv_cache_release(img_cache_p, entry, NULL);
+        lv_cache_drop(img_cache_p, &search_key, NULL);
+    }
+#else
     lv_cache_drop(img_cache_p, &search_key, NULL);
+#endif
 }
 
 bool lv_image_cache_is_enabled(void)
@@ -121,11 +147,41 @@ inline static lv_cache_compare_res_t image_cache_common_compare(const void * lhs
     return lhs_src_type > rhs_src_type ? 1 : -1;
 }
 
+inline static uint32_t image_cache_common_hash(const void * src, lv_image_src_t src_type)
+{
+    if(src_type == LV_IMAGE_SRC_FILE) {
+        /*FNV-1a*/
+        uint32_t hash = 2166136261U;
+        const uint8_t * c;
+        for(c = src; *c != '\0'; c++) {
+            hash = (hash ^ *c) * 16777619U;
+        }
+        return hash;
+    }
+    else if(src_type == LV_IMAGE_SRC_VARIABLE) {
+        /*The low bits of the pointers are usually 0 due to the alignment*/
+        lv_uintptr_t v = (lv_uintptr_t)src;
+        return (uint32_t)((v >> 3) ^ (v >> 12));
+    }
+    return src_type;
+}
+
+static uint32_t image_cache_hash_cb(const lv_image_cache_data_t * key)
+{
+    /*The tiles of an image have the same hash as they need to be found by `TILE_ID_ANY` too*/
+    return image_cache_common_hash(key->src, key->src_type);
+}
+
 static lv_cache_compare_res_t image_cache_compare_cb(
     const lv_image_cache_data_t * lhs,
     const lv_image_cache_data_t * rhs)
 {
-    return image_cache_common_compare(lhs->src, lhs->src_type, rhs->src, rhs->src_type);
+    lv_cache_compare_res_t res = image_cache_common_compare(lhs->src, lhs->src_type, rhs->src, rhs->src_type);
+    if(res != 0) return res;
+
+    if(lhs->tile_id == TILE_ID_ANY || rhs->tile_id == TILE_ID_ANY) return 0;
+    if(lhs->tile_id != rhs->tile_id) return lhs->tile_id > rhs->tile_id ? 1 : -1;
+    return 0;
 }
 
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data)
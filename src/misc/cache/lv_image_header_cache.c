@@ -20,6 +20,16 @@
 
 #define img_header_cache_p (LV_GLOBAL_DEFAULT()->img_header_cache)
 
+#if LV_IMAGE_HEADER_CACHE_POLICY == LV_CACHE_POLICY_2Q
+    #define CACHE_CLASS lv_cache_class_2q_rb_count
+#elif LV_IMAGE_HEADER_CACHE_POLICY == LV_CACHE_POLICY_COST
+    #define CACHE_CLASS lv_cache_class_cost_rb_count
+#elif LV_IMAGE_HEADER_CACHE_POLICY == LV_CACHE_POLICY_HASH
+    #define CACHE_CLASS lv_cache_class_clock_hash_count
+#else
+    #define CACHE_CLASS lv_cache_class_lru_rb_count
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -28,6 +38,7 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static uint32_t image_header_cache_hash_cb(const lv_image_header_cache_data_t * key);
 static lv_cache_compare_res_t image_header_cache_compare_cb(const lv_image_header_cache_data_t * lhs,
                                                             const lv_image_header_cache_data_t * rhs);
 static void image_header_cache_free_cb(lv_image_header_cache_data_t * entry, void * user_data);
@@ -54,9 +65,10 @@ lv_result_t lv_image_header_cache_init(uint32_t count)
         return LV_RESULT_OK;
     }
 
-    img_header_cache_p = lv_cache_create(&lv_cache_class_lru_rb_count,
+    img_header_cache_p = lv_cache_create(&CACHE_CLASS,
     sizeof(lv_image_header_cache_data_t), count, (lv_cache_ops_t) {
         .compare_cb = (lv_cache_compare_cb_t) image_header_cache_compare_cb,
+        .hash_cb = (lv_cache_hash_cb_t) image_header_cache_hash_cb,
         .create_cb = NULL,
         .free_cb = (lv_cache_free_cb_t) image_header_cache_free_cb
     });
@@ -117,6 +129,30 @@ inline static lv_cache_compare_res_t image_cache_common_compare(const void * lhs
     return lhs_src_type > rhs_src_type ? 1 : -1;
 }
 
+inline static uint32_t image_cache_common_hash(const void * src, lv_image_src_t src_type)
+{
+    if(src_type == LV_IMAGE_SRC_FILE) {
+        /*FNV-1a*/
+        uint32_t hash = 2166136261U;
+        const uint8_t * c;
+        for(c = src; *c != '\0'; c++) {
+            hash = (hash ^ *c) * 16777619U;
+        }
+        return hash;
+    }
+    else if(src_type == LV_IMAGE_SRC_VARIABLE) {
+        /*The low bits of the pointers are usually 0 due to the alignment*/
+        lv_uintptr_t v = (lv_uintptr_t)src;
+        return (uint32_t)((v >> 3) ^ (v >> 12));
+    }
+    return src_type;
+}
+
+static uint32_t image_header_cache_hash_cb(const lv_image_header_cache_data_t * key)
+{
+    return image_cache_common_hash(key->src, key->src_type);
+}
+
 static lv_cache_compare_res_t image_header_cache_compare_cb(
     const lv_image_header_cache_data_t * lhs,
     const lv_image_header_cache_data_t * rhs)
@@ -23,6 +23,7 @@
 #define LV_ANIM_RES_SHIFT 10
 #define state LV_GLOBAL_DEFAULT()->anim_state
 #define anim_ll_p &(state.anim_ll)
+#define VAR_BUCKET_CNT_MIN 32
 
 /**********************
  *      TYPEDEFS
@@ -39,6 +40,13 @@ static int32_t lv_anim_path_cubic_bezier(const lv_anim_t * a, int32_t x1,
 static uint32_t convert_speed_to_time(uint32_t speed, int32_t start, int32_t end);
 static void resolve_time(lv_anim_t * a);
 static bool remove_concurrent_anims(lv_anim_t * a_current);
+static void anim_remove(lv_anim_t * a);
+static void anim_iter_begin(void);
+static void anim_iter_end(void);
+static uint32_t var_hash(const void * var, uint32_t bucket_cnt);
+static void var_index_add(lv_anim_t * a);
+static void var_index_remove(lv_anim_t * a);
+static void var_index_grow(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -60,15 +68,23 @@ static bool remove_concurrent_anims(lv_anim_t * a_current);
 void _lv_anim_core_init(void)
 {
     _lv_ll_init(anim_ll_p, sizeof(lv_anim_t));
+    state.anim_var_buckets = lv_malloc_zeroed(VAR_BUCKET_CNT_MIN * sizeof(lv_anim_t *));
+    LV_ASSERT_MALLOC(state.anim_var_buckets);
+    state.anim_var_bucket_cnt = VAR_BUCKET_CNT_MIN;
+    state.anim_cnt = 0;
+    state.anim_iter_depth = 0;
+    state.anim_has_deleted = false;
     state.timer = lv_timer_create(anim_timer, LV_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
-    state.anim_list_changed = false;
     state.anim_run_round = false;
 }
 
 void _lv_anim_core_deinit(void)
 {
     lv_anim_delete_all();
+    lv_free(state.anim_var_buckets);
+    state.anim_var_buckets = NULL;
+    state.anim_var_bucket_cnt = 0;
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -96,6 +112,12 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     if(a->var == a) new_anim->var = new_anim;
     new_anim->run_round = state.anim_run_round;
     new_anim->last_timer_run = lv_tick_get();
+    new_anim->deleted = 0;
+    var_index_add(new_anim);
+    state.anim_cnt++;
+
+    /*Rehashing would confuse the iterations of the buckets, so grow only when nothing iterates*/
+    if(state.anim_iter_depth == 0 && state.anim_cnt > 2 * state.anim_var_bucket_cnt) var_index_grow();
 
     /*Set the start value*/
     if(new_anim->early_apply) {
@@ -119,8 +141,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         }
     }
 
-    /*Creating an animation changed the linked list.
-     *It's important if it happens in a ready callback. (see `anim_timer`)*/
+    /*Resume the animation timer if it was paused*/
     anim_mark_list_change();
 
     LV_TRACE_ANIM("finished");
@@ -143,42 +164,57 @@ uint32_t lv_anim_get_playtime(const lv_anim_t * a)
 
 bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
     bool del_any = false;
-    a        = _lv_ll_get_head(anim_ll_p);
+
+    /*The deleted animations are only marked while iterating, so it's safe to continue
+     *the reading even if `a->deleted_cb` deletes other animations*/
+    anim_iter_begin();
+    lv_anim_t * a;
+    if(var == NULL) a = _lv_ll_get_head(anim_ll_p);
+    else a = state.anim_var_buckets[var_hash(var, state.anim_var_bucket_cnt)];
+
     while(a != NULL) {
-        bool del = false;
-        if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(anim_ll_p, a);
+        if(!a->deleted && (a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+            anim_remove(a);
             if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_free(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
             del_any = true;
-            del = true;
         }
 
-        /*Always start from the head on delete, because we don't know
-         *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? _lv_ll_get_head(anim_ll_p) : _lv_ll_get_next(anim_ll_p, a);
+        a = var == NULL ? _lv_ll_get_next(anim_ll_p, a) : a->var_next;
     }
+    anim_iter_end();
 
     return del_any;
 }
 
 void lv_anim_delete_all(void)
 {
-    _lv_ll_clear(anim_ll_p);
+    if(state.anim_iter_depth > 0) {
+        /*The list is being read, so just mark the animations and free them later*/
+        lv_anim_t * a;
+        _LV_LL_READ(anim_ll_p, a) {
+            if(!a->deleted) anim_remove(a);
+        }
+    }
+    else {
+        _lv_ll_clear(anim_ll_p);
+        if(state.anim_var_buckets) {
+            lv_memzero(state.anim_var_buckets, state.anim_var_bucket_cnt * sizeof(lv_anim_t *));
+        }
+        state.anim_cnt = 0;
+        state.anim_has_deleted = false;
+    }
     anim_mark_list_change();
 }
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    _LV_LL_READ(anim_ll_p, a) {
-        if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+    lv_anim_t * a = state.anim_var_buckets[var_hash(var, state.anim_var_bucket_cnt)];
+    while(a != NULL) {
+        if(!a->deleted && a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             return a;
         }
+        a = a->var_next;
     }
 
     return NULL;
@@ -191,11 +227,7 @@ lv_timer_t * lv_anim_get_timer(void)
 
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    _LV_LL_READ(anim_ll_p, a) cnt++;
-
-    return cnt;
+    return (uint16_t)state.anim_cnt;
 }
 
 uint32_t lv_anim_speed_clamped(uint32_t speed, uint32_t min_time, uint32_t max_time)
@@ -350,22 +382,21 @@ static void anim_timer(lv_timer_t * param)
     /*Flip the run round*/
     state.anim_run_round = state.anim_run_round ? false : true;
 
-    lv_anim_t * a = _lv_ll_get_head(anim_ll_p);
+    /*The animations deleted in the callbacks are only marked and they are freed in `anim_iter_end`.
+     *So the reading of the list can always continue from the current animation.*/
+    anim_iter_begin();
 
+    lv_anim_t * a = _lv_ll_get_head(anim_ll_p);
     while(a != NULL) {
-        uint32_t elaps = lv_tick_elaps(a->last_timer_run);
-        a->act_time += elaps;
-
-        a->last_timer_run = lv_tick_get();
+        /*Skip the deleted and the new animations (they are added to the head of the list),
+         *and the ones which already run in a nested call (e.g. `lv_anim_refr_now()` in a callback)*/
+        if(!a->deleted && a->run_round != state.anim_run_round) {
+            a->run_round = state.anim_run_round;
 
-        /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_completed_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        state.anim_list_changed = false;
+            uint32_t elaps = lv_tick_elaps(a->last_timer_run);
+            a->act_time += elaps;
 
-        if(a->run_round != state.anim_run_round) {
-            a->run_round = state.anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
+            a->last_timer_run = lv_tick_get();
 
             /*The animation will run now for the first time. Call `start_cb`*/
             if(!a->start_cb_called && a->act_time >= 0) {
@@ -385,7 +416,7 @@ static void anim_timer(lv_timer_t * param)
                 remove_concurrent_anims(a);
             }
 
-            if(a->act_time >= 0) {
+            if(!a->deleted && a->act_time >= 0) {
                 if(a->act_time > a->duration) a->act_time = a->duration;
 
                 int32_t new_value;
@@ -395,24 +426,20 @@ static void anim_timer(lv_timer_t * param)
                     a->current_value = new_value;
                     /*Apply the calculated value*/
                     if(a->exec_cb) a->exec_cb(a->var, new_value);
-                    if(!state.anim_list_changed && a->custom_exec_cb) a->custom_exec_cb(a, new_value);
+                    if(!a->deleted && a->custom_exec_cb) a->custom_exec_cb(a, new_value);
                 }
 
                 /*If the time is elapsed the animation is ready*/
-                if(!state.anim_list_changed && a->act_time >= a->duration) {
+                if(!a->deleted && a->act_time >= a->duration) {
                     anim_completed_handler(a);
                 }
             }
         }
 
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(state.anim_list_changed)
-            a = _lv_ll_get_head(anim_ll_p);
-        else
-            a = _lv_ll_get_next(anim_ll_p, a);
+        a = _lv_ll_get_next(anim_ll_p, a);
     }
 
+    anim_iter_end();
 }
 
 /**
@@ -433,15 +460,13 @@ static void anim_completed_handler(lv_anim_t * a)
     if(a->repeat_cnt == 0 && (a->playback_duration == 0 || a->playback_now == 1)) {
 
         /*Delete the animation from the list.
-         * This way the `completed_cb` will see the animations like it's animation is already deleted*/
-        _lv_ll_remove(anim_ll_p, a);
-        /*Flag that the list has changed*/
-        anim_mark_list_change();
+         * This way the `completed_cb` will see the animations like it's animation is already deleted.
+         * It's freed by `anim_timer` when the list is not read anymore.*/
+        anim_remove(a);
 
         /*Call the callback function at the end*/
         if(a->completed_cb != NULL) a->completed_cb(a);
         if(a->deleted_cb != NULL) a->deleted_cb(a);
-        lv_free(a);
     }
     /*If the animation is not deleted then restart it*/
     else {
@@ -467,8 +492,7 @@ static void anim_completed_handler(lv_anim_t * a)
 
 static void anim_mark_list_change(void)
 {
-    state.anim_list_changed = true;
-    if(_lv_ll_get_head(anim_ll_p) == NULL)
+    if(state.anim_cnt == 0)
         lv_timer_pause(state.timer);
     else
         lv_timer_resume(state.timer);
@@ -520,33 +544,124 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
 {
     if(a_current->exec_cb == NULL && a_current->custom_exec_cb == NULL) return false;
 
-    lv_anim_t * a;
     bool del_any = false;
-    a = _lv_ll_get_head(anim_ll_p);
+    anim_iter_begin();
+    lv_anim_t * a = state.anim_var_buckets[var_hash(a_current->var, state.anim_var_bucket_cnt)];
     while(a != NULL) {
-        bool del = false;
         /*We can't test for custom_exec_cb equality because in the MicroPython binding
          *a wrapper callback is used here an the real callback data is stored in the `user_data`.
          *Therefore equality check would remove all animations.*/
-        if(a != a_current &&
+        if(a != a_current && !a->deleted &&
            (a->act_time >= 0 || a->early_apply) &&
            (a->var == a_current->var) &&
            ((a->exec_cb && a->exec_cb == a_current->exec_cb)
             /*|| (a->custom_exec_cb && a->custom_exec_cb == a_current->custom_exec_cb)*/)) {
-            _lv_ll_remove(anim_ll_p, a);
+            anim_remove(a);
             if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_free(a);
-            /*Read by `anim_timer`. It need to know if a delete occurred in the linked list*/
-            anim_mark_list_change();
-
             del_any = true;
-            del = true;
         }
 
-        /*Always start from the head on delete, because we don't know
-         *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? _lv_ll_get_head(anim_ll_p) : _lv_ll_get_next(anim_ll_p, a);
+        a = a->var_next;
     }
+    anim_iter_end();
 
     return del_any;
 }
+
+/**
+ * Remove an animation from the running animations.
+ * It's only marked as deleted and stays in the linked list until nothing reads the list.
+ * @param a     pointer to an animation
+ */
+static void anim_remove(lv_anim_t * a)
+{
+    var_index_remove(a);
+    a->deleted = 1;
+    state.anim_cnt--;
+    state.anim_has_deleted = true;
+    anim_mark_list_change();
+}
+
+static void anim_iter_begin(void)
+{
+    state.anim_iter_depth++;
+}
+
+/**
+ * Finish reading the animation list and free the deleted animations
+ * if no one else reads the list.
+ */
+static void anim_iter_end(void)
+{
+    state.anim_iter_depth--;
+    if(state.anim_iter_depth > 0 || !state.anim_has_deleted) return;
+
+    state.anim_has_deleted = false;
+    lv_anim_t * a = _lv_ll_get_head(anim_ll_p);
+    while(a != NULL) {
+        lv_anim_t * a_next = _lv_ll_get_next(anim_ll_p, a);
+        if(a->deleted) {
+            _lv_ll_remove(anim_ll_p, a);
+            lv_free(a);
+        }
+        a = a_next;
+    }
+}
+
+static uint32_t var_hash(const void * var, uint32_t bucket_cnt)
+{
+    /*The low bits of the pointers are usually 0 due to the alignment*/
+    lv_uintptr_t v = (lv_uintptr_t)var;
+    return (uint32_t)((v >> 3) ^ (v >> 12)) & (bucket_cnt - 1);
+}
+
+/**
+ * Add an animation to the head of its bucket, so the animations of a `var` are found
+ * in the same order (newest first) as in the linked list.
+ * @param a     pointer to an animation
+ */
+static void var_index_add(lv_anim_t * a)
+{
+    lv_anim_t ** bucket = &state.anim_var_buckets[var_hash(a->var, state.anim_var_bucket_cnt)];
+    a->var_next = *bucket;
+    *bucket = a;
+}
+
+/**
+ * Unlink an animation from its bucket. `a->var_next` is kept, so
+ * the iterations of the bucket can continue from `a`.
+ * @param a     pointer to an animation
+ */
+static void var_index_remove(lv_anim_t * a)
+{
+    lv_anim_t ** prev_next = &state.anim_var_buckets[var_hash(a->var, state.anim_var_bucket_cnt)];
+    while(*prev_next != NULL) {
+        if(*prev_next == a) {
+            *prev_next = a->var_next;
+            return;
+        }
+        prev_next = &(*prev_next)->var_next;
+    }
+
+    LV_LOG_WARN("the animation wasn't found by its `var`. Was the `var` changed after start?");
+}
+
+static void var_index_grow(void)
+{
+    uint32_t bucket_cnt = state.anim_var_bucket_cnt * 2;
+    lv_anim_t ** buckets = lv_malloc_zeroed(bucket_cnt * sizeof(lv_anim_t *));
+    if(buckets == NULL) {
+        LV_LOG_WARN("couldn't grow the hash table, the lookup of the animations gets slower");
+        return;
+    }
+
+    lv_free(state.anim_var_buckets);
+    state.anim_var_buckets = buckets;
+    state.anim_var_bucket_cnt = bucket_cnt;
+
+    /*Add from the tail to keep the newest first order in the buckets*/
+    lv_anim_t * a;
+    _LV_LL_READ_BACK(anim_ll_p, a) {
+        if(!a->deleted) var_index_add(a);
+    }
+}
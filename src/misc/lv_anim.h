@@ -86,10 +86,14 @@ typedef enum {
 } lv_anim_enable_t;
 
 typedef struct {
-    bool anim_list_changed;
     bool anim_run_round;
+    bool anim_has_deleted;          /*Deleted animations are waiting in `anim_ll` to be freed*/
     lv_timer_t * timer;
     lv_ll_t anim_ll;
+    lv_anim_t ** anim_var_buckets;  /*Hash table of the animations by their `var`*/
+    uint32_t anim_var_bucket_cnt;
+    uint32_t anim_cnt;              /*Number of animations which are not deleted*/
+    uint32_t anim_iter_depth;       /*>0 while `anim_ll` is iterated, so it can't be unlinked*/
 } lv_anim_state_t;
 
 /** Get the current value during an animation*/
@@ -153,10 +157,12 @@ struct _lv_anim_t {
 
     /*Animation system use these - user shouldn't set*/
     uint32_t last_timer_run;
+    lv_anim_t * var_next;           /**< Next animation in the same bucket of the `var` hash table*/
     uint8_t playback_now : 1; /**< Play back is in progress*/
     uint8_t run_round : 1;    /**< Indicates the animation has run in this round*/
     uint8_t start_cb_called : 1;    /**< Indicates that the `start_cb` was already called*/
     uint8_t early_apply  : 1;    /**< 1: Apply start value immediately even is there is `delay`*/
+    uint8_t deleted : 1;        /**< Removed from the running animations but not freed yet*/
 };
 
 /**********************
@@ -401,6 +407,8 @@ static inline void lv_anim_set_bezier3_param(lv_anim_t * a, int16_t x1, int16_t
  * Create an animation
  * @param a         an initialized 'anim_t' variable. Not required after call.
  * @return          pointer to the created animation (different from the `a` parameter)
+ * @note            the animations are looked up by their `var`, so the `var` of the
+ *                  created animation shouldn't be changed
  */
 lv_anim_t * lv_anim_start(const lv_anim_t * a);
 
@@ -187,7 +187,8 @@ void lv_area_move(lv_area_t * area, int32_t x_ofs, int32_t y_ofs);
 bool _lv_area_intersect(lv_area_t * res_p, const lv_area_t * a1_p, const lv_area_t * a2_p);
 
 /**
- * Get resulting sub areas after removing the common parts of two areas from the first area
+ * Get resulting sub areas after removing the common parts of two areas from the first area.
+ * The resulting areas don't overlap each other and the second area.
  * @param res_p pointer to an array of areas with a count of 4, the resulting areas will be stored here
  * @param a1_p pointer to the first area
  * @param a2_p pointer to the second area
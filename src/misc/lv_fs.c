@@ -293,6 +293,39 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     return res;
 }
 
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** buf, uint32_t * size)
+{
+    *buf = NULL;
+    *size = 0;
+
+    if(file_p->drv == NULL) return LV_FS_RES_INV_PARAM;
+    if(file_p->drv->map_cb == NULL) return LV_FS_RES_NOT_IMP;
+
+    LV_PROFILER_BEGIN;
+
+    lv_fs_res_t res = file_p->drv->map_cb(file_p->drv, file_p->file_d, buf, size);
+    if(res != LV_FS_RES_OK) {
+        *buf = NULL;
+        *size = 0;
+    }
+
+    LV_PROFILER_END;
+
+    return res;
+}
+
+lv_fs_res_t lv_fs_unmap(lv_fs_file_t * file_p, const void * buf, uint32_t size)
+{
+    if(file_p->drv == NULL) return LV_FS_RES_INV_PARAM;
+    if(file_p->drv->unmap_cb == NULL) return LV_FS_RES_OK;
+
+    LV_PROFILER_BEGIN;
+    lv_fs_res_t res = file_p->drv->unmap_cb(file_p->drv, file_p->file_d, buf, size);
+    LV_PROFILER_END;
+
+    return res;
+}
+
 lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t * rddir_p, const char * path)
 {
     if(path == NULL) return LV_FS_RES_INV_PARAM;
@@ -90,6 +90,10 @@ struct _lv_fs_drv_t {
     lv_fs_res_t (*seek_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
     lv_fs_res_t (*tell_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
 
+    /*Optional, to access the content of a file directly in memory (e.g. with `mmap()`)*/
+    lv_fs_res_t (*map_cb)(lv_fs_drv_t * drv, void * file_p, const void ** buf, uint32_t * size);
+    lv_fs_res_t (*unmap_cb)(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t size);
+
     void * (*dir_open_cb)(lv_fs_drv_t * drv, const char * path);
     lv_fs_res_t (*dir_read_cb)(lv_fs_drv_t * drv, void * rddir_p, char * fn, uint32_t fn_len);
     lv_fs_res_t (*dir_close_cb)(lv_fs_drv_t * drv, void * rddir_p);
@@ -229,6 +233,25 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
  */
 lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos);
 
+/**
+ * Map the whole content of a file to the memory to read it without copying.
+ * It's supported only if the driver has `map_cb`.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param buf       pointer to store the address of the read-only content
+ * @param size      pointer to store the size of the content in bytes
+ * @return          LV_FS_RES_OK, LV_FS_RES_NOT_IMP if the driver can't map files or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** buf, uint32_t * size);
+
+/**
+ * Release the content mapped by `lv_fs_map()`. It should be called before closing the file.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param buf       the address returned by `lv_fs_map()`
+ * @param size      the size returned by `lv_fs_map()`
+ * @return          LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_unmap(lv_fs_file_t * file_p, const void * buf, uint32_t size);
+
 /**
  * Initialize a 'fs_dir_t' variable for directory reading
  * @param rddir_p   pointer to a 'lv_fs_dir_t' variable
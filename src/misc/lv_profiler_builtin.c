@@ -20,18 +20,41 @@
 #define profiler_ctx LV_GLOBAL_DEFAULT()->profiler_context
 
 #define LV_PROFILER_STR_MAX_LEN 128
-#define LV_PROFILER_TICK_PER_SEC_MAX 1000000
+#define LV_PROFILER_TICK_PER_SEC_MAX 1000000000
+#define LV_PROFILER_NSEC_PER_SEC 1000000000ULL
+
+/*Max number of threads with their own record buffer*/
+#define LV_PROFILER_RING_MAX 16
+
+/*Size of the table of the interned names. Should be power of 2.*/
+#define LV_PROFILER_NAME_TABLE_BITS 9
+#define LV_PROFILER_NAME_TABLE_SIZE (1 << LV_PROFILER_NAME_TABLE_BITS)
+#define LV_PROFILER_NAME_ID_NONE    0xFFFF
 
 #if LV_USE_OS
     #define LV_PROFILER_MULTEX_INIT   lv_mutex_init(&profiler_ctx->mutex)
     #define LV_PROFILER_MULTEX_DEINIT lv_mutex_delete(&profiler_ctx->mutex)
     #define LV_PROFILER_MULTEX_LOCK   lv_mutex_lock(&profiler_ctx->mutex)
     #define LV_PROFILER_MULTEX_UNLOCK lv_mutex_unlock(&profiler_ctx->mutex)
+
+    #define ATOMIC_LOAD(p)          __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define ATOMIC_STORE(p, v)      __atomic_store_n(p, v, __ATOMIC_RELEASE)
+    #define ATOMIC_ADD(p, v)        __atomic_add_fetch(p, v, __ATOMIC_RELAXED)
+    #define ATOMIC_SUB(p, v)        __atomic_sub_fetch(p, v, __ATOMIC_RELAXED)
+    #define ATOMIC_CAS(p, expected, desired) \
+        __atomic_compare_exchange_n(p, expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
 #else
     #define LV_PROFILER_MULTEX_INIT
     #define LV_PROFILER_MULTEX_DEINIT
     #define LV_PROFILER_MULTEX_LOCK
     #define LV_PROFILER_MULTEX_UNLOCK
+
+    #define ATOMIC_LOAD(p)          (*(p))
+    #define ATOMIC_STORE(p, v)      (*(p) = (v))
+    #define ATOMIC_ADD(p, v)        (*(p) += (v))
+    #define ATOMIC_SUB(p, v)        (*(p) -= (v))
+    #define ATOMIC_CAS(p, expected, desired) \
+        (*(p) == *(expected) ? (*(p) = (desired), true) : (*(expected) = *(p), false))
 #endif
 
 /**********************
@@ -42,26 +65,44 @@
  * @brief Structure representing a built-in profiler item in LVGL
  */
 typedef struct {
-    char tag;          /**< The tag of the profiler item */
-    uint32_t tick;     /**< The tick value of the profiler item */
-    const char * func; /**< A pointer to the function associated with the profiler item */
-#if LV_USE_OS
-    int tid;           /**< The thread ID of the profiler item */
-    int cpu;         /**< The CPU ID of the profiler item */
-#endif
+    uint64_t tick;      /**< The tick value of the profiler item */
+    uint32_t seq;       /**< Ring index for which the slot can be written (== index) or read (== index + 1) */
+    uint16_t name_id;   /**< Index of the name of the function in the interned name table */
+    uint16_t cpu;       /**< The CPU ID of the profiler item */
+    char tag;           /**< The tag of the profiler item */
 } lv_profiler_builtin_item_t;
 
+/**
+ * @brief Ring buffer of the items of a thread.
+ * Usually only the owner thread writes it, but the threads sharing the same thread ID can write it too
+ * so the slots are reserved with CAS and published with their sequence number.
+ * Only the drain reads it.
+ */
+typedef struct {
+    int tid;                                /**< The thread ID of the owner thread */
+    uint32_t mask;                          /**< Number of items - 1, the number of items is power of 2 */
+    uint32_t head;                          /**< Index of the next item to write */
+    uint32_t tail;                          /**< Index of the next item to drain, written only by the drain */
+    bool drain_requested;                   /**< The owner thread has already woken up the drain thread */
+    bool thread_named;                      /**< The name of the thread is already written to the output */
+    lv_profiler_builtin_item_t items[];     /**< The items follow the header in the same allocation */
+} lv_profiler_builtin_ring_t;
+
 /**
  * @brief Structure representing a context for the LVGL built-in profiler
  */
 typedef struct _lv_profiler_builtin_ctx_t {
-    lv_profiler_builtin_item_t * item_arr; /**< Pointer to an array of profiler items */
-    uint32_t item_num;                     /**< Number of profiler items in the array */
-    uint32_t cur_index;                    /**< Index of the current profiler item */
+    lv_profiler_builtin_ring_t * rings[LV_PROFILER_RING_MAX];  /**< The buffer of each thread, added on the first write */
+    const char ** names;                   /**< Interned names, the index is the ID of the name */
+    uint32_t ring_item_num;                /**< Number of profiler items in a ring */
+    uint32_t dropped_num;                  /**< Number of items dropped since the last drain */
     lv_profiler_builtin_config_t config;   /**< Configuration for the built-in profiler */
     bool enable;                           /**< Whether the built-in profiler is enabled */
 #if LV_USE_OS
-    lv_mutex_t mutex;                      /**< Mutex to protect the built-in profiler */
+    lv_mutex_t mutex;                      /**< Mutex to serialize the drains */
+    lv_thread_t drain_thread;              /**< Thread to drain the rings getting full */
+    lv_thread_sync_t drain_sync;           /**< Wakes up the drain thread */
+    bool drain_exit;                       /**< Ask the drain thread to exit */
 #endif
 } lv_profiler_builtin_ctx_t;
 
@@ -70,9 +111,18 @@ typedef struct _lv_profiler_builtin_ctx_t {
  **********************/
 
 static void default_flush_cb(const char * buf);
+static uint64_t default_tick_get_cb(void);
 static int default_tid_get_cb(void);
 static int default_cpu_get_cb(void);
-static void flush_no_lock(void);
+static int current_tid(void);
+static lv_profiler_builtin_ring_t * ring_get(int tid);
+static uint16_t name_intern(const char * name);
+static void drain_no_lock(void);
+static void drain_ring(lv_profiler_builtin_ring_t * ring);
+static void format_item(char * buf, uint32_t buf_size, int tid, const lv_profiler_builtin_item_t * item);
+#if LV_USE_OS
+    static void drain_thread_cb(void * user_data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -92,10 +142,11 @@ void lv_profiler_builtin_config_init(lv_profiler_builtin_config_t * config)
     lv_memzero(config, sizeof(lv_profiler_builtin_config_t));
     config->buf_size = LV_PROFILER_BUILTIN_BUF_SIZE;
     config->tick_per_sec = 1000;
-    config->tick_get_cb = lv_tick_get;
+    config->tick_get_cb = default_tick_get_cb;
     config->flush_cb = default_flush_cb;
     config->tid_get_cb = default_tid_get_cb;
     config->cpu_get_cb = default_cpu_get_cb;
+    config->format = LV_PROFILER_BUILTIN_FORMAT_SYSTRACE;
 }
 
 void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
@@ -103,9 +154,11 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
     LV_ASSERT_NULL(config);
     LV_ASSERT_NULL(config->tick_get_cb);
 
+    /*Round down to power of 2 to find the items in the ring with a mask*/
     uint32_t num = config->buf_size / sizeof(lv_profiler_builtin_item_t);
-    if(num == 0) {
-        LV_LOG_WARN("buf_size must > %d", (int)sizeof(lv_profiler_builtin_item_t));
+    while(num & (num - 1)) num &= num - 1;
+    if(num < 2) {
+        LV_LOG_WARN("buf_size must > %d", (int)(2 * sizeof(lv_profiler_builtin_item_t)));
         return;
     }
 
@@ -122,35 +175,63 @@ void lv_profiler_builtin_init(const lv_profiler_builtin_config_t * config)
     profiler_ctx = lv_malloc_zeroed(sizeof(lv_profiler_builtin_ctx_t));
     LV_ASSERT_MALLOC(profiler_ctx);
 
-    profiler_ctx->item_arr = lv_malloc(num * sizeof(lv_profiler_builtin_item_t));
-    LV_ASSERT_MALLOC(profiler_ctx->item_arr);
-    if(profiler_ctx->item_arr == NULL) {
+    profiler_ctx->names = lv_malloc_zeroed(LV_PROFILER_NAME_TABLE_SIZE * sizeof(const char *));
+    LV_ASSERT_MALLOC(profiler_ctx->names);
+    if(profiler_ctx->names == NULL) {
         lv_free(profiler_ctx);
         profiler_ctx = NULL;
-        LV_LOG_ERROR("malloc failed for item_arr");
+        LV_LOG_ERROR("malloc failed for names");
         return;
     }
 
     LV_PROFILER_MULTEX_INIT;
-    profiler_ctx->item_num = num;
+    profiler_ctx->ring_item_num = num;
     profiler_ctx->config = *config;
 
+    /*Allocate the buffer of the initializing thread now instead of on its first write*/
+    ring_get(current_tid());
+
+#if LV_USE_OS
+    lv_thread_sync_init(&profiler_ctx->drain_sync);
+    lv_thread_init(&profiler_ctx->drain_thread, LV_THREAD_PRIO_LOW, drain_thread_cb, LV_DRAW_THREAD_STACK_SIZE,
+                   profiler_ctx);
+#endif
+
     if(profiler_ctx->config.flush_cb) {
-        /* add profiler header for perfetto */
-        profiler_ctx->config.flush_cb("# tracer: nop\n");
-        profiler_ctx->config.flush_cb("#\n");
+        if(profiler_ctx->config.format == LV_PROFILER_BUILTIN_FORMAT_CHROME_TRACE) {
+            /* the closing ']' is optional in the JSON array format */
+            profiler_ctx->config.flush_cb("[\n");
+        }
+        else {
+            /* add profiler header for perfetto */
+            profiler_ctx->config.flush_cb("# tracer: nop\n");
+            profiler_ctx->config.flush_cb("#\n");
+        }
     }
 
     lv_profiler_builtin_set_enable(true);
 
-    LV_LOG_INFO("init OK, item_num = %d", (int)num);
+    LV_LOG_INFO("init OK, item_num = %d per thread", (int)num);
 }
 
 void lv_profiler_builtin_uninit(void)
 {
     LV_ASSERT_NULL(profiler_ctx);
+
+#if LV_USE_OS
+    ATOMIC_STORE(&profiler_ctx->drain_exit, true);
+    lv_thread_sync_signal(&profiler_ctx->drain_sync);
+    lv_thread_delete(&profiler_ctx->drain_thread);
+    lv_thread_sync_delete(&profiler_ctx->drain_sync);
+#endif
+
     LV_PROFILER_MULTEX_DEINIT;
-    lv_free(profiler_ctx->item_arr);
+
+    uint32_t i;
+    for(i = 0; i < LV_PROFILER_RING_MAX; i++) {
+        lv_free(profiler_ctx->rings[i]);
+    }
+    lv_free(profiler_ctx->names);
     lv_free(profiler_ctx);
     profiler_ctx = NULL;
 }
@@ -169,7 +250,7 @@ void lv_profiler_builtin_flush(void)
     LV_ASSERT_NULL(profiler_ctx);
 
     LV_PROFILER_MULTEX_LOCK;
-    flush_no_lock();
+    drain_no_lock();
     LV_PROFILER_MULTEX_UNLOCK;
 }
 
@@ -182,26 +263,56 @@ void lv_profiler_builtin_write(const char * func, char tag)
         return;
     }
 
-    LV_PROFILER_MULTEX_LOCK;
+    lv_profiler_builtin_ring_t * ring = ring_get(current_tid());
+    if(ring == NULL) {
+        ATOMIC_ADD(&profiler_ctx->dropped_num, 1);
+        return;
+    }
 
-    if(profiler_ctx->cur_index >= profiler_ctx->item_num) {
-        flush_no_lock();
-        profiler_ctx->cur_index = 0;
+    /*Reserve a slot*/
+    uint32_t head = ATOMIC_LOAD(&ring->head);
+    lv_profiler_builtin_item_t * item;
+    while(1) {
+        item = &ring->items[head & ring->mask];
+        int32_t diff = (int32_t)(ATOMIC_LOAD(&item->seq) - head);
+        if(diff == 0) {
+            /*`head` is updated if an other thread has reserved the slot in the meantime*/
+            if(ATOMIC_CAS(&ring->head, &head, head + 1)) break;
+        }
+        else if(diff < 0) {
+            /*The ring is full*/
+#if LV_USE_OS
+            /*Don't wait for the drain thread to keep the timing of this thread*/
+            ATOMIC_ADD(&profiler_ctx->dropped_num, 1);
+            return;
+#else
+            drain_no_lock();
+#endif
+        }
+        else {
+            head = ATOMIC_LOAD(&ring->head);
+        }
     }
 
-    lv_profiler_builtin_item_t * item = &profiler_ctx->item_arr[profiler_ctx->cur_index];
-    item->func = func;
+    item->name_id = name_intern(func);
     item->tag = tag;
     item->tick = profiler_ctx->config.tick_get_cb();
-
 #if LV_USE_OS
-    item->tid = profiler_ctx->config.tid_get_cb();
-    item->cpu = profiler_ctx->config.cpu_get_cb();
+    item->cpu = (uint16_t)profiler_ctx->config.cpu_get_cb();
+#else
+    item->cpu = 0;
 #endif
 
-    profiler_ctx->cur_index++;
+    /*Publish the item for the drain*/
+    ATOMIC_STORE(&item->seq, head + 1);
 
-    LV_PROFILER_MULTEX_UNLOCK;
+#if LV_USE_OS
+    /*Drain the ring in the background when it's half full*/
+    if(head + 1 - ATOMIC_LOAD(&ring->tail) > (ring->mask >> 1) && !ATOMIC_LOAD(&ring->drain_requested)) {
+        ATOMIC_STORE(&ring->drain_requested, true);
+        lv_thread_sync_signal(&profiler_ctx->drain_sync);
+    }
+#endif
 }
 
 /**********************
@@ -213,6 +324,11 @@ static void default_flush_cb(const char * buf)
     LV_LOG("%s", buf);
 }
 
+static uint64_t default_tick_get_cb(void)
+{
+    return lv_tick_get();
+}
+
 static int default_tid_get_cb(void)
 {
     return 1;
@@ -223,40 +339,186 @@ static int default_cpu_get_cb(void)
     return 0;
 }
 
-static void flush_no_lock(void)
+static int current_tid(void)
+{
+#if LV_USE_OS
+    return profiler_ctx->config.tid_get_cb();
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Find the ring of a thread or add a new one if the thread writes first time.
+ */
+static lv_profiler_builtin_ring_t * ring_get(int tid)
+{
+    uint32_t i;
+    for(i = 0; i < LV_PROFILER_RING_MAX; i++) {
+        lv_profiler_builtin_ring_t * ring = ATOMIC_LOAD(&profiler_ctx->rings[i]);
+        if(ring == NULL) break;
+        if(ring->tid == tid) return ring;
+    }
+
+    if(i == LV_PROFILER_RING_MAX) return NULL;
+
+    uint32_t num = profiler_ctx->ring_item_num;
+    lv_profiler_builtin_ring_t * new_ring = lv_malloc_zeroed(sizeof(lv_profiler_builtin_ring_t) +
+                                                             num * sizeof(lv_profiler_builtin_item_t));
+    LV_ASSERT_MALLOC(new_ring);
+    if(new_ring == NULL) return NULL;
+
+    new_ring->tid = tid;
+    new_ring->mask = num - 1;
+    uint32_t j;
+    for(j = 0; j < num; j++) {
+        new_ring->items[j].seq = j;
+    }
+
+    /*Other threads can add their rings in the meantime so take the first free slot*/
+    for(; i < LV_PROFILER_RING_MAX; i++) {
+        lv_profiler_builtin_ring_t * expected = NULL;
+        if(ATOMIC_CAS(&profiler_ctx->rings[i], &expected, new_ring)) return new_ring;
+
+        /*An other thread with the same ID was faster*/
+        if(expected->tid == tid) {
+            lv_free(new_ring);
+            return expected;
+        }
+    }
+
+    LV_LOG_WARN("no more than %d threads can be profiled", LV_PROFILER_RING_MAX);
+    lv_free(new_ring);
+    return NULL;
+}
+
+/**
+ * Get the ID of a name. The names are identified by their address
+ * as they are string literals (`__func__` or tags) in practice.
+ */
+static uint16_t name_intern(const char * name)
+{
+    uint32_t hash = (uint32_t)((lv_uintptr_t)name >> 2) * 2654435761U;
+    uint32_t id = hash >> (32 - LV_PROFILER_NAME_TABLE_BITS);
+    uint32_t i;
+    for(i = 0; i < LV_PROFILER_NAME_TABLE_SIZE; i++) {
+        const char * slot = ATOMIC_LOAD(&profiler_ctx->names[id]);
+        if(slot == NULL && ATOMIC_CAS(&profiler_ctx->names[id], &slot, name)) return (uint16_t)id;
+
+        /*`slot` is updated if an other thread has added a name in the meantime*/
+        if(slot == name) return (uint16_t)id;
+
+        id = (id + 1) & (LV_PROFILER_NAME_TABLE_SIZE - 1);
+    }
+
+    return LV_PROFILER_NAME_ID_NONE;
+}
+
+static void drain_no_lock(void)
 {
     if(!profiler_ctx->config.flush_cb) {
         LV_LOG_WARN("flush_cb is not registered");
         return;
     }
 
-    uint32_t cur = 0;
+    uint32_t i;
+    for(i = 0; i < LV_PROFILER_RING_MAX; i++) {
+        lv_profiler_builtin_ring_t * ring = ATOMIC_LOAD(&profiler_ctx->rings[i]);
+        if(ring == NULL) break;
+        drain_ring(ring);
+    }
+
+    uint32_t dropped_num = ATOMIC_LOAD(&profiler_ctx->dropped_num);
+    if(dropped_num) {
+        ATOMIC_SUB(&profiler_ctx->dropped_num, dropped_num);
+        LV_LOG_WARN("%" LV_PRIu32 " items were dropped, increase buf_size", dropped_num);
+    }
+}
+
+static void drain_ring(lv_profiler_builtin_ring_t * ring)
+{
     char buf[LV_PROFILER_STR_MAX_LEN];
-    uint32_t tick_per_sec = profiler_ctx->config.tick_per_sec;
-    while(cur < profiler_ctx->cur_index) {
-        lv_profiler_builtin_item_t * item = &profiler_ctx->item_arr[cur++];
-        uint32_t sec = item->tick / tick_per_sec;
-        uint32_t usec = (item->tick % tick_per_sec) * (LV_PROFILER_TICK_PER_SEC_MAX / tick_per_sec);
 
-#if LV_USE_OS
-        lv_snprintf(buf, sizeof(buf),
-                    "   LVGL-%d [%d] %" LV_PRIu32 ".%06" LV_PRIu32 ": tracing_mark_write: %c|1|%s\n",
-                    item->tid,
-                    item->cpu,
-                    sec,
-                    usec,
+    /*Allow requesting an other drain for the items added from now*/
+    ATOMIC_STORE(&ring->drain_requested, false);
+
+    uint32_t tail = ring->tail;
+    while(1) {
+        lv_profiler_builtin_item_t * slot = &ring->items[tail & ring->mask];
+        if(ATOMIC_LOAD(&slot->seq) != tail + 1) break;
+
+        /*Free the slot before the possibly slow flush_cb*/
+        lv_profiler_builtin_item_t item = *slot;
+        ATOMIC_STORE(&slot->seq, tail + ring->mask + 1);
+        tail++;
+        ATOMIC_STORE(&ring->tail, tail);
+
+        if(profiler_ctx->config.format == LV_PROFILER_BUILTIN_FORMAT_CHROME_TRACE && !ring->thread_named) {
+            lv_snprintf(buf, sizeof(buf),
+                        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"LVGL-%d\"}},\n",
+                        ring->tid,
+                        ring->tid);
+            profiler_ctx->config.flush_cb(buf);
+            ring->thread_named = true;
+        }
+
+        format_item(buf, sizeof(buf), ring->tid, &item);
+        profiler_ctx->config.flush_cb(buf);
+    }
+}
+
+static void format_item(char * buf, uint32_t buf_size, int tid, const lv_profiler_builtin_item_t * item)
+{
+    uint32_t tick_per_sec = profiler_ctx->config.tick_per_sec;
+    uint64_t nsec = item->tick / tick_per_sec * LV_PROFILER_NSEC_PER_SEC +
+                    item->tick % tick_per_sec * LV_PROFILER_NSEC_PER_SEC / tick_per_sec;
+    uint32_t sec = (uint32_t)(nsec / LV_PROFILER_NSEC_PER_SEC);
+    uint32_t sub_nsec = (uint32_t)(nsec % LV_PROFILER_NSEC_PER_SEC);
+    const char * name = item->name_id == LV_PROFILER_NAME_ID_NONE ? "?" : profiler_ctx->names[item->name_id];
+
+    if(profiler_ctx->config.format == LV_PROFILER_BUILTIN_FORMAT_CHROME_TRACE) {
+        /*The timestamps are in microseconds, a JSON number can't have leading zeros*/
+        char ts[32];
+        if(sec) lv_snprintf(ts, sizeof(ts), "%" LV_PRIu32 "%06" LV_PRIu32 ".%03" LV_PRIu32,
+                                sec, sub_nsec / 1000, sub_nsec % 1000);
+        else lv_snprintf(ts, sizeof(ts), "%" LV_PRIu32 ".%03" LV_PRIu32, sub_nsec / 1000, sub_nsec % 1000);
+
+        lv_snprintf(buf, buf_size,
+                    "{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%s,\"pid\":1,\"tid\":%d,\"args\":{\"cpu\":%d}},\n",
+                    name,
                     item->tag,
-                    item->func);
-#else
-        lv_snprintf(buf, sizeof(buf),
-                    "   LVGL-1 [0] %" LV_PRIu32 ".%06" LV_PRIu32 ": tracing_mark_write: %c|1|%s\n",
+                    ts,
+                    tid,
+                    (int)item->cpu);
+    }
+    else {
+        lv_snprintf(buf, buf_size,
+                    "   LVGL-%d [%d] %" LV_PRIu32 ".%06" LV_PRIu32 ": tracing_mark_write: %c|1|%s\n",
+                    tid,
+                    (int)item->cpu,
                     sec,
-                    usec,
+                    sub_nsec / 1000,
                     item->tag,
-                    item->func);
-#endif
-        profiler_ctx->config.flush_cb(buf);
+                    name);
+    }
+}
+
+#if LV_USE_OS
+
+static void drain_thread_cb(void * user_data)
+{
+    lv_profiler_builtin_ctx_t * ctx = user_data;
+
+    while(1) {
+        lv_thread_sync_wait(&ctx->drain_sync);
+        if(ATOMIC_LOAD(&ctx->drain_exit)) break;
+
+        lv_mutex_lock(&ctx->mutex);
+        drain_no_lock();
+        lv_mutex_unlock(&ctx->mutex);
     }
 }
 
+#endif
+
 #endif /*LV_USE_PROFILER_BUILTIN*/
@@ -33,16 +33,25 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * @brief Output format of the built-in profiler
+ */
+typedef enum {
+    LV_PROFILER_BUILTIN_FORMAT_SYSTRACE,        /**< Android systrace text, can be opened by Perfetto */
+    LV_PROFILER_BUILTIN_FORMAT_CHROME_TRACE,    /**< Chrome trace event JSON, can be opened by Perfetto and chrome://tracing */
+} lv_profiler_builtin_format_t;
+
 /**
  * @brief LVGL profiler built-in configuration structure
  */
 typedef struct {
-    size_t buf_size;                    /**< The size of the buffer used for profiling data */
-    uint32_t tick_per_sec;              /**< The number of ticks per second */
-    uint32_t (*tick_get_cb)(void);      /**< Callback function to get the current tick count */
+    size_t buf_size;                    /**< The size of the buffer of each thread used for profiling data */
+    uint32_t tick_per_sec;              /**< The number of ticks per second, at most 1000000000 (nanoseconds) */
+    uint64_t (*tick_get_cb)(void);      /**< Callback function to get the current tick count */
     void (*flush_cb)(const char * buf); /**< Callback function to flush the profiling data */
     int (*tid_get_cb)(void);            /**< Callback function to get the current thread ID */
     int (*cpu_get_cb)(void);            /**< Callback function to get the current CPU */
+    lv_profiler_builtin_format_t format; /**< Format of the flushed data */
 } lv_profiler_builtin_config_t;
 
 /**********************
@@ -73,13 +82,15 @@ void lv_profiler_builtin_uninit(void);
 void lv_profiler_builtin_set_enable(bool enable);
 
 /**
- * @brief Flush the profiling data to the console
+ * @brief Flush the profiling data of all threads to `flush_cb`.
+ * With an OS the buffers are also flushed by a background thread when they are half full.
  */
 void lv_profiler_builtin_flush(void);
 
 /**
- * @brief Write the profiling data for a function with the given tag
- * @param func Name of the function being profiled
+ * @brief Write the profiling data for a function with the given tag.
+ * The data is written to the buffer of the current thread without locking.
+ * @param func Name of the function being profiled, it must remain valid until the data is flushed
  * @param tag Tag to associate with the profiling data for the function
  */
 void lv_profiler_builtin_write(const char * func, char tag);
@@ -19,6 +19,7 @@
 #define _lv_style_custom_prop_flag_lookup_table_size LV_GLOBAL_DEFAULT()->style_custom_table_size
 #define _lv_style_custom_prop_flag_lookup_table LV_GLOBAL_DEFAULT()->style_custom_prop_flag_lookup_table
 #define last_custom_prop_id LV_GLOBAL_DEFAULT()->style_last_custom_prop_id
+#define style_value_cache_epoch LV_GLOBAL_DEFAULT()->style_value_cache_epoch
 
 /**********************
  *      TYPEDEFS
@@ -193,6 +194,9 @@ void lv_style_reset(lv_style_t * style)
 
     if(style->prop_cnt != 255) lv_free(style->values_and_props);
     lv_memzero(style, sizeof(lv_style_t));
+#if LV_OBJ_STYLE_VALUE_CACHE
+    style_value_cache_epoch++;
+#endif
 #if LV_USE_ASSERT_STYLE
     style->sentinel = LV_STYLE_SENTINEL_VALUE;
 #endif
@@ -250,38 +254,41 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 
     if(style->prop_cnt == 0)  return false;
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+    style_value_cache_epoch++;
+#endif
+
     uint8_t * tmp = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
     uint8_t * old_props = (uint8_t *)tmp;
-    uint32_t i;
-    for(i = 0; i < style->prop_cnt; i++) {
-        if(old_props[i] == prop) {
-            lv_style_value_t * old_values = (lv_style_value_t *)style->values_and_props;
-
-            size_t size = (style->prop_cnt - 1) * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
-            uint8_t * new_values_and_props = lv_malloc(size);
-            if(new_values_and_props == NULL) return false;
-            style->values_and_props = new_values_and_props;
-            style->prop_cnt--;
-
-            tmp = new_values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-            uint8_t * new_props = (uint8_t *)tmp;
-            lv_style_value_t * new_values = (lv_style_value_t *)new_values_and_props;
-
-            uint32_t j;
-            for(i = j = 0; j <= style->prop_cnt;
-                j++) { /*<=: because prop_cnt already reduced but all the old props. needs to be checked.*/
-                if(old_props[j] != prop) {
-                    new_values[i] = old_values[j];
-                    new_props[i++] = old_props[j];
-                }
-            }
-
-            lv_free(old_values);
-            return true;
+    uint32_t i = _lv_style_find_prop_index(old_props, style->prop_cnt, prop);
+    if(i == style->prop_cnt || old_props[i] != prop) return false;
+
+    lv_style_value_t * old_values = (lv_style_value_t *)style->values_and_props;
+
+    size_t size = (style->prop_cnt - 1) * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+    uint8_t * new_values_and_props = lv_malloc(size);
+    if(new_values_and_props == NULL) return false;
+    style->values_and_props = new_values_and_props;
+    style->prop_cnt--;
+
+    tmp = new_values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    uint8_t * new_props = (uint8_t *)tmp;
+    lv_style_value_t * new_values = (lv_style_value_t *)new_values_and_props;
+
+    /*Copy the remaining props (keeping their order) and update the groups*/
+    uint32_t j;
+    style->has_group = 0;
+    for(i = j = 0; j <= style->prop_cnt;
+        j++) { /*<=: because prop_cnt already reduced but all the old props. needs to be checked.*/
+        if(old_props[j] != prop) {
+            new_values[i] = old_values[j];
+            new_props[i++] = old_props[j];
+            style->has_group |= (uint64_t)1 << _lv_style_get_prop_group(old_props[j]);
         }
     }
 
-    return false;
+    lv_free(old_values);
+    return true;
 }
 
 void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t value)
@@ -295,17 +302,22 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
 
     LV_ASSERT(prop != LV_STYLE_PROP_INV);
 
+#if LV_OBJ_STYLE_VALUE_CACHE
+    /*The style might be used by objects, so their cached values are not valid anymore*/
+    style_value_cache_epoch++;
+#endif
+
     lv_style_prop_t * props;
+    uint32_t pos = 0;
     int32_t i;
 
     if(style->values_and_props) {
         props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            if(props[i] == prop) {
-                lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
-                values[i] = value;
-                return;
-            }
+        pos = _lv_style_find_prop_index(props, style->prop_cnt, prop);
+        if(pos < style->prop_cnt && props[pos] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            values[pos] = value;
+            return;
         }
     }
 
@@ -314,23 +326,30 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     if(values_and_props == NULL) return;
     style->values_and_props = values_and_props;
 
+    /*Shift all props to make place for the value before them and for the new prop at `pos`.
+     *The props are moved to a higher address so go from the end*/
     props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-    /*Shift all props to make place for the value before them*/
-    for(i = style->prop_cnt - 1; i >= 0; i--) {
-        props[i + sizeof(lv_style_value_t) / sizeof(lv_style_prop_t)] = props[i];
+    lv_style_prop_t * new_props = values_and_props + (style->prop_cnt + 1) * sizeof(lv_style_value_t);
+    for(i = style->prop_cnt - 1; i >= (int32_t)pos; i--) {
+        new_props[i + 1] = props[i];
+    }
+    for(i = pos - 1; i >= 0; i--) {
+        new_props[i] = props[i];
     }
-    style->prop_cnt++;
 
-    /*Go to the new position with the props*/
-    props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    /*Make place for the new value too. The old props are not there anymore*/
     lv_style_value_t * values = (lv_style_value_t *)values_and_props;
+    for(i = style->prop_cnt - 1; i >= (int32_t)pos; i--) {
+        values[i + 1] = values[i];
+    }
+    style->prop_cnt++;
 
     /*Set the new property and value*/
-    props[style->prop_cnt - 1] = prop;
-    values[style->prop_cnt - 1] = value;
+    new_props[pos] = prop;
+    values[pos] = value;
 
     uint32_t group = _lv_style_get_prop_group(prop);
-    style->has_group |= (uint32_t)1 << group;
+    style->has_group |= (uint64_t)1 << group;
 }
 
 lv_style_res_t lv_style_get_prop(const lv_style_t * style, lv_style_prop_t prop, lv_style_value_t * value)
@@ -55,14 +55,14 @@ LV_EXPORT_CONST_INT(LV_SCALE_NONE);
     const lv_style_t var_name = {                                       \
         .sentinel = LV_STYLE_SENTINEL_VALUE,                            \
         .values_and_props = (void*)prop_array,                                      \
-        .has_group = 0xFFFFFFFF,                                        \
+        .has_group = UINT64_MAX,                                        \
         .prop_cnt = 255                                               \
     }
 #else
 #define LV_STYLE_CONST_INIT(var_name, prop_array)                       \
     const lv_style_t var_name = {                                       \
         .values_and_props = prop_array,                                      \
-        .has_group = 0xFFFFFFFF,                                        \
+        .has_group = UINT64_MAX,                                        \
         .prop_cnt = 255,                                               \
     }
 #endif
@@ -416,9 +416,11 @@ typedef struct {
     uint32_t sentinel;
 #endif
 
+    /** Not constant styles store the values first and after them the sorted property IDs.
+     *  Constant styles store an array of `lv_style_const_prop_t`*/
     void * values_and_props;
 
-    uint32_t has_group;
+    uint64_t has_group; /**< Bit field of the used property groups. See `_lv_style_get_prop_group`*/
     uint8_t prop_cnt;   /**< 255 means it's a constant style*/
 } lv_style_t;
 
@@ -524,6 +526,43 @@ void lv_style_transition_dsc_init(lv_style_transition_dsc_t * tr, const lv_style
  */
 lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 
+/**
+ * Tell the group of a property. If the a property from a group is set in a style the (1 << group) bit of style->has_group is set.
+ * It allows early skipping the style if the property is not exists in the style at all.
+ * @param prop a style property
+ * @return the group [0..63] 63 means all the properties with ID >= 126 (flex, grid and custom properties)
+ */
+static inline uint32_t _lv_style_get_prop_group(lv_style_prop_t prop)
+{
+    uint32_t group = prop >> 1;
+    if(group > 63) group = 63;    /*The MSB marks all the properties with large ID*/
+    return group;
+}
+
+/**
+ * Find the position of a property in the sorted property IDs of a not constant style
+ * @param props     pointer to the property IDs of a style
+ * @param prop_cnt  number of properties
+ * @param prop      the property to find
+ * @return          index of `prop` if it exists, else the index where it should be inserted
+ */
+static inline uint32_t _lv_style_find_prop_index(const lv_style_prop_t * props, uint32_t prop_cnt,
+                                                 lv_style_prop_t prop)
+{
+    uint32_t first = 0;
+    while(prop_cnt > 0) {
+        uint32_t half = prop_cnt >> 1;
+        if(props[first + half] < prop) {
+            first += half + 1;
+            prop_cnt -= half + 1;
+        }
+        else {
+            prop_cnt = half;
+        }
+    }
+    return first;
+}
+
 /**
  * Get the value of a property
  * @param style pointer to a style
@@ -548,14 +587,14 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
         }
     }
     else {
+        if((style->has_group & ((uint64_t)1 << _lv_style_get_prop_group(prop))) == 0) return LV_STYLE_RES_NOT_FOUND;
+
         lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        uint32_t i;
-        for(i = 0; i < style->prop_cnt; i++) {
-            if(props[i] == prop) {
-                lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
-                *value = values[i];
-                return LV_STYLE_RES_FOUND;
-            }
+        uint32_t i = _lv_style_find_prop_index(props, style->prop_cnt, prop);
+        if(i < style->prop_cnt && props[i] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            *value = values[i];
+            return LV_STYLE_RES_FOUND;
         }
     }
     return LV_STYLE_RES_NOT_FOUND;
@@ -568,20 +607,6 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
  */
 bool lv_style_is_empty(const lv_style_t * style);
 
-/**
- * Tell the group of a property. If the a property from a group is set in a style the (1 << group) bit of style->has_group is set.
- * It allows early skipping the style if the property is not exists in the style at all.
- * @param prop a style property
- * @return the group [0..30] 30 means all the custom properties with index > 120
- */
-static inline uint32_t _lv_style_get_prop_group(lv_style_prop_t prop)
-{
-    uint32_t group = prop >> 2;
-    if(group > 30) group = 31;    /*The MSB marks all the custom properties*/
-    return group;
-
-}
-
 /**
  * Get the flags of a built-in or custom property.
  *
@@ -12,6 +12,7 @@
 #include "../stdlib/lv_sprintf.h"
 #include "lv_assert.h"
 #include "lv_ll.h"
+#include "lv_math.h"
 #include "lv_profiler.h"
 
 /*********************
@@ -20,6 +21,9 @@
 
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_MIN_SIZE 8
+#define NOT_SCHEDULED UINT32_MAX
+#define DUE_FLAG 0x80000000 /*Set in `heap_index` if the timer is in the list of ready timers*/
 
 #define state LV_GLOBAL_DEFAULT()->timer_state
 #define timer_ll_p &(state.timer_ll)
@@ -34,6 +38,14 @@
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
 static void lv_timer_handler_resume(void);
+static bool timer_is_before(const lv_timer_t * a, const lv_timer_t * b);
+static void timer_heap_set(uint32_t index, lv_timer_t * timer);
+static void timer_heap_sift_up(uint32_t index);
+static void timer_heap_sift_down(uint32_t index);
+static void timer_due_add(lv_timer_t * timer, uint32_t cnt);
+static void timer_heap_insert(lv_timer_t * timer);
+static void timer_heap_remove(lv_timer_t * timer);
+static void timer_heap_update(lv_timer_t * timer);
 
 /**********************
  *  STATIC VARIABLES
@@ -90,42 +102,40 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = _lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            timer_active = next; /*Load the next timer*/
+    state_p->timer_round++;
+    while(1) {
+        /*Take the ready timers from the heap. The timers which already ran in this round are
+         *ordered after the ready ones, so stop at the first timer which ran or isn't ready.*/
+        uint32_t due_cnt = 0;
+        while(state_p->timer_heap_cnt > 0) {
+            lv_timer_t * timer_active = state_p->timer_heap[0];
+            if(timer_active->run_round == state_p->timer_round) break;
+            if(lv_timer_time_remaining(timer_active) != 0) break;
+
+            timer_heap_remove(timer_active);
+            timer_active->run_round = state_p->timer_round;
+            timer_due_add(timer_active, due_cnt);
+            due_cnt++;
         }
-    } while(timer_active);
 
-    uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
+        /*No more ready timers, not even ones created or made ready by the callbacks*/
+        if(due_cnt == 0) break;
+
+        uint32_t i;
+        for(i = 0; i < due_cnt; i++) {
+            /*It's NULL if an other timer deleted or paused it*/
+            lv_timer_t * timer_active = state_p->timer_due[i];
+            if(timer_active == NULL) continue;
+
+            state_p->timer_due[i] = NULL;
+            timer_active->heap_index = NOT_SCHEDULED;
+            lv_timer_exec(timer_active);
         }
+    }
 
-        next = _lv_ll_get_next(timer_head, next); /*Find the next timer*/
+    uint32_t time_until_next = LV_NO_TIMER_READY;
+    if(state_p->timer_heap_cnt > 0) {
+        time_until_next = lv_timer_time_remaining(state_p->timer_heap[0]);
     }
 
     state_p->busy_time += lv_tick_elaps(handler_start);
@@ -167,6 +177,22 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Reserve place for every timer to not fail later when a paused timer is resumed*/
+    if(state.timer_cnt >= state.timer_heap_size) {
+        uint32_t new_size = LV_MAX(state.timer_heap_size * 2, HEAP_MIN_SIZE);
+        lv_timer_t ** new_heap = lv_realloc(state.timer_heap, new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_heap);
+        if(new_heap == NULL) return NULL;
+        state.timer_heap = new_heap;
+
+        lv_timer_t ** new_due = lv_realloc(state.timer_due, new_size * sizeof(lv_timer_t *));
+        LV_ASSERT_MALLOC(new_due);
+        if(new_due == NULL) return NULL;
+        lv_memzero(new_due + state.timer_heap_size, (new_size - state.timer_heap_size) * sizeof(lv_timer_t *));
+        state.timer_due = new_due;
+        state.timer_heap_size = new_size;
+    }
+
     new_timer = _lv_ll_ins_head(timer_ll_p);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -178,8 +204,12 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
+    new_timer->run_round = state.timer_round - 1;
+    new_timer->create_id = state.timer_create_cnt++;
+    new_timer->heap_index = NOT_SCHEDULED;
 
-    state.timer_created = true;
+    state.timer_cnt++;
+    timer_heap_insert(new_timer);
 
     lv_timer_handler_resume();
 
@@ -194,7 +224,9 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 
 void lv_timer_delete(lv_timer_t * timer)
 {
+    timer_heap_remove(timer);
     _lv_ll_remove(timer_ll_p, timer);
+    state.timer_cnt--;
     state.timer_deleted = true;
 
     lv_free(timer);
@@ -204,12 +236,14 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+    timer_heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
+    timer_heap_insert(timer);
     lv_timer_handler_resume();
 }
 
@@ -217,18 +251,21 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    timer_heap_update(timer);
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    timer_heap_update(timer);
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     LV_ASSERT_NULL(timer);
     timer->repeat_count = repeat_count;
+    timer_heap_update(timer);
 }
 
 void lv_timer_set_auto_delete(lv_timer_t * timer, bool auto_delete)
@@ -247,6 +284,7 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
+    timer_heap_update(timer);
     lv_timer_handler_resume();
 }
 
@@ -261,6 +299,13 @@ void _lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     _lv_ll_clear(timer_ll_p);
+    lv_free(state.timer_heap);
+    lv_free(state.timer_due);
+    state.timer_heap = NULL;
+    state.timer_due = NULL;
+    state.timer_heap_cnt = 0;
+    state.timer_heap_size = 0;
+    state.timer_cnt = 0;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -292,14 +337,24 @@ static bool lv_timer_exec(lv_timer_t * timer)
 {
     if(timer->paused) return false;
 
+    state.timer_deleted = false;
+
     bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
+    /*An other timer might have reset it since it was found ready*/
+    bool ready = lv_timer_time_remaining(timer) == 0;
+    int32_t original_repeat_count = timer->repeat_count;
+    if(ready) {
         /* Decrement the repeat count before executing the timer_cb.
          * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
          * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
         if(timer->repeat_count > 0) timer->repeat_count--;
         timer->last_run = lv_tick_get();
+    }
+
+    /*Schedule the next run now as the callback might modify or delete the timer*/
+    timer_heap_insert(timer);
+
+    if(ready) {
         LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
 
         if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
@@ -338,6 +393,9 @@ static bool lv_timer_exec(lv_timer_t * timer)
  */
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
 {
+    /*The repeat count is over so it needs to be deleted or paused as soon as possible*/
+    if(timer->repeat_count == 0) return 0;
+
     /*Check if at least 'period' time elapsed*/
     uint32_t elp = lv_tick_elaps(timer->last_run);
     if(elp >= timer->period)
@@ -362,3 +420,126 @@ void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data
     state.resume_cb = cb;
     state.resume_data = data;
 }
+
+/**
+ * Compare the time of the next run of two timers.
+ * The deadlines are compared relative to each other to handle the overflow of the tick.
+ * @param a     pointer to a timer
+ * @param b     pointer to an other timer
+ * @return      true: `a` needs to run before `b`
+ */
+static bool timer_is_before(const lv_timer_t * a, const lv_timer_t * b)
+{
+    uint32_t deadline_a = a->repeat_count == 0 ? a->last_run : a->last_run + a->period;
+    uint32_t deadline_b = b->repeat_count == 0 ? b->last_run : b->last_run + b->period;
+    int32_t diff = (int32_t)(deadline_a - deadline_b);
+    if(diff != 0) return diff < 0;
+
+    /*On the same deadline let the timers run first which haven't run in this round yet*/
+    bool a_ran = a->run_round == state.timer_round;
+    bool b_ran = b->run_round == state.timer_round;
+    return !a_ran && b_ran;
+}
+
+static void timer_heap_set(uint32_t index, lv_timer_t * timer)
+{
+    state.timer_heap[index] = timer;
+    timer->heap_index = index;
+}
+
+static void timer_heap_sift_up(uint32_t index)
+{
+    lv_timer_t * timer = state.timer_heap[index];
+    while(index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if(!timer_is_before(timer, state.timer_heap[parent])) break;
+        timer_heap_set(index, state.timer_heap[parent]);
+        index = parent;
+    }
+    timer_heap_set(index, timer);
+}
+
+static void timer_heap_sift_down(uint32_t index)
+{
+    lv_timer_t * timer = state.timer_heap[index];
+    while(1) {
+        uint32_t child = index * 2 + 1;
+        if(child >= state.timer_heap_cnt) break;
+        if(child + 1 < state.timer_heap_cnt && timer_is_before(state.timer_heap[child + 1], state.timer_heap[child])) child++;
+        if(!timer_is_before(state.timer_heap[child], timer)) break;
+        timer_heap_set(index, state.timer_heap[child]);
+        index = child;
+    }
+    timer_heap_set(index, timer);
+}
+
+/**
+ * Add a ready timer to the list of the timers to run now.
+ * The list is ordered by creation, the most recently created timer runs first.
+ * @param timer     pointer to a ready timer which is not in the heap
+ * @param cnt       number of timers already in the list
+ */
+static void timer_due_add(lv_timer_t * timer, uint32_t cnt)
+{
+    uint32_t i = cnt;
+    while(i > 0 && (int32_t)(state.timer_due[i - 1]->create_id - timer->create_id) < 0) {
+        state.timer_due[i] = state.timer_due[i - 1];
+        state.timer_due[i]->heap_index = DUE_FLAG | i;
+        i--;
+    }
+    state.timer_due[i] = timer;
+    timer->heap_index = DUE_FLAG | i;
+}
+
+/**
+ * Add a timer to the heap if it's not there yet and it's not paused.
+ * The heap always has place for all timers.
+ * @param timer     pointer to a timer
+ */
+static void timer_heap_insert(lv_timer_t * timer)
+{
+    if(timer->heap_index != NOT_SCHEDULED || timer->paused) return;
+
+    timer_heap_set(state.timer_heap_cnt, timer);
+    state.timer_heap_cnt++;
+    timer_heap_sift_up(timer->heap_index);
+}
+
+/**
+ * Remove a timer from the heap if it's there
+ * @param timer     pointer to a timer
+ */
+static void timer_heap_remove(lv_timer_t * timer)
+{
+    uint32_t index = timer->heap_index;
+    if(index == NOT_SCHEDULED) return;
+
+    timer->heap_index = NOT_SCHEDULED;
+
+    /*It's waiting to run in `lv_timer_handler`. Don't run it.*/
+    if(index & DUE_FLAG) {
+        state.timer_due[index & ~DUE_FLAG] = NULL;
+        return;
+    }
+
+    state.timer_heap_cnt--;
+    if(index == state.timer_heap_cnt) return;
+
+    /*Move the last timer to the place of the removed one and restore the order*/
+    timer_heap_set(index, state.timer_heap[state.timer_heap_cnt]);
+    timer_heap_update(state.timer_heap[index]);
+}
+
+/**
+ * Move a timer to its place in the heap after its deadline has changed
+ * @param timer     pointer to a timer
+ */
+static void timer_heap_update(lv_timer_t * timer)
+{
+    /*The ready timers check their deadline again before running*/
+    uint32_t index = timer->heap_index;
+    if(index == NOT_SCHEDULED || (index & DUE_FLAG)) return;
+
+    if(index > 0 && timer_is_before(timer, state.timer_heap[(index - 1) / 2])) timer_heap_sift_up(index);
+    else timer_heap_sift_down(index);
+}
@@ -51,15 +51,26 @@ struct _lv_timer_t {
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
+    uint32_t heap_index; /**< Position in the heap of the scheduled timers or `UINT32_MAX` if not scheduled*/
+    uint32_t run_round; /**< The round of `lv_timer_handler` in which the timer was last checked*/
+    uint32_t create_id; /**< Order of creation. The ready timers run from the most recently created one*/
 };
 
 typedef struct {
     lv_ll_t timer_ll; /*Linked list to store the lv_timers*/
 
+    /*Min-heap of the not paused timers ordered by the time of their next run*/
+    lv_timer_t ** timer_heap;
+    lv_timer_t ** timer_due;    /*The ready timers to run in `lv_timer_handler`*/
+    uint32_t timer_heap_cnt;
+    uint32_t timer_heap_size;   /*Size of both `timer_heap` and `timer_due`*/
+    uint32_t timer_cnt;
+    uint32_t timer_round;
+    uint32_t timer_create_cnt;
+
     bool lv_timer_run;
     uint8_t idle_last;
     bool timer_deleted;
-    bool timer_created;
     uint32_t timer_time_until_next;
 
     bool already_running;
@@ -12,6 +12,7 @@
 
 #include <errno.h>
 #include "../misc/lv_log.h"
+#include "../stdlib/lv_mem.h"
 
 /*********************
  *      DEFINES
@@ -159,7 +160,13 @@ lv_result_t lv_thread_sync_delete(lv_thread_sync_t * sync)
 static void * generic_callback(void * user_data)
 {
     lv_thread_t * thread = user_data;
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_thread_cache_init();
+#endif
     thread->callback(thread->user_data);
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+    lv_mem_thread_cache_flush();
+#endif
     return NULL;
 }
 
@@ -12,6 +12,7 @@
 #if LV_USE_OS == LV_OS_WINDOWS
 
 #include <process.h>
+#include "../stdlib/lv_mem.h"
 
 /*********************
  *      DEFINES
@@ -205,8 +206,14 @@ static unsigned __stdcall thread_start_routine(void * parameter)
 {
     lv_thread_init_data_t * init_data = (lv_thread_init_data_t *)(parameter);
     if(init_data) {
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+        lv_mem_thread_cache_init();
+#endif
         init_data->callback(init_data->user_data);
         free(init_data);
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+        lv_mem_thread_cache_flush();
+#endif
     }
 
     return 0;
@@ -124,6 +124,9 @@ lv_result_t lv_snapshot_take_to_draw_buf(lv_obj_t * obj, lv_color_format_t cf, l
         lv_draw_dispatch();
     }
 
+    /*Rendered outside of the refreshing so release the draw tasks here*/
+    _lv_draw_task_pool_trim();
+
     disp_new->layer_head = layer_old;
     _lv_refr_set_disp_refreshing(disp_old);
 
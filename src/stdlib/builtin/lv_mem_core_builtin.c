@@ -38,18 +38,62 @@
 #endif
 #define state LV_GLOBAL_DEFAULT()->tlsf_state
 
+#if LV_USE_OS && LV_MEM_THREAD_CACHE_SIZE
+    #define THREAD_CACHE                1
+    #define THREAD_CACHE_CLASS_CNT      8
+    #define THREAD_CACHE_DEPTH          16
+    #define THREAD_CACHE_MAX_BLOCK_SIZE 256
+
+    #if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+        #define THREAD_LOCAL _Thread_local
+    #elif defined(__GNUC__) || defined(__clang__)
+        #define THREAD_LOCAL __thread
+    #elif defined(_MSC_VER)
+        #define THREAD_LOCAL __declspec(thread)
+    #else
+        #error "LV_MEM_THREAD_CACHE_SIZE requires thread local variables. Set it to 0."
+    #endif
+#else
+    #define THREAD_CACHE                0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if THREAD_CACHE
+/*Freed small blocks of a thread grouped by size classes.
+ *Only its own thread uses it, the others read it only under the lock (e.g. to monitor the memory)*/
+typedef struct _lv_mem_thread_cache_t {
+    struct _lv_mem_thread_cache_t * next;
+    void * blocks[THREAD_CACHE_CLASS_CNT][THREAD_CACHE_DEPTH];
+    uint8_t cnt[THREAD_CACHE_CLASS_CNT];
+    size_t size;    /*Sum of the size of the cached blocks*/
+} thread_cache_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+#if THREAD_CACHE
+    static int32_t thread_cache_get_class(size_t size);
+    static thread_cache_t * thread_cache_get(void);
+    static void thread_cache_create(void);
+    static void thread_cache_flush(thread_cache_t * cache, uint32_t keep);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if THREAD_CACHE
+static const uint16_t class_sizes[THREAD_CACHE_CLASS_CNT] = {16, 32, 48, 64, 96, 128, 192, 256};
+
+/*The caches are allocated from the heap, so they are valid only in the generation of the heap
+ *in which they were created. It's incremented in every `lv_mem_init`.*/
+static uint32_t heap_generation;
+static THREAD_LOCAL thread_cache_t * thread_cache;
+static THREAD_LOCAL uint32_t thread_cache_generation;
+#endif
 
 /**********************
  *      MACROS
@@ -74,6 +118,11 @@ void lv_mem_init(void)
     lv_mutex_init(&state.mutex);
 #endif
 
+#if THREAD_CACHE
+    state.thread_cache_ll = NULL;
+    heap_generation++;
+#endif
+
 #if LV_MEM_ADR == 0
 #ifdef LV_MEM_POOL_ALLOC
     state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE), LV_MEM_SIZE);
@@ -138,16 +187,47 @@ void lv_mem_remove_pool(lv_mem_pool_t pool)
 
 void * lv_malloc_core(size_t size)
 {
+#if THREAD_CACHE
+    int32_t class_id = -1;
+    if(size <= THREAD_CACHE_MAX_BLOCK_SIZE) {
+        /*Round up to the size class to be able to reuse the block for any size of the class*/
+        class_id = 0;
+        while(class_sizes[class_id] < size) class_id++;
+        size = class_sizes[class_id];
+
+        thread_cache_t * cache = thread_cache_get();
+        if(cache && cache->cnt[class_id] > 0) {
+            cache->cnt[class_id]--;
+            void * p = cache->blocks[class_id][cache->cnt[class_id]];
+            cache->size -= lv_tlsf_block_size(p);
+            return p;
+        }
+    }
+#endif
+
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
     void * p = lv_tlsf_malloc(state.tlsf, size);
 
+#if THREAD_CACHE
+    if(p == NULL && thread_cache_get()) {
+        /*Give back the cached blocks and try again*/
+        thread_cache_flush(thread_cache, 0);
+        p = lv_tlsf_malloc(state.tlsf, size);
+    }
+#endif
+
     if(p) {
         state.cur_used += lv_tlsf_block_size(p);
         state.max_used = LV_MAX(state.cur_used, state.max_used);
     }
 
+#if THREAD_CACHE
+    /*Create the cache of the thread when it first allocates a small block*/
+    if(class_id >= 0) thread_cache_create();
+#endif
+
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
 #endif
@@ -177,6 +257,24 @@ void * lv_realloc_core(void * p, size_t new_size)
 
 void lv_free_core(void * p)
 {
+#if THREAD_CACHE
+    thread_cache_t * cache = thread_cache_get();
+    bool cache_full = false;
+    if(cache) {
+        size_t size = lv_tlsf_block_size(p);
+        int32_t class_id = thread_cache_get_class(size);
+        if(class_id >= 0) {
+            if(cache->cnt[class_id] < THREAD_CACHE_DEPTH && cache->size + size <= LV_MEM_THREAD_CACHE_SIZE) {
+                cache->blocks[class_id][cache->cnt[class_id]] = p;
+                cache->cnt[class_id]++;
+                cache->size += size;
+                return;
+            }
+            cache_full = true;
+        }
+    }
+#endif
+
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
@@ -189,22 +287,81 @@ void lv_free_core(void * p)
     if(state.cur_used > size) state.cur_used -= size;
     else state.cur_used = 0;
 
+#if THREAD_CACHE
+    /*The cache was full: keep only half of it to not hoard the memory from the other threads*/
+    if(cache_full) thread_cache_flush(thread_cache, THREAD_CACHE_DEPTH / 2);
+#endif
+
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
 #endif
 }
 
+void lv_mem_thread_cache_init(void)
+{
+#if THREAD_CACHE
+    lv_mutex_lock(&state.mutex);
+    thread_cache_create();
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
+void lv_mem_thread_cache_flush(void)
+{
+#if THREAD_CACHE
+    thread_cache_t * cache = thread_cache_get();
+    if(cache == NULL) return;
+
+    lv_mutex_lock(&state.mutex);
+    thread_cache_flush(cache, 0);
+
+    /*Delete the cache too as the thread might exit. It will be created again if needed.*/
+    thread_cache_t ** next_p = &state.thread_cache_ll;
+    while(*next_p != cache) next_p = &(*next_p)->next;
+    *next_p = cache->next;
+    lv_tlsf_free(state.tlsf, cache);
+    thread_cache = NULL;
+
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+
 void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
 {
     /*Init the data*/
     lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
     LV_TRACE_MEM("begin");
 
+#if THREAD_CACHE
+    /*Give back the own cached blocks to report the same as without the cache.
+     *The cached blocks of the other threads are counted as free below.*/
+    if(thread_cache_get()) {
+        lv_mutex_lock(&state.mutex);
+        thread_cache_flush(thread_cache, 0);
+        lv_mutex_unlock(&state.mutex);
+    }
+#endif
+
     lv_pool_t * pool_p;
     _LV_LL_READ(&state.pool_ll, pool_p) {
         lv_tlsf_walk_pool(*pool_p, lv_mem_walker, mon_p);
     }
 
+#if THREAD_CACHE
+    /*The cached blocks are free for the application*/
+    lv_mutex_lock(&state.mutex);
+    thread_cache_t * cache;
+    for(cache = state.thread_cache_ll; cache; cache = cache->next) {
+        uint32_t i;
+        for(i = 0; i < THREAD_CACHE_CLASS_CNT; i++) {
+            mon_p->used_cnt -= cache->cnt[i];
+            mon_p->free_cnt += cache->cnt[i];
+        }
+        mon_p->free_size += cache->size;
+    }
+    lv_mutex_unlock(&state.mutex);
+#endif
+
     mon_p->used_pct = 100 - (uint64_t)100U * mon_p->free_size / mon_p->total_size;
     if(mon_p->free_size > 0) {
         mon_p->frag_pct = (uint64_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
@@ -270,4 +427,69 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
             mon_p->free_biggest_size = size;
     }
 }
+
+#if THREAD_CACHE
+
+/**
+ * Get the class of a free block
+ * @param size      the size of the block
+ * @return          index of the largest class not larger than the block or -1 if it's not cached
+ */
+static int32_t thread_cache_get_class(size_t size)
+{
+    if(size < class_sizes[0] || size > THREAD_CACHE_MAX_BLOCK_SIZE) return -1;
+
+    int32_t class_id = THREAD_CACHE_CLASS_CNT - 1;
+    while(class_sizes[class_id] > size) class_id--;
+    return class_id;
+}
+
+/**
+ * Get the cache of the current thread
+ * @return          the cache or NULL if the thread has no cache in the current heap
+ */
+static thread_cache_t * thread_cache_get(void)
+{
+    if(thread_cache_generation != heap_generation) return NULL;
+    return thread_cache;
+}
+
+/**
+ * Create the cache of the current thread if it doesn't have one yet. `state.mutex` needs to be locked.
+ */
+static void thread_cache_create(void)
+{
+    if(thread_cache_get()) return;
+
+    thread_cache_t * cache = lv_tlsf_malloc(state.tlsf, sizeof(thread_cache_t));
+    if(cache == NULL) return;
+
+    lv_memzero(cache, sizeof(thread_cache_t));
+    cache->next = state.thread_cache_ll;
+    state.thread_cache_ll = cache;
+    thread_cache = cache;
+    thread_cache_generation = heap_generation;
+}
+
+/**
+ * Free the cached blocks. `state.mutex` needs to be locked.
+ * @param cache     the cache to flush
+ * @param keep      keep this many blocks in each class
+ */
+static void thread_cache_flush(thread_cache_t * cache, uint32_t keep)
+{
+    uint32_t i;
+    for(i = 0; i < THREAD_CACHE_CLASS_CNT; i++) {
+        while(cache->cnt[i] > keep) {
+            cache->cnt[i]--;
+            void * p = cache->blocks[i][cache->cnt[i]];
+            size_t size = lv_tlsf_block_size(p);
+            cache->size -= size;
+            lv_tlsf_free(state.tlsf, p);
+            if(state.cur_used > size) state.cur_used -= size;
+            else state.cur_used = 0;
+        }
+    }
+}
+#endif
 #endif /*LV_STDLIB_BUILTIN*/
@@ -62,6 +62,9 @@ typedef struct {
     size_t cur_used;
     size_t max_used;
     lv_ll_t  pool_ll;
+#if LV_USE_OS && LV_MEM_THREAD_CACHE_SIZE
+    struct _lv_mem_thread_cache_t * thread_cache_ll;  /*Linked list of the small block caches of the threads*/
+#endif
 } lv_tlsf_state_t;
 
 /* Create/destroy a memory pool. */
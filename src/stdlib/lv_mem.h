@@ -59,6 +59,21 @@ void lv_mem_deinit(void);
 
 lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes);
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+/**
+ * Create the cache of small blocks for the current thread (see `LV_MEM_THREAD_CACHE_SIZE`).
+ * It's created on the first small allocation anyway, but creating it when the thread starts
+ * makes the memory usage more predictable. Threads created by `lv_thread_init` call it automatically.
+ */
+void lv_mem_thread_cache_init(void);
+
+/**
+ * Give back the small blocks cached by the current thread to the heap (see `LV_MEM_THREAD_CACHE_SIZE`).
+ * Should be called before a thread exits. Threads created by `lv_thread_init` call it automatically.
+ */
+void lv_mem_thread_cache_flush(void);
+#endif
+
 void lv_mem_remove_pool(lv_mem_pool_t pool);
 
 /**
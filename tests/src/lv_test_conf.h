@@ -21,8 +21,17 @@ extern "C" {
 #define LV_USE_STDLIB_STRING        LV_STDLIB_CLIB
 #define LV_USE_STDLIB_SPRINTF       LV_STDLIB_CLIB
 #define LV_USE_OS                   LV_OS_PTHREAD
+#define LV_DRAW_SW_DRAW_UNIT_CNT    2   /* Run test with parallel rendering and split draw tasks */
 #define LV_OBJ_STYLE_CACHE          0
+#define LV_OBJ_STYLE_VALUE_CACHE    64  /* Run test with resolved style value cache */
 #define LV_BIN_DECODER_RAM_LOAD     1   /* Run test with bin image loaded to RAM */
+#define LV_FONT_FMT_TXT_CACHE_SIZE  256 /* Run test with glyph ID and kerning cache */
+#define LV_IMAGE_DECODER_ASYNC_THREAD_CNT 1 /* Run test with background image decoding */
+#define LV_GIF_PREDECODE_FRAME_CNT  2   /* Run test with GIF frames decoded in the background */
+#define LV_IMAGE_CACHE_POLICY       LV_CACHE_POLICY_HASH    /* Run test with lock-free image cache lookup */
+#if defined(__SSE2__)
+#define LV_USE_DRAW_SW_ASM          LV_DRAW_SW_ASM_X86      /* Run test with the SSE2 rotation and swap kernels */
+#endif
 #endif
 
 #ifdef LVGL_CI_USING_DEF_HEAP
@@ -31,6 +40,7 @@ extern "C" {
 #define LV_USE_STDLIB_SPRINTF   LV_STDLIB_BUILTIN
 #define LV_OBJ_STYLE_CACHE      1
 #define LV_BIN_DECODER_RAM_LOAD 0
+#define LV_IMAGE_CACHE_POLICY   LV_CACHE_POLICY_COST    /* Run test with cost-aware image cache */
 #endif
 
 #ifdef MICROPYTHON
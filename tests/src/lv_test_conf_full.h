@@ -112,6 +112,7 @@
 #define LV_USE_OBJ_ID_BUILTIN   1
 
 #define LV_CACHE_DEF_SIZE       (10 * 1024 * 1024)
+#define LV_IMAGE_DECODER_TILE_SIZE  64
 
 #ifndef LV_USE_LINUX_DRM
     #define LV_USE_LINUX_DRM    1
@@ -120,6 +121,7 @@
 #ifndef LV_USE_LINUX_FBDEV
     #define LV_USE_LINUX_FBDEV  1
 #endif
+#define LV_LINUX_FBDEV_PAGE_FLIP    1
 
 #define LV_USE_ILI9341      1
 #define LV_USE_ST7735       1
@@ -0,0 +1,401 @@
+#if LV_BUILD_TEST
+
+#include "../lvgl.h"
+#include "lv_test_helpers.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_OS == LV_OS_PTHREAD
+    #include <pthread.h>
+#endif
+
+typedef struct {
+    lv_cache_slot_size_t slot;
+    int32_t key;
+} test_data_t;
+
+static lv_cache_t * cache;
+static uint32_t free_cnt;
+static bool same_hash;
+
+static lv_cache_compare_res_t compare_cb(const test_data_t * lhs, const test_data_t * rhs)
+{
+    if(lhs->key != rhs->key) {
+        return lhs->key > rhs->key ? 1 : -1;
+    }
+    return 0;
+}
+
+static uint32_t hash_cb(const test_data_t * key)
+{
+    /*Put all the entries in the same probe chain*/
+    if(same_hash) return 0;
+
+    return (uint32_t)key->key * 2654435761U;
+}
+
+static void free_cb(test_data_t * node, void * user_data)
+{
+    LV_UNUSED(user_data);
+    node->key = -1;
+    free_cnt++;
+}
+
+static void create_cache(const lv_cache_class_t * clz, uint32_t max_size)
+{
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t) compare_cb,
+        .hash_cb = (lv_cache_hash_cb_t) hash_cb,
+        .create_cb = NULL,
+        .free_cb = (lv_cache_free_cb_t) free_cb,
+    };
+    cache = lv_cache_create(clz, sizeof(test_data_t), max_size, ops);
+    TEST_ASSERT_NOT_NULL(cache);
+}
+
+/*Acquire an entry or add it if it's not cached yet, like the image decoder does*/
+static void use(int32_t key, uint32_t size, uint32_t cost)
+{
+    test_data_t search_key = {
+        .slot.size = size,
+        .key = key,
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
+    if(entry == NULL) {
+        entry = lv_cache_add(cache, &search_key, NULL);
+        TEST_ASSERT_NOT_NULL(entry);
+        lv_cache_entry_set_cost(entry, cost);
+    }
+
+    lv_cache_release(cache, entry, NULL);
+}
+
+static bool is_cached(int32_t key)
+{
+    test_data_t search_key = {
+        .key = key,
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
+    if(entry == NULL) return false;
+
+    lv_cache_release(cache, entry, NULL);
+    return true;
+}
+
+/*Use a few entries in every frame while scrolling through many others which are shown only once*/
+static void scan(void)
+{
+    int32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_tick_inc(LV_DEF_REFR_PERIOD);
+        use(1, 1, 1);
+        use(2, 1, 1);
+        use(1000 + i, 1, 1);
+        use(1000 + i, 1, 1);    /*Used more times in the same frame*/
+    }
+}
+
+void setUp(void)
+{
+    free_cnt = 0;
+    same_hash = false;
+}
+
+void tearDown(void)
+{
+    if(cache) lv_cache_destroy(cache, NULL);
+    cache = NULL;
+}
+
+void test_cache_policy_stats(void)
+{
+    size_t mem_before = lv_test_get_free_mem();
+    create_cache(&lv_cache_class_lru_rb_count, 2);
+
+    use(1, 1, 1);       /*miss*/
+    use(1, 1, 1);       /*hit*/
+    use(2, 1, 1);       /*miss*/
+    use(3, 1, 1);       /*miss, evict 1*/
+
+    lv_cache_stats_t stats;
+    lv_cache_get_stats(cache, &stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.evict_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, free_cnt);
+
+    lv_cache_reset_stats(cache);
+    lv_cache_get_stats(cache, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.miss_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.evict_cnt);
+
+    lv_cache_destroy(cache, NULL);
+    cache = NULL;
+    TEST_ASSERT_EQUAL_UINT32(3, free_cnt);
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+}
+
+void test_cache_policy_lru_scan(void)
+{
+    create_cache(&lv_cache_class_lru_rb_count, 4);
+    scan();
+
+    /*Fine as the frequently used entries are used in every frame*/
+    TEST_ASSERT_TRUE(is_cached(1));
+    TEST_ASSERT_TRUE(is_cached(2));
+
+    /*But they are evicted if they are not used for a few frames*/
+    int32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_tick_inc(LV_DEF_REFR_PERIOD);
+        use(2000 + i, 1, 1);
+    }
+    TEST_ASSERT_FALSE(is_cached(1));
+    TEST_ASSERT_FALSE(is_cached(2));
+}
+
+void test_cache_policy_2q_scan(void)
+{
+    size_t mem_before = lv_test_get_free_mem();
+    create_cache(&lv_cache_class_2q_rb_count, 4);
+    scan();
+
+    /*The entries which were used only in one frame are evicted first*/
+    int32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_tick_inc(LV_DEF_REFR_PERIOD);
+        use(2000 + i, 1, 1);
+    }
+    TEST_ASSERT_TRUE(is_cached(1));
+    TEST_ASSERT_TRUE(is_cached(2));
+    TEST_ASSERT_TRUE(is_cached(2003));
+    TEST_ASSERT_FALSE(is_cached(1099));
+
+    lv_cache_stats_t stats;
+    lv_cache_get_stats(cache, &stats);
+    TEST_ASSERT_EQUAL_UINT32(106 - 4, stats.evict_cnt);
+
+    lv_cache_destroy(cache, NULL);
+    cache = NULL;
+    TEST_ASSERT_EQUAL_UINT32(106, free_cnt);
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+}
+
+void test_cache_policy_2q_size(void)
+{
+    create_cache(&lv_cache_class_2q_rb_size, 1000);
+
+    /*Used in two frames*/
+    use(1, 600, 1);
+    lv_tick_inc(LV_DEF_REFR_PERIOD);
+    use(1, 600, 1);
+
+    /*Used only once and evicted when the next one is added*/
+    use(2, 300, 1);
+    use(3, 300, 1);
+    TEST_ASSERT_TRUE(is_cached(1));
+    TEST_ASSERT_FALSE(is_cached(2));
+    TEST_ASSERT_TRUE(is_cached(3));
+    TEST_ASSERT_EQUAL(900, lv_cache_get_size(cache, NULL));
+
+    /*The frequently used ones are evicted too if needed*/
+    use(4, 1000, 1);
+    TEST_ASSERT_FALSE(is_cached(1));
+    TEST_ASSERT_FALSE(is_cached(3));
+    TEST_ASSERT_TRUE(is_cached(4));
+    TEST_ASSERT_EQUAL(1000, lv_cache_get_size(cache, NULL));
+}
+
+void test_cache_policy_cost(void)
+{
+    size_t mem_before = lv_test_get_free_mem();
+    create_cache(&lv_cache_class_cost_rb_size, 1000);
+
+    use(1, 400, 100);   /*Slow to create*/
+    use(2, 400, 1);     /*Fast to create*/
+
+    /*The fast one is evicted even if it was used later*/
+    use(3, 400, 1);
+    TEST_ASSERT_TRUE(is_cached(1));
+    TEST_ASSERT_FALSE(is_cached(2));
+    TEST_ASSERT_TRUE(is_cached(3));
+
+    /*Smaller entries are kept with the same cost*/
+    use(4, 100, 1);
+    use(5, 400, 1);
+    TEST_ASSERT_TRUE(is_cached(1));
+    TEST_ASSERT_FALSE(is_cached(3));
+    TEST_ASSERT_TRUE(is_cached(4));
+    TEST_ASSERT_TRUE(is_cached(5));
+
+    /*The not used entries age, so the slow one is evicted too at the end*/
+    int32_t i;
+    for(i = 0; i < 200; i++) {
+        use(1000 + i, 400, 1);
+    }
+    TEST_ASSERT_FALSE(is_cached(1));
+
+    lv_cache_destroy(cache, NULL);
+    cache = NULL;
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+}
+
+void test_cache_policy_cost_count(void)
+{
+    create_cache(&lv_cache_class_cost_rb_count, 2);
+
+    /*With the same cost it's LRU*/
+    use(1, 0, 1);
+    use(2, 0, 1);
+    use(1, 0, 1);
+    use(3, 0, 1);
+    TEST_ASSERT_TRUE(is_cached(1));
+    TEST_ASSERT_FALSE(is_cached(2));
+    TEST_ASSERT_TRUE(is_cached(3));
+}
+
+void test_cache_policy_clock_hash(void)
+{
+    size_t mem_before = lv_test_get_free_mem();
+    create_cache(&lv_cache_class_clock_hash_count, 4);
+
+    use(1, 1, 1);
+    use(2, 1, 1);
+    use(3, 1, 1);
+    use(4, 1, 1);
+
+    /*The entry used between the evictions is kept*/
+    int32_t i;
+    for(i = 0; i < 20; i++) {
+        use(1, 1, 1);
+        use(100 + i, 1, 1);
+    }
+    TEST_ASSERT_TRUE(is_cached(1));
+    TEST_ASSERT_TRUE(is_cached(119));
+    TEST_ASSERT_FALSE(is_cached(2));
+    TEST_ASSERT_EQUAL(4, lv_cache_get_size(cache, NULL));
+
+    lv_cache_stats_t stats;
+    lv_cache_get_stats(cache, &stats);
+    TEST_ASSERT_EQUAL_UINT32(20, stats.evict_cnt);
+
+    lv_cache_destroy(cache, NULL);
+    cache = NULL;
+    TEST_ASSERT_EQUAL_UINT32(24, free_cnt);
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+}
+
+void test_cache_policy_clock_hash_collision(void)
+{
+    size_t mem_before = lv_test_get_free_mem();
+    same_hash = true;
+    create_cache(&lv_cache_class_clock_hash_size, 1000);
+
+    /*The table grows while adding them*/
+    int32_t i;
+    for(i = 0; i < 100; i++) {
+        use(i, 2, 1);
+    }
+    TEST_ASSERT_EQUAL(200, lv_cache_get_size(cache, NULL));
+
+    /*The remaining entries are found after the removed ones*/
+    for(i = 0; i < 100; i += 2) {
+        test_data_t search_key = {.key = i};
+        lv_cache_drop(cache, &search_key, NULL);
+    }
+    for(i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL(i % 2 == 1, is_cached(i));
+    }
+    TEST_ASSERT_EQUAL(100, lv_cache_get_size(cache, NULL));
+
+    /*The slots of the removed entries are reused*/
+    for(i = 100; i < 200; i++) {
+        use(i, 2, 1);
+    }
+    for(i = 100; i < 200; i++) {
+        TEST_ASSERT_TRUE(is_cached(i));
+    }
+    TEST_ASSERT_EQUAL(300, lv_cache_get_size(cache, NULL));
+
+    lv_cache_drop_all(cache, NULL);
+    TEST_ASSERT_FALSE(is_cached(101));
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(cache, NULL));
+
+    lv_cache_destroy(cache, NULL);
+    cache = NULL;
+    TEST_ASSERT_EQUAL_UINT32(200, free_cnt);
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+}
+
+#if LV_USE_OS == LV_OS_PTHREAD
+
+#define THREAD_KEY_CNT  64
+
+static uint32_t thread_error_cnt;
+
+static void * reader_thread(void * arg)
+{
+    uint32_t seed = (uint32_t)(lv_uintptr_t)arg;
+    int32_t i;
+    for(i = 0; i < 20000; i++) {
+        seed = seed * 1103515245U + 12345U;
+        test_data_t search_key = {.key = (seed >> 16) % THREAD_KEY_CNT};
+
+        lv_cache_entry_t * entry = lv_cache_acquire(cache, &search_key, NULL);
+        if(entry == NULL) continue;
+
+        /*It must not be freed while it's acquired*/
+        test_data_t * data = lv_cache_entry_get_data(entry);
+        if(data->key != search_key.key) __atomic_add_fetch(&thread_error_cnt, 1, __ATOMIC_RELAXED);
+        lv_cache_release(cache, entry, NULL);
+    }
+
+    return NULL;
+}
+
+#endif
+
+void test_cache_policy_clock_hash_threads(void)
+{
+#if LV_USE_OS == LV_OS_PTHREAD
+    size_t mem_before = lv_test_get_free_mem();
+    create_cache(&lv_cache_class_clock_hash_count, THREAD_KEY_CNT / 4);
+    thread_error_cnt = 0;
+
+    pthread_t threads[4];
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, reader_thread, (void *)(lv_uintptr_t)(i + 1));
+    }
+
+    /*Add, evict and drop the entries while the others are reading them*/
+    for(i = 0; i < 5000; i++) {
+        use((i * 7) % THREAD_KEY_CNT, 1, 1);
+        if(i % 5 == 0) {
+            test_data_t search_key = {.key = (i * 3) % THREAD_KEY_CNT};
+            lv_cache_drop(cache, &search_key, NULL);
+        }
+    }
+
+    for(i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, thread_error_cnt);
+
+    lv_cache_stats_t stats;
+    lv_cache_get_stats(cache, &stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.hit_cnt);
+
+    lv_cache_destroy(cache, NULL);
+    cache = NULL;
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+#else
+    TEST_PASS();
+#endif
+}
+
+#endif
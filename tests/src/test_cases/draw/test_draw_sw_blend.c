@@ -0,0 +1,331 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "../src/draw/sw/blend/lv_draw_sw_blend_to_rgb888.h"
+#include "../src/draw/sw/blend/lv_draw_sw_blend_to_argb8888.h"
+
+#include "unity/unity.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*Blend random images with all the opa and mask variants and compare the result
+ *with a pixel by pixel implementation of the mixing formulas.
+ *The assembly/intrinsic kernels (e.g. LV_DRAW_SW_ASM_X86) need to give exactly the same result.*/
+
+#define SRC_COLOR   LV_COLOR_FORMAT_UNKNOWN     /*Fill with a color instead of an image*/
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static uint32_t px_size_of(lv_color_format_t cf)
+{
+    return lv_color_format_get_size(cf);
+}
+
+static const char * cf_name(lv_color_format_t cf)
+{
+    switch(cf) {
+        case SRC_COLOR:
+            return "COLOR";
+        case LV_COLOR_FORMAT_RGB565:
+            return "RGB565";
+        case LV_COLOR_FORMAT_RGB888:
+            return "RGB888";
+        case LV_COLOR_FORMAT_XRGB8888:
+            return "XRGB8888";
+        case LV_COLOR_FORMAT_ARGB8888:
+            return "ARGB8888";
+        default:
+            return "?";
+    }
+}
+
+/*The pairs with a reference implementation below*/
+static bool has_ref(lv_color_format_t dest_cf, lv_color_format_t src_cf)
+{
+    if(src_cf == SRC_COLOR || src_cf == LV_COLOR_FORMAT_ARGB8888) return true;
+    if(dest_cf == LV_COLOR_FORMAT_RGB565) return true;
+    if(dest_cf == LV_COLOR_FORMAT_ARGB8888) return false;
+    return src_cf != LV_COLOR_FORMAT_RGB565;
+}
+
+/*Random bytes but with plenty of the special 0 and 255 values*/
+static void fill_random(uint8_t * buf, uint32_t size)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        uint32_t r = lv_rand(0, 9);
+        if(r == 0) buf[i] = 0;
+        else if(r < 3) buf[i] = 255;
+        else buf[i] = lv_rand(0, 255);
+    }
+}
+
+static uint16_t ref_24_16_mix(const uint8_t * c1, uint16_t c2, uint8_t mix)
+{
+    if(mix == 0) return c2;
+    if(mix == 255) return ((c1[2] & 0xF8) << 8) + ((c1[1] & 0xFC) << 3) + ((c1[0] & 0xF8) >> 3);
+
+    lv_opa_t mix_inv = 255 - mix;
+    return ((((c1[2] >> 3) * mix + ((c2 >> 11) & 0x1F) * mix_inv) << 3) & 0xF800) +
+           ((((c1[1] >> 2) * mix + ((c2 >> 5) & 0x3F) * mix_inv) >> 3) & 0x07E0) +
+           (((c1[0] >> 3) * mix + (c2 & 0x1F) * mix_inv) >> 8);
+}
+
+static void ref_24_24_mix(const uint8_t * src, uint8_t * dest, uint8_t mix)
+{
+    if(mix == 0) return;
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        if(mix >= LV_OPA_MAX) dest[i] = src[i];
+        else dest[i] = (uint32_t)((uint32_t)src[i] * mix + dest[i] * (255 - mix)) >> 8;
+    }
+}
+
+static lv_color32_t ref_32_32_mix(lv_color32_t fg, lv_color32_t bg)
+{
+    if(fg.alpha >= LV_OPA_MAX || bg.alpha <= LV_OPA_MIN) return fg;
+    if(fg.alpha <= LV_OPA_MIN) return bg;
+    if(bg.alpha == 255) return lv_color_mix32(fg, bg);
+
+    lv_opa_t res_alpha = 255 - LV_OPA_MIX2(255 - fg.alpha, 255 - bg.alpha);
+    fg.alpha = (uint32_t)((uint32_t)fg.alpha * 255) / res_alpha;
+    lv_color32_t res = lv_color_mix32(fg, bg);
+    res.alpha = res_alpha;
+    return res;
+}
+
+/*Blend one pixel the way the C implementation of the blend functions does*/
+static void ref_blend_px(lv_color_format_t dest_cf, uint8_t * dest, lv_color_format_t src_cf, const uint8_t * src,
+                         lv_color_t color, lv_opa_t opa, const lv_opa_t * mask)
+{
+    uint8_t color_u8[4] = {color.blue, color.green, color.red, 0xff};
+    uint16_t color16 = lv_color_to_u16(color);
+    bool plain = mask == NULL && opa >= LV_OPA_MAX;
+
+    lv_opa_t mix;
+    if(src_cf == LV_COLOR_FORMAT_ARGB8888) {
+        mix = src[3];
+        if(mask && opa < LV_OPA_MAX) mix = LV_OPA_MIX3(mix, *mask, opa);
+        else if(mask) mix = LV_OPA_MIX2(mix, *mask);
+        else if(opa < LV_OPA_MAX) mix = LV_OPA_MIX2(mix, opa);
+    }
+    else {
+        if(mask && opa < LV_OPA_MAX) mix = LV_OPA_MIX2(*mask, opa);
+        else if(mask) mix = *mask;
+        else mix = plain ? 255 : opa;
+    }
+
+    if(src_cf == SRC_COLOR) src = color_u8;
+
+    if(dest_cf == LV_COLOR_FORMAT_RGB565) {
+        uint16_t * dest16 = (uint16_t *)dest;
+        if(src_cf == SRC_COLOR || src_cf == LV_COLOR_FORMAT_RGB565) {
+            uint16_t fg = src_cf == SRC_COLOR ? color16 : *(const uint16_t *)src;
+            *dest16 = lv_color_16_16_mix(fg, *dest16, mix);
+        }
+        else {
+            *dest16 = ref_24_16_mix(src, *dest16, mix);
+        }
+    }
+    else if(dest_cf == LV_COLOR_FORMAT_ARGB8888) {
+        lv_color32_t fg = {.blue = src[0], .green = src[1], .red = src[2], .alpha = mix};
+        if(plain && src_cf == SRC_COLOR) fg.alpha = 0xff;
+        *(lv_color32_t *)dest = ref_32_32_mix(fg, *(lv_color32_t *)dest);
+    }
+    else {
+        /*The 4th byte is written only when filling or copying*/
+        if(plain && src_cf == SRC_COLOR && dest_cf == LV_COLOR_FORMAT_XRGB8888) dest[3] = 0xff;
+        if(plain && src_cf == dest_cf && dest_cf == LV_COLOR_FORMAT_XRGB8888) dest[3] = src[3];
+        ref_24_24_mix(src, dest, mix);
+    }
+}
+
+static void blend(lv_color_format_t dest_cf, uint8_t * dest, int32_t dest_stride, lv_color_format_t src_cf,
+                  const uint8_t * src, int32_t src_stride, int32_t w, int32_t h, lv_color_t color, lv_opa_t opa,
+                  const lv_opa_t * mask, int32_t mask_stride)
+{
+    if(src_cf == SRC_COLOR) {
+        _lv_draw_sw_blend_fill_dsc_t dsc = {
+            .dest_buf = dest, .dest_w = w, .dest_h = h, .dest_stride = dest_stride,
+            .mask_buf = mask, .mask_stride = mask_stride, .color = color, .opa = opa
+        };
+        if(dest_cf == LV_COLOR_FORMAT_RGB565) lv_draw_sw_blend_color_to_rgb565(&dsc);
+        else if(dest_cf == LV_COLOR_FORMAT_ARGB8888) lv_draw_sw_blend_color_to_argb8888(&dsc);
+        else lv_draw_sw_blend_color_to_rgb888(&dsc, px_size_of(dest_cf));
+    }
+    else {
+        _lv_draw_sw_blend_image_dsc_t dsc = {
+            .dest_buf = dest, .dest_w = w, .dest_h = h, .dest_stride = dest_stride,
+            .mask_buf = mask, .mask_stride = mask_stride, .src_buf = src, .src_stride = src_stride,
+            .src_color_format = src_cf, .opa = opa, .blend_mode = LV_BLEND_MODE_NORMAL
+        };
+        if(dest_cf == LV_COLOR_FORMAT_RGB565) lv_draw_sw_blend_image_to_rgb565(&dsc);
+        else if(dest_cf == LV_COLOR_FORMAT_ARGB8888) lv_draw_sw_blend_image_to_argb8888(&dsc);
+        else lv_draw_sw_blend_image_to_rgb888(&dsc, px_size_of(dest_cf));
+    }
+}
+
+static void check_blend(lv_color_format_t dest_cf, lv_color_format_t src_cf, int32_t w, int32_t h)
+{
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_MAX, 200, 127, 3, LV_OPA_MIN};
+    uint32_t dest_px_size = px_size_of(dest_cf);
+    uint32_t src_px_size = src_cf == SRC_COLOR ? 0 : px_size_of(src_cf);
+
+    /*Odd strides to check the row handling too*/
+    int32_t dest_stride = (w + 3) * dest_px_size;
+    int32_t src_stride = (w + 5) * src_px_size;
+    int32_t mask_stride = w + 7;
+    uint32_t dest_size = dest_stride * h;
+    uint8_t * dest = malloc(dest_size);
+    uint8_t * dest_ref = malloc(dest_size);
+    uint8_t * dest_ori = malloc(dest_size);
+    uint8_t * src = malloc(LV_MAX(src_stride * h, 1));
+    lv_opa_t * mask = malloc(mask_stride * h);
+
+    uint32_t o;
+    for(o = 0; o < sizeof(opas) * 2; o++) {
+        lv_opa_t opa = opas[o / 2];
+        bool use_mask = o & 1;
+        lv_color_t color = lv_color_make(lv_rand(0, 255), lv_rand(0, 255), lv_rand(0, 255));
+
+        fill_random(dest_ori, dest_size);
+        fill_random(src, src_stride * h);
+        fill_random(mask, mask_stride * h);
+        if(dest_cf == LV_COLOR_FORMAT_ARGB8888) {
+            /*Mostly opaque background as it's the typical case*/
+            uint32_t i;
+            for(i = 3; i < dest_size; i += 4) if(lv_rand(0, 3)) dest_ori[i] = 0xff;
+        }
+
+        lv_memcpy(dest_ref, dest_ori, dest_size);
+        int32_t x, y;
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                ref_blend_px(dest_cf, &dest_ref[y * dest_stride + x * dest_px_size], src_cf,
+                             &src[y * src_stride + x * src_px_size], color, opa,
+                             use_mask ? &mask[y * mask_stride + x] : NULL);
+            }
+        }
+
+        lv_memcpy(dest, dest_ori, dest_size);
+        blend(dest_cf, dest, dest_stride, src_cf, src, src_stride, w, h, color, opa,
+              use_mask ? mask : NULL, mask_stride);
+
+        for(y = 0; y < h; y++) {
+            char msg[128];
+            lv_snprintf(msg, sizeof(msg), "dest cf: %d, src cf: %d, w: %d, opa: %d, mask: %d, row: %d",
+                        dest_cf, src_cf, (int)w, opa, use_mask, (int)y);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY_MESSAGE(&dest_ref[y * dest_stride], &dest[y * dest_stride],
+                                                  dest_stride, msg);
+        }
+    }
+
+    free(dest);
+    free(dest_ref);
+    free(dest_ori);
+    free(src);
+    free(mask);
+}
+
+static const lv_color_format_t src_cfs[] = {
+    SRC_COLOR, LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB888, LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_ARGB8888
+};
+
+static void check_dest(lv_color_format_t dest_cf)
+{
+    static const int32_t widths[] = {1, 7, 8, 9, 31, 100};
+    uint32_t s, i;
+    for(s = 0; s < sizeof(src_cfs) / sizeof(src_cfs[0]); s++) {
+        if(!has_ref(dest_cf, src_cfs[s])) continue;
+        for(i = 0; i < sizeof(widths) / sizeof(widths[0]); i++) {
+            check_blend(dest_cf, src_cfs[s], widths[i], 5);
+        }
+    }
+}
+
+void test_blend_to_rgb565(void)
+{
+    check_dest(LV_COLOR_FORMAT_RGB565);
+}
+
+void test_blend_to_rgb888(void)
+{
+    check_dest(LV_COLOR_FORMAT_RGB888);
+}
+
+void test_blend_to_xrgb8888(void)
+{
+    check_dest(LV_COLOR_FORMAT_XRGB8888);
+}
+
+void test_blend_to_argb8888(void)
+{
+    check_dest(LV_COLOR_FORMAT_ARGB8888);
+}
+
+static double get_time_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+/*Print the throughput of the kernels. Compare the output of builds with and without LV_USE_DRAW_SW_ASM*/
+void test_blend_benchmark(void)
+{
+    static const lv_color_format_t dest_cfs[] = {
+        LV_COLOR_FORMAT_RGB565, LV_COLOR_FORMAT_RGB888, LV_COLOR_FORMAT_XRGB8888, LV_COLOR_FORMAT_ARGB8888
+    };
+    static const char * variants[] = {"normal", "with opa", "with mask", "mix mask opa"};
+    const int32_t w = 800;
+    const int32_t h = 480;
+    const uint32_t rep = 10;
+
+    uint8_t * dest = malloc(w * h * 4);
+    uint8_t * src = malloc(w * h * 4);
+    lv_opa_t * mask = malloc(w * h);
+    fill_random(src, w * h * 4);
+    fill_random(mask, w * h);
+
+    uint32_t d, s, v, i;
+    for(d = 0; d < sizeof(dest_cfs) / sizeof(dest_cfs[0]); d++) {
+        lv_color_format_t dest_cf = dest_cfs[d];
+        int32_t dest_stride = w * px_size_of(dest_cf);
+        lv_memset(dest, 0xff, w * h * 4);
+
+        for(s = 0; s < sizeof(src_cfs) / sizeof(src_cfs[0]); s++) {
+            lv_color_format_t src_cf = src_cfs[s];
+            if(!has_ref(dest_cf, src_cf)) continue;
+            int32_t src_stride = src_cf == SRC_COLOR ? 0 : w * px_size_of(src_cf);
+            for(v = 0; v < 4; v++) {
+                lv_opa_t opa = (v & 1) ? LV_OPA_50 : LV_OPA_COVER;
+                const lv_opa_t * mask_buf = (v & 2) ? mask : NULL;
+                double t = get_time_ms();
+                for(i = 0; i < rep; i++) {
+                    blend(dest_cf, dest, dest_stride, src_cf, src, src_stride, w, h, lv_color_hex(0x336699), opa,
+                          mask_buf, w);
+                }
+                t = (get_time_ms() - t) / rep;
+                printf("%s to %s %s: %.3f ms, %.1f Mpx/s\n",
+                       cf_name(src_cf), cf_name(dest_cf), variants[v], t, (w * h) / (t * 1000.0));
+            }
+        }
+    }
+
+    free(dest);
+    free(src);
+    free(mask);
+}
+
+#endif
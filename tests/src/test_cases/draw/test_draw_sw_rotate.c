@@ -3,6 +3,10 @@
 
 #include "unity/unity.h"
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -224,4 +228,220 @@ void test_rotate270_ARGB8888(void)
     TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedArray, dstArray, sizeof(dstArray));
 }
 
+/*Rotate pixel by pixel to have a reference*/
+static void ref_rotate(const uint8_t * src, uint8_t * dst, int32_t w, int32_t h, int32_t src_stride,
+                       int32_t dst_stride, lv_display_rotation_t rotation, uint32_t px_size)
+{
+    for(int32_t y = 0; y < h; y++) {
+        for(int32_t x = 0; x < w; x++) {
+            int32_t dst_x = x;
+            int32_t dst_y = y;
+            if(rotation == LV_DISPLAY_ROTATION_90) {
+                dst_x = y;
+                dst_y = w - x - 1;
+            }
+            else if(rotation == LV_DISPLAY_ROTATION_180) {
+                dst_x = w - x - 1;
+                dst_y = h - y - 1;
+            }
+            else if(rotation == LV_DISPLAY_ROTATION_270) {
+                dst_x = h - y - 1;
+                dst_y = x;
+            }
+            lv_memcpy(dst + dst_y * dst_stride + dst_x * px_size, src + y * src_stride + x * px_size, px_size);
+        }
+    }
+}
+
+static void ref_swap(uint16_t * buf, uint32_t px_cnt)
+{
+    for(uint32_t i = 0; i < px_cnt; i++) buf[i] = (uint16_t)((buf[i] << 8) | (buf[i] >> 8));
+}
+
+static void fill_random(uint8_t * buf, uint32_t size)
+{
+    uint32_t seed = 12345;
+    for(uint32_t i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        buf[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+static void check_rotate(lv_color_format_t cf, int32_t w, int32_t h)
+{
+    static const lv_display_rotation_t rotations[] = {
+        LV_DISPLAY_ROTATION_90, LV_DISPLAY_ROTATION_180, LV_DISPLAY_ROTATION_270
+    };
+    uint32_t px_size = lv_color_format_get_size(cf);
+
+    /*Add some padding to the strides and don't start at the beginning of the buffers*/
+    int32_t src_stride = (w + 3) * px_size;
+    int32_t dst_stride = (LV_MAX(w, h) + 5) * px_size;
+    uint32_t dst_size = dst_stride * LV_MAX(w, h);
+    uint8_t * src = malloc(src_stride * h + px_size);
+    uint8_t * dst = malloc(dst_size + px_size);
+    uint8_t * ref = malloc(dst_size);
+    fill_random(src, src_stride * h + px_size);
+
+    for(uint32_t i = 0; i < sizeof(rotations) / sizeof(rotations[0]); i++) {
+        /*RGB888 is rotated in the other direction by 90 and 270 degrees*/
+        lv_display_rotation_t ref_rotation = rotations[i];
+        if(cf == LV_COLOR_FORMAT_RGB888 && ref_rotation != LV_DISPLAY_ROTATION_180) {
+            ref_rotation = ref_rotation == LV_DISPLAY_ROTATION_90 ? LV_DISPLAY_ROTATION_270 : LV_DISPLAY_ROTATION_90;
+        }
+
+        lv_memzero(dst, dst_size + px_size);
+        lv_memzero(ref, dst_size);
+        lv_draw_sw_rotate(src + px_size, dst + px_size, w, h, src_stride, dst_stride, rotations[i], cf);
+        ref_rotate(src + px_size, ref, w, h, src_stride, dst_stride, ref_rotation, px_size);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref, dst + px_size, dst_size);
+    }
+
+    free(src);
+    free(dst);
+    free(ref);
+}
+
+void test_rotate_odd_sizes(void)
+{
+    /*Sizes which are not multiple of the tiles and blocks*/
+    check_rotate(LV_COLOR_FORMAT_RGB565, 77, 45);
+    check_rotate(LV_COLOR_FORMAT_RGB565, 5, 130);
+    check_rotate(LV_COLOR_FORMAT_RGB888, 77, 45);
+    check_rotate(LV_COLOR_FORMAT_ARGB8888, 77, 45);
+    check_rotate(LV_COLOR_FORMAT_XRGB8888, 130, 3);
+}
+
+void test_rgb565_swap(void)
+{
+    uint16_t * buf = malloc(37 * sizeof(uint16_t));
+    uint16_t ref[37];
+    fill_random((uint8_t *)buf, 37 * sizeof(uint16_t));
+    lv_memcpy(ref, buf, sizeof(ref));
+
+    /*An odd number of pixels, the last one must be untouched*/
+    lv_draw_sw_rgb565_swap(buf, 35);
+    ref_swap(ref, 35);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(ref, buf, 37);
+
+    free(buf);
+}
+
+void test_rgb565_rotate_swap(void)
+{
+    static const lv_display_rotation_t rotations[] = {
+        LV_DISPLAY_ROTATION_0, LV_DISPLAY_ROTATION_90, LV_DISPLAY_ROTATION_180, LV_DISPLAY_ROTATION_270
+    };
+    int32_t w = 67;
+    int32_t h = 41;
+    int32_t src_stride = (w + 2) * 2;
+    int32_t dst_stride = w * 2;
+    uint32_t dst_size = dst_stride * w;
+    uint8_t * src = malloc(src_stride * h);
+    uint8_t * dst = malloc(dst_size);
+    uint8_t * ref = malloc(dst_size);
+    fill_random(src, src_stride * h);
+
+    for(uint32_t i = 0; i < sizeof(rotations) / sizeof(rotations[0]); i++) {
+        lv_memzero(dst, dst_size);
+        lv_memzero(ref, dst_size);
+        lv_draw_sw_rgb565_rotate_swap(src, dst, w, h, src_stride, dst_stride, rotations[i]);
+        ref_rotate(src, ref, w, h, src_stride, dst_stride, rotations[i], 2);
+        ref_swap((uint16_t *)ref, dst_size / 2);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(ref, dst, dst_size);
+    }
+
+    free(src);
+    free(dst);
+    free(ref);
+}
+
+/*The column by column rotation used before, to compare the speed with*/
+static void old_rotate90_rgb565(const uint16_t * src, uint16_t * dst, int32_t w, int32_t h)
+{
+    for(int32_t x = 0; x < w; ++x) {
+        int32_t srcIndex = x;
+        for(int32_t y = 0; y < h; ++y) {
+            dst[(w - x - 1) * h + y] = src[srcIndex];
+            srcIndex += w;
+        }
+    }
+}
+
+static void old_rotate90_argb8888(const uint32_t * src, uint32_t * dst, int32_t w, int32_t h)
+{
+    for(int32_t x = 0; x < w; ++x) {
+        int32_t srcIndex = x;
+        for(int32_t y = 0; y < h; ++y) {
+            dst[(w - x - 1) * h + y] = src[srcIndex];
+            srcIndex += w;
+        }
+    }
+}
+
+static double get_time_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+void test_rotate_benchmark(void)
+{
+    static const int32_t res[][2] = {{320, 240}, {800, 480}, {1920, 1080}};
+
+    for(uint32_t r = 0; r < sizeof(res) / sizeof(res[0]); r++) {
+        int32_t w = res[r][0];
+        int32_t h = res[r][1];
+        uint32_t px_cnt = w * h;
+        uint32_t rep = LV_MAX(1, 4000000 / px_cnt);
+        uint8_t * src = malloc(px_cnt * 4);
+        uint8_t * dst = malloc(px_cnt * 4);
+        fill_random(src, px_cnt * 4);
+
+        double t_old, t_new, t_two_pass;
+        uint32_t i;
+
+        t_old = get_time_ms();
+        for(i = 0; i < rep; i++) old_rotate90_argb8888((uint32_t *)src, (uint32_t *)dst, w, h);
+        t_old = (get_time_ms() - t_old) / rep;
+        t_new = get_time_ms();
+        for(i = 0; i < rep; i++) lv_draw_sw_rotate(src, dst, w, h, w * 4, h * 4, LV_DISPLAY_ROTATION_90,
+                                                       LV_COLOR_FORMAT_ARGB8888);
+        t_new = (get_time_ms() - t_new) / rep;
+        printf("%dx%d ARGB8888 rotate 90: %.3f ms -> %.3f ms\n", (int)w, (int)h, t_old, t_new);
+
+        t_old = get_time_ms();
+        for(i = 0; i < rep; i++) old_rotate90_rgb565((uint16_t *)src, (uint16_t *)dst, w, h);
+        t_old = (get_time_ms() - t_old) / rep;
+        t_new = get_time_ms();
+        for(i = 0; i < rep; i++) lv_draw_sw_rotate(src, dst, w, h, w * 2, h * 2, LV_DISPLAY_ROTATION_90,
+                                                       LV_COLOR_FORMAT_RGB565);
+        t_new = (get_time_ms() - t_new) / rep;
+        printf("%dx%d RGB565 rotate 90: %.3f ms -> %.3f ms\n", (int)w, (int)h, t_old, t_new);
+
+        t_old = get_time_ms();
+        for(i = 0; i < rep; i++) ref_swap((uint16_t *)src, px_cnt);
+        t_old = (get_time_ms() - t_old) / rep;
+        t_new = get_time_ms();
+        for(i = 0; i < rep; i++) lv_draw_sw_rgb565_swap(src, px_cnt);
+        t_new = (get_time_ms() - t_new) / rep;
+        printf("%dx%d RGB565 swap: %.3f ms -> %.3f ms\n", (int)w, (int)h, t_old, t_new);
+
+        t_two_pass = get_time_ms();
+        for(i = 0; i < rep; i++) {
+            lv_draw_sw_rotate(src, dst, w, h, w * 2, h * 2, LV_DISPLAY_ROTATION_90, LV_COLOR_FORMAT_RGB565);
+            lv_draw_sw_rgb565_swap(dst, px_cnt);
+        }
+        t_two_pass = (get_time_ms() - t_two_pass) / rep;
+        t_new = get_time_ms();
+        for(i = 0; i < rep; i++) lv_draw_sw_rgb565_rotate_swap(src, dst, w, h, w * 2, h * 2, LV_DISPLAY_ROTATION_90);
+        t_new = (get_time_ms() - t_new) / rep;
+        printf("%dx%d RGB565 rotate 90 and swap: %.3f ms -> %.3f ms\n", (int)w, (int)h, t_two_pass, t_new);
+
+        free(src);
+        free(dst);
+    }
+}
+
 #endif
@@ -0,0 +1,86 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * canvas;
+static lv_draw_buf_t * draw_buf;
+
+void setUp(void)
+{
+    draw_buf = lv_draw_buf_create(400, 400, LV_COLOR_FORMAT_ARGB8888, 0);
+    canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_draw_buf(canvas, draw_buf);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_draw_buf_destroy(draw_buf);
+}
+
+static lv_draw_task_t * add_fill(lv_layer_t * layer, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_hex(0xff0000);
+
+    lv_area_t a = {x1, y1, x2, y2};
+    lv_draw_rect(layer, &dsc, &a);
+
+    return layer->_draw_task_tail;
+}
+
+void test_draw_task_dependency_overlapping_tasks_wait(void)
+{
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_task_t * t1 = add_fill(&layer, 0, 0, 99, 99);
+    lv_draw_task_t * t2 = add_fill(&layer, 200, 0, 299, 99);
+    lv_draw_task_t * t3 = add_fill(&layer, 50, 50, 249, 149);
+    lv_draw_task_t * t4 = add_fill(&layer, 300, 300, 399, 399);
+    lv_draw_task_t * t5 = add_fill(&layer, 0, 0, 399, 399);
+
+    TEST_ASSERT_EQUAL_UINT32(0, t1->_dep_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, t2->_dep_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, t3->_dep_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, t4->_dep_cnt);
+    TEST_ASSERT_EQUAL_UINT32(4, t5->_dep_cnt);
+
+    uint8_t unit_id = t1->preferred_draw_unit_id;
+    TEST_ASSERT_EQUAL_PTR(t1, lv_draw_get_next_available_task(&layer, NULL, unit_id));
+    TEST_ASSERT_EQUAL_PTR(t2, lv_draw_get_next_available_task(&layer, t1, unit_id));
+    TEST_ASSERT_EQUAL_PTR(t4, lv_draw_get_next_available_task(&layer, t2, unit_id));
+    TEST_ASSERT_NULL(lv_draw_get_next_available_task(&layer, t4, unit_id));
+
+    lv_canvas_finish_layer(canvas, &layer);
+    TEST_ASSERT_NULL(layer.draw_task_head);
+    TEST_ASSERT_NULL(layer._task_grid);
+    TEST_ASSERT_EQUAL_COLOR32(lv_color_to_32(lv_color_hex(0xff0000), 0xff), lv_canvas_get_px(canvas, 399, 0));
+}
+
+void test_draw_task_dependency_many_tasks(void)
+{
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    /*A grid of independent tasks and a few large ones covering them*/
+    uint32_t i;
+    for(i = 0; i < 10000; i++) {
+        int32_t x = (i % 100) * 4;
+        int32_t y = ((i / 100) % 100) * 4;
+        lv_draw_task_t * t = add_fill(&layer, x, y, x + 3, y + 3);
+        TEST_ASSERT_EQUAL_UINT32(0, t->_dep_cnt);
+    }
+
+    lv_draw_task_t * t_big = add_fill(&layer, 0, 0, 399, 7);
+    TEST_ASSERT_EQUAL_UINT32(200, t_big->_dep_cnt);
+
+    lv_canvas_finish_layer(canvas, &layer);
+    TEST_ASSERT_NULL(layer.draw_task_head);
+    TEST_ASSERT_NULL(layer._draw_task_tail);
+    TEST_ASSERT_NULL(layer._task_grid);
+}
+
+#endif
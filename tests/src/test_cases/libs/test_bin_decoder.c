@@ -88,4 +88,61 @@ void test_bin_decoder_argb8888_tile(void)
     bin_decoder_tile(&test_image_cogwheel_argb8888, "libs/bin_decoder_4.png");
 }
 
+void test_bin_decoder_mapped_file(void)
+{
+    /*Write an image whose stride is already aligned, so it can be used as it is*/
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(64, 48, LV_COLOR_FORMAT_ARGB8888, 0);
+    uint32_t x, y;
+    for(y = 0; y < draw_buf->header.h; y++) {
+        lv_color32_t * px = (lv_color32_t *)(draw_buf->data + y * draw_buf->header.stride);
+        for(x = 0; x < draw_buf->header.w; x++) {
+            px[x].red = x * 4;
+            px[x].green = y * 5;
+            px[x].blue = 0x80;
+            px[x].alpha = 0xff - x * 2;
+        }
+    }
+
+    lv_fs_file_t f;
+    uint32_t bw;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "B:mapped_test.bin", LV_FS_MODE_WR));
+    lv_image_header_t header = draw_buf->header;
+    header.flags = 0;
+    lv_fs_write(&f, &header, sizeof(header), &bw);
+    lv_fs_write(&f, draw_buf->data, draw_buf->data_size, &bw);
+    lv_fs_close(&f);
+
+    /*'B' (POSIX) can map the file, 'A' (STDIO) reads it*/
+    const char * mapped_src = "B:mapped_test.bin";
+    const char * read_src = "A:mapped_test.bin";
+
+    lv_image_decoder_args_t args = {
+        .stride_align = LV_DRAW_BUF_STRIDE_ALIGN != 1,
+    };
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, mapped_src, &args));
+
+    /*The pixels are used from the file, so they are not added to the cache*/
+    TEST_ASSERT_NULL(dsc.cache_entry);
+    TEST_ASSERT_NOT_NULL(dsc.decoded);
+    TEST_ASSERT_EQUAL_UINT32(draw_buf->header.stride, dsc.decoded->header.stride);
+    TEST_ASSERT_EQUAL_MEMORY(draw_buf->data, dsc.decoded->data, draw_buf->data_size);
+    lv_image_decoder_close(&dsc);
+    lv_draw_buf_destroy(draw_buf);
+
+    /*Rendered the same way as the read file*/
+    create_image(read_src);
+    lv_refr_now(NULL);
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    uint8_t * ref_buf = lv_malloc(buf->data_size);
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+    lv_obj_clean(lv_screen_active());
+
+    create_image(mapped_src);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+    lv_obj_clean(lv_screen_active());
+    lv_free(ref_buf);
+}
+
 #endif
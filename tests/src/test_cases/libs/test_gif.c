@@ -0,0 +1,110 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <unistd.h>
+
+/*60x80 GIF whose frames change only small areas*/
+#define GIF_SRC "A:src/test_assets/test_img_bulb.gif"
+
+static uint8_t * ref_buf;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_free(ref_buf);
+    ref_buf = NULL;
+}
+
+/*Let the GIF's timer run and return the number of refreshed pixels*/
+static uint32_t step(uint32_t ms)
+{
+#if LV_GIF_PREDECODE_FRAME_CNT
+    /*Give time to the thread to decode the next frames*/
+    usleep(1000);
+#endif
+
+    /*Pause the refresh to be sure it runs after the invalidation*/
+    lv_tick_inc(ms);
+    lv_timer_pause(lv_display_get_refr_timer(NULL));
+    lv_timer_handler();
+    lv_timer_resume(lv_display_get_refr_timer(NULL));
+    lv_refr_now(NULL);
+
+    return lv_display_get_refr_px_cnt(NULL);
+}
+
+/*Redraw everything and check if the result is the same as it was*/
+static void check_frame(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    if(ref_buf == NULL) ref_buf = lv_malloc(buf->data_size);
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+}
+
+/*Play the GIF and return how many times only a part of it was redrawn*/
+static uint32_t play(lv_obj_t * gif, uint32_t step_cnt)
+{
+    lv_area_t gif_area = gif->coords;
+    int32_t ext_size = _lv_obj_get_ext_draw_size(gif);
+    lv_area_increase(&gif_area, ext_size, ext_size);
+    uint32_t gif_px_cnt = lv_area_get_size(&gif_area);
+    uint32_t partial_cnt = 0;
+
+    uint32_t i;
+    for(i = 0; i < step_cnt; i++) {
+        uint32_t px_cnt = step(10);
+        if(px_cnt == 0) continue;
+
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(gif_px_cnt, px_cnt);
+        if(px_cnt < gif_px_cnt) partial_cnt++;
+        check_frame();
+    }
+
+    return partial_cnt;
+}
+
+void test_gif_invalidate_changed_area(void)
+{
+    lv_obj_t * gif = lv_gif_create(lv_screen_active());
+    lv_gif_set_src(gif, GIF_SRC);
+    lv_obj_center(gif);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_GREATER_THAN_UINT32(10, play(gif, 300));
+
+    /*Transformed images are redrawn entirely*/
+    lv_image_set_scale(gif, 512);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, play(gif, 100));
+}
+
+void test_gif_restart(void)
+{
+    lv_obj_t * gif = lv_gif_create(lv_screen_active());
+    lv_gif_set_src(gif, GIF_SRC);
+    lv_obj_center(gif);
+    lv_refr_now(NULL);
+    play(gif, 100);
+
+    lv_gif_restart(gif);
+    play(gif, 100);
+
+    /*Open it again while it's playing*/
+    lv_gif_set_src(gif, GIF_SRC);
+    lv_refr_now(NULL);
+    check_frame();
+    play(gif, 100);
+}
+
+#endif
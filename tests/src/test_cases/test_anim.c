@@ -4,6 +4,15 @@
 #include "unity/unity.h"
 #include "lv_test_helpers.h"
 
+#include <stdio.h>
+#include <time.h>
+
+#define MANY_ANIM_CNT 1000
+
+static int32_t vars[4];
+static uint32_t deleted_cnt;
+static int32_t many_vars[MANY_ANIM_CNT];
+
 void setUp(void)
 {
     /* Function run before every test */
@@ -26,6 +35,39 @@ static void custom_exec_cb(lv_anim_t * a, int32_t v)
     *var_i32 = v;
 }
 
+static void deleted_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    deleted_cnt++;
+}
+
+static void completed_cb(lv_anim_t * a)
+{
+    LV_UNUSED(a);
+    /*Delete an animation which is after this one in the list and start a new one*/
+    lv_anim_delete(&vars[1], exec_cb);
+
+    lv_anim_t a_new;
+    lv_anim_init(&a_new);
+    lv_anim_set_var(&a_new, &vars[3]);
+    lv_anim_set_values(&a_new, 0, 100);
+    lv_anim_set_exec_cb(&a_new, exec_cb);
+    lv_anim_set_duration(&a_new, 100);
+    lv_anim_start(&a_new);
+}
+
+static void start_anim(int32_t * var, uint32_t duration)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, var);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_duration(&a, duration);
+    lv_anim_set_deleted_cb(&a, deleted_cb);
+    lv_anim_start(&a);
+}
+
 void test_anim_delete(void)
 {
     int32_t var;
@@ -90,4 +132,89 @@ void test_anim_delete_custom(void)
     TEST_ASSERT_EQUAL(39, var);
 }
 
+void test_anim_delete_in_completed_cb(void)
+{
+    lv_memzero(vars, sizeof(vars));
+    deleted_cnt = 0;
+    uint32_t cnt_start = lv_anim_count_running();
+
+    start_anim(&vars[1], 100);
+    start_anim(&vars[2], 100);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &vars[0]);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_duration(&a, 20);
+    lv_anim_set_completed_cb(&a, completed_cb);
+    lv_anim_start(&a);
+    TEST_ASSERT_EQUAL(cnt_start + 3, lv_anim_count_running());
+
+    lv_test_wait(20);
+    TEST_ASSERT_EQUAL(100, vars[0]);
+    TEST_ASSERT_EQUAL(1, deleted_cnt);
+    TEST_ASSERT_NULL(lv_anim_get(&vars[0], exec_cb));
+    TEST_ASSERT_NULL(lv_anim_get(&vars[1], exec_cb));
+    TEST_ASSERT_NOT_NULL(lv_anim_get(&vars[3], exec_cb));
+    TEST_ASSERT_EQUAL(cnt_start + 2, lv_anim_count_running());
+
+    /*The deleted animation stops, the others continue*/
+    int32_t var_1 = vars[1];
+    lv_test_wait(20);
+    TEST_ASSERT_EQUAL(var_1, vars[1]);
+    TEST_ASSERT_EQUAL(39, vars[2]);
+    TEST_ASSERT_EQUAL(19, vars[3]);
+
+    lv_anim_delete(&vars[2], NULL);
+    lv_anim_delete(&vars[3], NULL);
+    TEST_ASSERT_EQUAL(2, deleted_cnt);
+    TEST_ASSERT_EQUAL(cnt_start, lv_anim_count_running());
+}
+
+void test_anim_many(void)
+{
+    lv_memzero(many_vars, sizeof(many_vars));
+    deleted_cnt = 0;
+    uint32_t cnt_start = lv_anim_count_running();
+
+    uint32_t i;
+    for(i = 0; i < MANY_ANIM_CNT; i++) {
+        start_anim(&many_vars[i], 100 + i);
+    }
+    TEST_ASSERT_EQUAL(cnt_start + MANY_ANIM_CNT, lv_anim_count_running());
+
+    clock_t t = clock();
+    for(i = 0; i < MANY_ANIM_CNT; i++) {
+        lv_anim_t * a = lv_anim_get(&many_vars[i], exec_cb);
+        TEST_ASSERT_NOT_NULL(a);
+        TEST_ASSERT_EQUAL_PTR(&many_vars[i], a->var);
+    }
+
+    /*Restarting replaces the running animation of the same var and exec_cb*/
+    for(i = 0; i < MANY_ANIM_CNT; i += 2) {
+        start_anim(&many_vars[i], 50);
+    }
+    TEST_ASSERT_EQUAL(MANY_ANIM_CNT / 2, deleted_cnt);
+
+    for(i = 1; i < MANY_ANIM_CNT; i += 2) {
+        TEST_ASSERT_TRUE(lv_anim_delete(&many_vars[i], NULL));
+    }
+    t = clock() - t;
+    printf("Getting, restarting and deleting %d animations: %ld clocks\n", MANY_ANIM_CNT, (long)t);
+
+    TEST_ASSERT_EQUAL(MANY_ANIM_CNT, deleted_cnt);
+    TEST_ASSERT_EQUAL(cnt_start + MANY_ANIM_CNT / 2, lv_anim_count_running());
+
+    t = clock();
+    lv_test_wait(50);
+    t = clock() - t;
+    printf("Running %d animations for 50 ms: %ld clocks\n", MANY_ANIM_CNT / 2, (long)t);
+
+    for(i = 0; i < MANY_ANIM_CNT; i++) {
+        TEST_ASSERT_EQUAL(i % 2 ? 0 : 100, many_vars[i]);
+    }
+    TEST_ASSERT_EQUAL(cnt_start, lv_anim_count_running());
+}
+
 #endif
@@ -118,4 +118,48 @@ void test_pct(void)
     TEST_ASSERT_EQUAL_INT32(-PCT_MAX_VALUE, LV_COORD_GET_PCT(pct_coord));
 }
 
+void test_area_diff(void)
+{
+    lv_area_t a1 = {10, 10, 109, 109};
+    lv_area_t res[4];
+    int8_t res_c;
+    int8_t i;
+    int8_t j;
+
+    /*No common part*/
+    lv_area_t a_out = {200, 200, 209, 209};
+    TEST_ASSERT_EQUAL_INT8(-1, _lv_area_diff(res, &a1, &a_out));
+
+    /*Fully covered*/
+    lv_area_t a_cover = {0, 0, 199, 199};
+    TEST_ASSERT_EQUAL_INT8(0, _lv_area_diff(res, &a1, &a_cover));
+
+    /*A hole in the middle: the pieces should cover exactly the rest of the area*/
+    lv_area_t a_hole = {40, 40, 59, 59};
+    res_c = _lv_area_diff(res, &a1, &a_hole);
+    TEST_ASSERT_EQUAL_INT8(4, res_c);
+
+    uint32_t size_sum = 0;
+    lv_area_t com;
+    for(i = 0; i < res_c; i++) {
+        TEST_ASSERT_TRUE(_lv_area_is_in(&res[i], &a1, 0));
+        TEST_ASSERT_FALSE(_lv_area_intersect(&com, &res[i], &a_hole));
+        for(j = i + 1; j < res_c; j++) {
+            TEST_ASSERT_FALSE(_lv_area_intersect(&com, &res[i], &res[j]));
+        }
+        size_sum += lv_area_get_size(&res[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(lv_area_get_size(&a1) - lv_area_get_size(&a_hole), size_sum);
+
+    /*Overlapping on the right side*/
+    lv_area_t a_right = {100, 50, 150, 69};
+    res_c = _lv_area_diff(res, &a1, &a_right);
+    size_sum = 0;
+    for(i = 0; i < res_c; i++) {
+        TEST_ASSERT_FALSE(_lv_area_intersect(&com, &res[i], &a_right));
+        size_sum += lv_area_get_size(&res[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(lv_area_get_size(&a1) - 10 * 20, size_sum);
+}
+
 #endif
@@ -0,0 +1,220 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "../../../src/misc/lv_text_private.h"
+
+#include <stdio.h>
+#include <time.h>
+
+/*Texts of the multilang demo*/
+static const char * texts[] = {
+    "对编程和技术充满热情。 开源倡导者",
+    "عاشق تاریخ و عاشق همه چیز عتیقه. قسمت مورد علاقه من قرن 19 است.",
+    "Aspirante romanziere con la passione per il caffè e i gatti",
+    "קורא נלהב שצובר אוסף עצום של ספרים יקרים",
+    "عاشق للأفلام وناقد سينمائي عرضي. معجب بستيفن سبيلبرغ (Steven Spielberg). ",
+    "Håpløs romantisk søker etter den spesielle personen",
+    "Любитель приключений, опытный альпинист.",
+    "Fanatique de sport et fan de l'équipe à domicile.",
+    "Hudebník a návštěvník koncertů",
+    "Språkinlärare och kulturentusiast ",
+};
+
+/*A font with 'A' and 'V' only and kerning pairs*/
+static const lv_font_fmt_txt_glyph_dsc_t kern_glyph_dsc[] = {
+    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0}, /*id = 0 reserved*/
+    {.bitmap_index = 0, .adv_w = 160, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0},
+    {.bitmap_index = 0, .adv_w = 160, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0},
+};
+
+static const uint16_t kern_unicode_list[] = {0, 'V' - 'A'};
+
+static const lv_font_fmt_txt_cmap_t kern_cmaps[] = {
+    {
+        .range_start = 'A', .range_length = 'V' - 'A' + 1, .glyph_id_start = 1,
+        .unicode_list = kern_unicode_list, .glyph_id_ofs_list = NULL, .list_length = 2,
+        .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY
+    }
+};
+
+static const uint8_t kern_pair_glyph_ids[] = {
+    1, 2,
+    2, 1,
+};
+
+static const int8_t kern_pair_values[] = {-16, 8};
+
+static const lv_font_fmt_txt_kern_pair_t kern_pairs = {
+    .glyph_ids = kern_pair_glyph_ids,
+    .values = kern_pair_values,
+    .pair_cnt = 2,
+    .glyph_ids_size = 0
+};
+
+static const uint8_t kern_glyph_bitmap[] = {0};
+
+static const lv_font_fmt_txt_dsc_t kern_font_dsc = {
+    .glyph_bitmap = kern_glyph_bitmap,
+    .glyph_dsc = kern_glyph_dsc,
+    .cmaps = kern_cmaps,
+    .kern_dsc = &kern_pairs,
+    .kern_scale = 16,
+    .cmap_num = 1,
+    .bpp = 4,
+    .kern_classes = 0,
+    .bitmap_format = 0,
+};
+
+static const lv_font_t kern_font = {
+    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,
+    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,
+    .line_height = 16,
+    .base_line = 0,
+    .dsc = &kern_font_dsc,
+};
+
+static uint32_t get_gid(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    if(!lv_font_get_glyph_dsc(font, &g, letter, 0)) return 0;
+    return g.gid.index;
+}
+
+static uint32_t get_adv_w(const lv_font_t * font, uint32_t letter, uint32_t letter_next)
+{
+    lv_font_glyph_dsc_t g;
+    if(!lv_font_get_glyph_dsc(font, &g, letter, letter_next)) return 0;
+    return g.adv_w;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_font_fmt_txt_cache_glyph_ids(void)
+{
+    const lv_font_t * font = &lv_font_simsun_16_cjk;
+
+    /*Letters in the different cmaps, not found letters and invalid letters*/
+    static const uint32_t letters[] = {'A', 'z', 0x4E00, 0x5BF9, 0x7F16, 0x9FA5, 0x3002, 0xFF0C, 0x1F600, 0x10FFFF, 0x110000, 0xFFFFFFFF};
+    uint32_t gids[sizeof(letters) / sizeof(letters[0])];
+
+    uint32_t i;
+    for(i = 0; i < sizeof(letters) / sizeof(letters[0]); i++) gids[i] = get_gid(font, letters[i]);
+
+    TEST_ASSERT_NOT_EQUAL(0, gids[0]);
+    TEST_ASSERT_NOT_EQUAL(0, gids[2]);
+    TEST_ASSERT_EQUAL(0, gids[8]);
+    TEST_ASSERT_EQUAL(0, gids[10]);
+    TEST_ASSERT_EQUAL(0, gids[11]);
+
+    /*The same results from the cache and after the whole cache is replaced*/
+    uint32_t round;
+    for(round = 0; round < 3; round++) {
+        for(i = 0; i < sizeof(letters) / sizeof(letters[0]); i++) {
+            TEST_ASSERT_EQUAL_UINT32(gids[i], get_gid(font, letters[i]));
+        }
+
+        uint32_t letter;
+        for(letter = 0x4E00; letter < 0x9FA6; letter++) get_gid(font, letter);
+    }
+
+    /*The glyph IDs grow with the letters in the cmaps of this font, so check them in a range*/
+    uint32_t gid_prev = 0;
+    uint32_t letter;
+    for(letter = 0x4E00; letter < 0x9FA6; letter++) {
+        uint32_t gid = get_gid(font, letter);
+        if(gid == 0) continue;
+        TEST_ASSERT_GREATER_THAN_UINT32(gid_prev, gid);
+        TEST_ASSERT_EQUAL_UINT32(gid, get_gid(font, letter));
+        gid_prev = gid;
+    }
+}
+
+void test_font_fmt_txt_cache_kerning(void)
+{
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_UINT32(9, get_adv_w(&kern_font, 'A', 'V'));
+        TEST_ASSERT_EQUAL_UINT32(11, get_adv_w(&kern_font, 'V', 'A'));
+        TEST_ASSERT_EQUAL_UINT32(10, get_adv_w(&kern_font, 'A', 'A'));
+        TEST_ASSERT_EQUAL_UINT32(10, get_adv_w(&kern_font, 'V', 'V'));
+        TEST_ASSERT_EQUAL_UINT32(10, get_adv_w(&kern_font, 'V', 'B'));
+        TEST_ASSERT_EQUAL_UINT32(0, get_adv_w(&kern_font, 'B', 'A'));
+    }
+
+    lv_font_fmt_txt_drop_cache(&kern_font);
+    TEST_ASSERT_EQUAL_UINT32(9, get_adv_w(&kern_font, 'A', 'V'));
+    TEST_ASSERT_EQUAL_UINT32(9, get_adv_w(&kern_font, 'A', 'V'));
+}
+
+void test_font_fmt_txt_cache_multilang(void)
+{
+    /*Use fallback fonts like the multilang demo*/
+    lv_font_t font_cjk = lv_font_simsun_16_cjk;
+    lv_font_t font_rtl = lv_font_dejavu_16_persian_hebrew;
+    lv_font_t font = lv_font_montserrat_14;
+    font.fallback = &font_rtl;
+    font_rtl.fallback = &font_cjk;
+
+    uint32_t text_cnt = sizeof(texts) / sizeof(texts[0]);
+    lv_point_t sizes[sizeof(texts) / sizeof(texts[0])];
+    uint32_t i;
+    for(i = 0; i < text_cnt; i++) {
+        lv_text_get_size(&sizes[i], texts[i], &font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    }
+
+    /*Look up the glyphs of the CJK text directly*/
+    uint32_t letters[64 + 1] = {0};
+    uint32_t letter_cnt = 0;
+    uint32_t ofs = 0;
+    while(texts[0][ofs] && letter_cnt < 64) letters[letter_cnt++] = lv_text_encoded_next(texts[0], &ofs);
+
+    clock_t t = clock();
+    uint32_t round;
+    for(round = 0; round < 2000; round++) {
+        for(i = 0; i < letter_cnt; i++) {
+            lv_font_glyph_dsc_t g;
+            lv_font_get_glyph_dsc(&font_cjk, &g, letters[i], letters[i + 1]);
+        }
+    }
+    t = clock() - t;
+    printf("Getting the glyphs of the CJK text 2000 times: %ld clocks\n", (long)t);
+
+    t = clock();
+    for(round = 0; round < 200; round++) {
+        for(i = 0; i < text_cnt; i++) {
+            lv_point_t size;
+            lv_text_get_size(&size, texts[i], &font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+            TEST_ASSERT_EQUAL_INT32(sizes[i].x, size.x);
+        }
+    }
+    t = clock() - t;
+    printf("Measuring the multilang texts 200 times: %ld clocks\n", (long)t);
+
+    /*Render them too, the glyphs are looked up in the draw threads too*/
+    for(i = 0; i < text_cnt; i++) {
+        lv_obj_t * label = lv_label_create(lv_screen_active());
+        lv_obj_set_style_text_font(label, &font, 0);
+        lv_label_set_text_static(label, texts[i]);
+        lv_obj_set_pos(label, 0, i * 20);
+    }
+
+    t = clock();
+    for(round = 0; round < 20; round++) {
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(NULL);
+    }
+    t = clock() - t;
+    printf("Rendering the multilang texts 20 times: %ld clocks\n", (long)t);
+    lv_obj_clean(lv_screen_active());
+}
+
+#endif
@@ -64,6 +64,48 @@ void test_read(void)
     lv_fs_close(&fb);
 }
 
+void test_map(void)
+{
+    lv_fs_res_t res;
+    const void * buf;
+    uint32_t size;
+
+    /*'B' (POSIX) can map the file*/
+    lv_fs_file_t fb;
+    res = lv_fs_open(&fb, "B:src/test_files/readtest.txt", LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_map(&fb, &buf, &size);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(strlen(read_exp), size);
+    TEST_ASSERT_EQUAL_MEMORY(read_exp, buf, strlen(read_exp));
+    res = lv_fs_unmap(&fb, buf, size);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    lv_fs_close(&fb);
+
+    /*'A' (STDIO) can't*/
+    lv_fs_file_t fa;
+    res = lv_fs_open(&fa, "A:src/test_files/readtest.txt", LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_map(&fa, &buf, &size);
+    TEST_ASSERT_EQUAL(LV_FS_RES_NOT_IMP, res);
+    TEST_ASSERT_NULL(buf);
+    lv_fs_close(&fa);
+
+    /*'M' (MEMFS) returns the buffer itself*/
+    lv_fs_path_ex_t path;
+    lv_fs_make_path_from_buffer(&path, 'M', read_exp, strlen(read_exp));
+    lv_fs_file_t fm;
+    res = lv_fs_open(&fm, (const char *)&path, LV_FS_MODE_RD);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    res = lv_fs_map(&fm, &buf, &size);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    TEST_ASSERT_EQUAL_PTR(read_exp, buf);
+    TEST_ASSERT_EQUAL_UINT32(strlen(read_exp), size);
+    res = lv_fs_unmap(&fm, buf, size);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, res);
+    lv_fs_close(&fm);
+}
+
 void test_read_random(void)
 {
     read_random_drv('A', 8);
@@ -0,0 +1,139 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <unistd.h>
+
+#if LV_IMAGE_DECODER_ASYNC_THREAD_CNT
+
+#define IMG_FILE "A:src/test_assets/test_img_lvgl_logo.png"
+
+LV_IMAGE_DECLARE(test_img_lvgl_logo_png);
+
+static uint8_t * ref_buf;
+
+void setUp(void)
+{
+    lv_image_cache_drop(NULL);
+    lv_image_decoder_enable_async(true);
+}
+
+void tearDown(void)
+{
+    lv_image_decoder_enable_async(false);
+    lv_obj_clean(lv_screen_active());
+    lv_free(ref_buf);
+    ref_buf = NULL;
+}
+
+/*Wait until the image is decoded in the background*/
+static void wait_decoded(const void * src)
+{
+    lv_image_decoder_args_t args = {
+        .stride_align = LV_DRAW_BUF_STRIDE_ALIGN != 1,
+        .async = true,
+    };
+
+    uint32_t i;
+    for(i = 0; i < 5000; i++) {
+        lv_image_decoder_dsc_t dsc;
+        lv_result_t res = lv_image_decoder_open(&dsc, src, &args);
+        if(res == LV_RESULT_OK) {
+            lv_image_decoder_close(&dsc);
+            return;
+        }
+
+        TEST_ASSERT_TRUE(dsc.pending);
+        usleep(1000);
+    }
+
+    TEST_FAIL_MESSAGE("The image wasn't decoded in time");
+}
+
+/*Redraw everything synchronously and check if the result is the same as it was*/
+static void check_frame(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    ref_buf = lv_malloc(buf->data_size);
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+
+    lv_image_decoder_enable_async(false);
+    lv_image_cache_drop(NULL);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+}
+
+void test_image_decoder_async_draw_when_decoded(void)
+{
+    lv_obj_t * img_file = lv_image_create(lv_screen_active());
+    lv_image_set_src(img_file, IMG_FILE);
+    lv_obj_align(img_file, LV_ALIGN_CENTER, -100, 0);
+
+    lv_obj_t * img_var = lv_image_create(lv_screen_active());
+    lv_image_set_src(img_var, &test_img_lvgl_logo_png);
+    lv_obj_align(img_var, LV_ALIGN_CENTER, 100, 0);
+
+    /*The images are not drawn while they are decoded*/
+    lv_refr_now(NULL);
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    uint8_t * loading_buf = lv_malloc(buf->data_size);
+    lv_memcpy(loading_buf, buf->data, buf->data_size);
+
+    /*Only the areas of the images are redrawn when they are ready*/
+    wait_decoded(IMG_FILE);
+    wait_decoded(&test_img_lvgl_logo_png);
+
+    /*Pause the refresh to be sure it runs after the invalidation*/
+    lv_timer_pause(lv_display_get_refr_timer(NULL));
+    lv_tick_inc(LV_DEF_REFR_PERIOD);
+    lv_timer_handler();
+    lv_timer_resume(lv_display_get_refr_timer(NULL));
+
+    uint32_t img_px_cnt = lv_area_get_size(&img_file->coords) + lv_area_get_size(&img_var->coords);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, lv_display_get_refr_px_cnt(NULL));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(img_px_cnt, lv_display_get_refr_px_cnt(NULL));
+    TEST_ASSERT_NOT_EQUAL(0, lv_memcmp(loading_buf, buf->data, buf->data_size));
+    lv_free(loading_buf);
+
+    check_frame();
+}
+
+void test_image_decoder_async_prefetch(void)
+{
+    const void * srcs[] = {IMG_FILE, &test_img_lvgl_logo_png};
+    lv_image_decoder_prefetch(srcs, 2);
+    wait_decoded(IMG_FILE);
+    wait_decoded(&test_img_lvgl_logo_png);
+
+    /*Drawn right away*/
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, IMG_FILE);
+    lv_refr_now(NULL);
+
+    check_frame();
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_image_decoder_async_draw_when_decoded(void)
+{
+}
+
+void test_image_decoder_async_prefetch(void)
+{
+}
+
+#endif /*LV_IMAGE_DECODER_ASYNC_THREAD_CNT*/
+
+#endif
@@ -0,0 +1,104 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_IMAGE_DECODER_TILE_SIZE && LV_USE_TJPGD
+
+/*105x33 JPG image decoded by TJPGD in blocks via `get_area_cb`*/
+#define IMG_SRC "A:src/test_assets/test_img_lvgl_logo.jpg"
+
+void setUp(void)
+{
+    /*Decode the JPG images with TJPGD*/
+    lv_libjpeg_turbo_deinit();
+    lv_image_cache_drop(NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_libjpeg_turbo_init();
+}
+
+static bool tile_is_cached(uint32_t tile_id)
+{
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, IMG_SRC, NULL));
+
+    lv_cache_entry_t * entry = _lv_image_decoder_acquire_tile(&dsc, tile_id);
+    if(entry) lv_cache_release(dsc.cache, entry, NULL);
+    lv_image_decoder_close(&dsc);
+
+    return entry != NULL;
+}
+
+/*Redraw everything line by line with disabled image cache and compare*/
+static void check_frame(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    uint8_t * ref_buf = lv_malloc(buf->data_size);
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+
+    lv_image_cache_resize(0, true);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    lv_image_cache_resize(LV_CACHE_DEF_SIZE, true);
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_buf, buf->data, buf->data_size);
+    lv_free(ref_buf);
+}
+
+void test_image_tile_cache_decode_only_visible_tiles(void)
+{
+    /*Show only the left part of the image*/
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, LV_IMAGE_DECODER_TILE_SIZE / 2, 100);
+
+    lv_obj_t * img = lv_image_create(cont);
+    lv_image_set_src(img, IMG_SRC);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_TRUE(tile_is_cached(1));
+    TEST_ASSERT_FALSE(tile_is_cached(2));
+
+    /*Show the whole image*/
+    lv_obj_set_width(cont, 200);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_TRUE(tile_is_cached(1));
+    TEST_ASSERT_TRUE(tile_is_cached(2));
+    check_frame();
+
+    /*Dropping the image drops its tiles*/
+    lv_image_cache_drop(IMG_SRC);
+    TEST_ASSERT_FALSE(tile_is_cached(1));
+    TEST_ASSERT_FALSE(tile_is_cached(2));
+
+    /*Decode the tiles again and draw them from the cache in the next refresh*/
+    lv_obj_invalidate(img);
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(tile_is_cached(1));
+    lv_obj_invalidate(img);
+    lv_refr_now(NULL);
+    check_frame();
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_image_tile_cache_decode_only_visible_tiles(void)
+{
+}
+
+#endif
+
+#endif
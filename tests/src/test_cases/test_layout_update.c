@@ -0,0 +1,88 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define ROW_CNT     20
+#define ITEM_CNT    50
+
+static lv_obj_t * rows[ROW_CNT];
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+static void create_rows(void)
+{
+    uint32_t i;
+    for(i = 0; i < ROW_CNT; i++) {
+        rows[i] = lv_obj_create(lv_screen_active());
+        lv_obj_set_size(rows[i], LV_PCT(100), LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(rows[i], LV_FLEX_FLOW_ROW_WRAP);
+        lv_obj_set_y(rows[i], i * 50);
+
+        uint32_t j;
+        for(j = 0; j < ITEM_CNT; j++) {
+            lv_obj_t * item = lv_obj_create(rows[i]);
+            lv_obj_set_size(item, 20, 20);
+        }
+    }
+
+    lv_refr_now(NULL);
+}
+
+void test_layout_update_only_dirty_branches(void)
+{
+    create_rows();
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(ROW_CNT * ITEM_CNT, lv_display_get_layout_cnt(NULL));
+
+    /*Nothing changed, nothing to update*/
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_display_get_layout_cnt(NULL));
+
+    /*Resize a leaf: only the leaf, its parent and the parent's children need to be updated*/
+    lv_obj_t * item = lv_obj_get_child(rows[10], 0);
+    lv_obj_t * item_next = lv_obj_get_child(rows[10], 1);
+    int32_t x_next = lv_obj_get_x(item_next);
+    lv_obj_set_width(item, 40);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_INT32(40, lv_obj_get_width(item));
+    TEST_ASSERT_EQUAL_INT32(x_next + 20, lv_obj_get_x(item_next));
+    TEST_ASSERT_LESS_THAN_UINT32(3 * ITEM_CNT, lv_display_get_layout_cnt(NULL));
+
+    /*A deep change which changes the size of the parent too*/
+    lv_obj_t * item_last = lv_obj_get_child(rows[ROW_CNT - 1], -1);
+    int32_t row_h = lv_obj_get_height(rows[ROW_CNT - 1]);
+    lv_obj_set_height(item_last, 200);
+    lv_obj_update_layout(item_last);
+    TEST_ASSERT_GREATER_THAN_INT32(row_h, lv_obj_get_height(rows[ROW_CNT - 1]));
+}
+
+void test_layout_update_many_objects(void)
+{
+    create_rows();
+
+    lv_obj_t * item = lv_obj_get_child(rows[ROW_CNT - 1], ITEM_CNT - 1);
+    clock_t t = clock();
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_set_width(item, 20 + (i & 1));
+        lv_obj_update_layout(item);
+    }
+    t = clock() - t;
+
+    printf("Updating the layout of a leaf among %d objects 20 times: %ld clocks\n", ROW_CNT * ITEM_CNT, (long)t);
+    TEST_ASSERT_EQUAL_INT32(21, lv_obj_get_width(item));
+}
+
+#endif
@@ -0,0 +1,188 @@
+#define _GNU_SOURCE     /*For memfd_create*/
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_LINUX_FBDEV && LV_LINUX_FBDEV_PAGE_FLIP && !LV_LINUX_FBDEV_BSD
+
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <linux/fb.h>
+
+#define FB_W        160
+#define FB_H        120
+#define FB_STRIDE   (FB_W * 4)
+#define FB_SIZE     (FB_STRIDE * FB_H * 2)
+
+/*A memfd stands in for /dev/fb0 and the framebuffer ioctls are emulated below*/
+static int fb_fd = -1;
+static uint8_t * fb_mem;
+static struct fb_var_screeninfo fake_vinfo;
+static bool pan_supported;
+static uint32_t pan_cnt;
+
+int ioctl(int fd, unsigned long request, ...)
+{
+    va_list args;
+    va_start(args, request);
+    void * arg = va_arg(args, void *);
+    va_end(args);
+
+    switch(request) {
+        case FBIOGET_FSCREENINFO: {
+                struct fb_fix_screeninfo * finfo = arg;
+                lv_memzero(finfo, sizeof(*finfo));
+                finfo->line_length = FB_STRIDE;
+                finfo->smem_len = FB_SIZE;
+                return 0;
+            }
+        case FBIOGET_VSCREENINFO:
+            *(struct fb_var_screeninfo *)arg = fake_vinfo;
+            return 0;
+        case FBIOPUT_VSCREENINFO: {
+                struct fb_var_screeninfo * vinfo = arg;
+                fake_vinfo.yres_virtual = LV_MIN(vinfo->yres_virtual, FB_SIZE / FB_STRIDE);
+                return 0;
+            }
+        case FBIOPAN_DISPLAY:
+            if(!pan_supported) {
+                errno = EINVAL;
+                return -1;
+            }
+            fake_vinfo.yoffset = ((struct fb_var_screeninfo *)arg)->yoffset;
+            pan_cnt++;
+            return 0;
+        case FBIOBLANK:
+        case FBIO_WAITFORVSYNC:
+            return 0;
+        default:
+            return syscall(SYS_ioctl, fd, request, arg);
+    }
+}
+
+static lv_display_t * fb_disp;
+static lv_obj_t * rect;
+
+void setUp(void)
+{
+    fb_fd = memfd_create("fb", 0);
+    TEST_ASSERT_NOT_EQUAL(-1, fb_fd);
+    TEST_ASSERT_EQUAL(0, ftruncate(fb_fd, FB_SIZE));
+    fb_mem = mmap(NULL, FB_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fb_fd, 0);
+
+    lv_memzero(&fake_vinfo, sizeof(fake_vinfo));
+    fake_vinfo.xres = FB_W;
+    fake_vinfo.yres = FB_H;
+    fake_vinfo.xres_virtual = FB_W;
+    fake_vinfo.yres_virtual = FB_H;
+    fake_vinfo.bits_per_pixel = 32;
+    pan_supported = true;
+    pan_cnt = 0;
+}
+
+void tearDown(void)
+{
+    if(fb_disp) lv_display_delete(fb_disp);
+    fb_disp = NULL;
+
+    munmap(fb_mem, FB_SIZE);
+    close(fb_fd);
+}
+
+static void create_display(void)
+{
+    char path[64];
+    lv_snprintf(path, sizeof(path), "/proc/self/fd/%d", fb_fd);
+
+    fb_disp = lv_linux_fbdev_create();
+    lv_linux_fbdev_set_file(fb_disp, path);
+    lv_tick_set_cb(NULL);   /*Keep using the tick of the tests*/
+
+    lv_obj_t * scr = lv_display_get_screen_active(fb_disp);
+    lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+    rect = lv_obj_create(scr);
+    lv_obj_remove_style_all(rect);
+    lv_obj_set_style_bg_opa(rect, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(rect, lv_color_hex(0xff0000), 0);
+    lv_obj_set_size(rect, 10, 10);
+}
+
+/*Get a pixel of the currently shown page as 0xRRGGBB*/
+static uint32_t shown_px(int32_t x, int32_t y)
+{
+    const uint8_t * px = fb_mem + (fake_vinfo.yoffset + y) * FB_STRIDE + x * 4;
+    return (px[2] << 16) + (px[1] << 8) + px[0];
+}
+
+void test_linux_fbdev_page_flip(void)
+{
+    create_display();
+    TEST_ASSERT_EQUAL(FB_H * 2, fake_vinfo.yres_virtual);
+
+    lv_refr_now(fb_disp);
+    uint32_t first_yoffset = fake_vinfo.yoffset;
+    TEST_ASSERT_EQUAL_HEX32(0xff0000, shown_px(5, 5));
+    TEST_ASSERT_EQUAL_HEX32(0xffffff, shown_px(30, 30));
+
+    /*Only the old and new places of the rectangle are rendered, the rest is synced from the other page*/
+    lv_obj_set_pos(rect, 20, 20);
+    lv_refr_now(fb_disp);
+    TEST_ASSERT_NOT_EQUAL(first_yoffset, fake_vinfo.yoffset);
+    TEST_ASSERT_EQUAL_HEX32(0xffffff, shown_px(5, 5));
+    TEST_ASSERT_EQUAL_HEX32(0xff0000, shown_px(25, 25));
+    TEST_ASSERT_EQUAL_HEX32(0xffffff, shown_px(40, 40));
+
+    lv_obj_set_pos(rect, 40, 30);
+    lv_refr_now(fb_disp);
+    TEST_ASSERT_EQUAL(first_yoffset, fake_vinfo.yoffset);
+    TEST_ASSERT_EQUAL_HEX32(0xffffff, shown_px(5, 5));
+    TEST_ASSERT_EQUAL_HEX32(0xffffff, shown_px(25, 25));
+    TEST_ASSERT_EQUAL_HEX32(0xff0000, shown_px(45, 35));
+
+    /*Initial pan + one per frame*/
+    TEST_ASSERT_EQUAL_UINT32(4, pan_cnt);
+}
+
+void test_linux_fbdev_no_pan(void)
+{
+    pan_supported = false;
+    create_display();
+
+    /*Copied to the first page*/
+    lv_refr_now(fb_disp);
+    lv_obj_set_pos(rect, 20, 20);
+    lv_refr_now(fb_disp);
+    TEST_ASSERT_EQUAL(0, fake_vinfo.yoffset);
+    TEST_ASSERT_EQUAL_HEX32(0xffffff, shown_px(5, 5));
+    TEST_ASSERT_EQUAL_HEX32(0xff0000, shown_px(25, 25));
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_linux_fbdev_page_flip(void)
+{
+    TEST_PASS();
+}
+
+void test_linux_fbdev_no_pan(void)
+{
+    TEST_PASS();
+}
+
+#endif
+
+#endif
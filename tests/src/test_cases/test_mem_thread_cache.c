@@ -0,0 +1,134 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <stdio.h>
+#include <time.h>
+
+/*The contention of the heap is measured with and without the cache too*/
+#define CONTENTION_TEST (LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_USE_OS == LV_OS_PTHREAD)
+#define THREAD_CACHE_TEST (CONTENTION_TEST && LV_MEM_THREAD_CACHE_SIZE)
+
+#define MAX_THREAD_CNT  8
+#define LIVE_BLOCK_CNT  32
+#define OPS_PER_THREAD  200000
+
+#if CONTENTION_TEST
+
+typedef struct {
+    lv_thread_t thread;
+    uint32_t seed;
+    bool error;
+} worker_t;
+
+static uint32_t rand_next(uint32_t * seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static void worker_cb(void * user_data)
+{
+    /*Replace random small blocks like the draw tasks and the caches of the renderers do*/
+    worker_t * worker = user_data;
+    uint8_t * blocks[LIVE_BLOCK_CNT] = {NULL};
+    uint32_t i;
+    for(i = 0; i < OPS_PER_THREAD; i++) {
+        uint32_t id = rand_next(&worker->seed) % LIVE_BLOCK_CNT;
+        if(blocks[id]) {
+            if(blocks[id][0] != (uint8_t)id) worker->error = true;
+            lv_free(blocks[id]);
+        }
+        blocks[id] = lv_malloc(8 + rand_next(&worker->seed) % 250);
+        if(blocks[id] == NULL) worker->error = true;
+        else blocks[id][0] = (uint8_t)id;
+    }
+
+    for(i = 0; i < LIVE_BLOCK_CNT; i++) lv_free(blocks[i]);
+}
+
+static double get_time_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_mem_thread_cache_reuse(void)
+{
+#if THREAD_CACHE_TEST
+    lv_mem_thread_cache_flush();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    /*The last freed block of a size class should be returned first*/
+    void * p1 = lv_malloc(40);
+    void * p2 = lv_malloc(33);
+    lv_free(p1);
+    TEST_ASSERT_EQUAL_PTR(p1, lv_malloc(48));
+    lv_free(p2);
+    lv_free(p1);
+
+    /*The monitor gives back the cached blocks of its thread*/
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.used_cnt + 1, mon.used_cnt); /*The cache itself*/
+
+    lv_mem_thread_cache_flush();
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.used_cnt, mon.used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.free_size, mon.free_size);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_mem_test());
+#endif
+}
+
+void test_mem_thread_cache_contention(void)
+{
+#if CONTENTION_TEST
+    lv_mem_thread_cache_flush();
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    static worker_t workers[MAX_THREAD_CNT];
+    uint32_t thread_cnt;
+    for(thread_cnt = 1; thread_cnt <= MAX_THREAD_CNT; thread_cnt *= 2) {
+        double t = get_time_ms();
+        uint32_t i;
+        for(i = 0; i < thread_cnt; i++) {
+            workers[i].seed = i + 1;
+            workers[i].error = false;
+            lv_thread_init(&workers[i].thread, LV_THREAD_PRIO_MID, worker_cb, 0, &workers[i]);
+        }
+
+        for(i = 0; i < thread_cnt; i++) {
+            lv_thread_delete(&workers[i].thread);
+            TEST_ASSERT_FALSE(workers[i].error);
+        }
+        t = get_time_ms() - t;
+
+        printf("%u thread(s): %.0f malloc/free per ms\n", (unsigned)thread_cnt, thread_cnt * OPS_PER_THREAD / t);
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_mem_test());
+    }
+
+    /*The exited threads should give back all their blocks*/
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.used_cnt, mon.used_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.free_size, mon.free_size);
+#endif
+}
+
+#endif
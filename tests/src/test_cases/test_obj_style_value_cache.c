@@ -0,0 +1,135 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../demos/lv_demos.h"
+
+#include "unity/unity.h"
+
+#include <stdio.h>
+#include <time.h>
+
+static lv_style_t style_parent;
+static lv_style_t style_pressed;
+
+void setUp(void)
+{
+    lv_style_init(&style_parent);
+    lv_style_init(&style_pressed);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_style_reset(&style_parent);
+    lv_style_reset(&style_pressed);
+}
+
+void test_obj_style_value_cache_style_change(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_t * child = lv_obj_create(parent);
+    lv_obj_remove_style_all(child);
+    lv_obj_add_style(parent, &style_parent, 0);
+
+    lv_style_set_text_color(&style_parent, lv_color_hex(0xff0000));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_text_color(child, 0));
+
+    /*Modifying the style without reporting the change should be also visible*/
+    lv_style_set_text_color(&style_parent, lv_color_hex(0x00ff00));
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(child, 0));
+
+    lv_obj_set_style_text_color(child, lv_color_hex(0x0000ff), 0);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_text_color(child, 0));
+
+    lv_obj_remove_local_style_prop(child, LV_STYLE_TEXT_COLOR, 0);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(child, 0));
+
+    lv_obj_remove_style(parent, &style_parent, 0);
+    TEST_ASSERT_EQUAL_COLOR(lv_obj_get_style_text_color(lv_screen_active(), 0), lv_obj_get_style_text_color(child, 0));
+}
+
+void test_obj_style_value_cache_state_change(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_t * child = lv_obj_create(parent);
+    lv_style_set_text_opa(&style_pressed, LV_OPA_50);
+    lv_style_set_bg_opa(&style_pressed, LV_OPA_20);
+    lv_obj_add_style(parent, &style_pressed, LV_STATE_PRESSED);
+
+    TEST_ASSERT_EQUAL(LV_OPA_COVER, lv_obj_get_style_text_opa(child, 0));
+
+    /*The own and the inherited values should be updated too*/
+    lv_obj_add_state(parent, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(LV_OPA_20, lv_obj_get_style_bg_opa(parent, 0));
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_text_opa(child, 0));
+
+    lv_obj_remove_state(parent, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(LV_OPA_COVER, lv_obj_get_style_bg_opa(parent, 0));
+    TEST_ASSERT_EQUAL(LV_OPA_COVER, lv_obj_get_style_text_opa(child, 0));
+}
+
+void test_obj_style_value_cache_parent_change(void)
+{
+    lv_obj_t * parent1 = lv_obj_create(lv_screen_active());
+    lv_obj_t * parent2 = lv_obj_create(lv_screen_active());
+    lv_obj_t * child = lv_obj_create(parent1);
+    lv_obj_set_style_text_letter_space(parent1, 3, 0);
+    lv_obj_set_style_text_letter_space(parent2, 5, 0);
+
+    TEST_ASSERT_EQUAL_INT32(3, lv_obj_get_style_text_letter_space(child, 0));
+    lv_obj_set_parent(child, parent2);
+    TEST_ASSERT_EQUAL_INT32(5, lv_obj_get_style_text_letter_space(child, 0));
+}
+
+#if LV_OBJ_STYLE_VALUE_CACHE && LV_USE_DEMO_WIDGETS
+
+static uint32_t get_draw_props(lv_obj_t * obj)
+{
+    /*Get the same properties as the drawing of the object would do*/
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    lv_obj_init_draw_rect_dsc(obj, LV_PART_MAIN, &rect_dsc);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_dsc);
+
+    uint32_t sum = rect_dsc.radius + rect_dsc.bg_opa + rect_dsc.border_width + label_dsc.letter_space;
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_count(obj); i++) {
+        sum += get_draw_props(lv_obj_get_child(obj, i));
+    }
+    return sum;
+}
+
+#endif
+
+void test_obj_style_value_cache_benchmark(void)
+{
+#if LV_OBJ_STYLE_VALUE_CACHE && LV_USE_DEMO_WIDGETS
+    lv_demo_widgets();
+    lv_refr_now(NULL);
+
+    clock_t cold = 0;
+    clock_t warm = 0;
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        /*Drop the cached values to measure the full lookup*/
+        _lv_obj_style_value_cache_invalidate();
+        clock_t t = clock();
+        uint32_t sum_cold = get_draw_props(lv_screen_active());
+        cold += clock() - t;
+
+        t = clock();
+        uint32_t sum_warm = get_draw_props(lv_screen_active());
+        warm += clock() - t;
+
+        TEST_ASSERT_EQUAL_UINT32(sum_cold, sum_warm);
+    }
+
+    printf("Style lookups of drawing the widgets demo: %ld clocks without, %ld clocks with value cache\n",
+           (long)cold, (long)warm);
+    TEST_ASSERT_LESS_THAN(cold, warm);
+#endif
+}
+
+#endif
@@ -6,14 +6,16 @@
 
 #define OUTPUT_LINE_MAX 8
 #define OUTPUT_BUF_MAX 128
+#define THREAD_NUM 3
+#define THREAD_ITEM_NUM 200
 
 static uint32_t profiler_tick = 0;
 static int output_line = 0;
 static char output_buf[OUTPUT_LINE_MAX][OUTPUT_BUF_MAX];
 
-static uint32_t get_tick_cb(void)
+static uint64_t get_tick_cb(void)
 {
-    return profiler_tick++;
+    return __atomic_fetch_add(&profiler_tick, 1, __ATOMIC_RELAXED);
 }
 
 static void flush_cb(const char * buf)
@@ -97,4 +99,145 @@ void test_profiler_disable(void)
     TEST_ASSERT_EQUAL_CHAR(output_buf[4][0], '\0');
 }
 
+void test_profiler_chrome_trace(void)
+{
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.buf_size = 1024;
+    config.tick_per_sec = 1000000000; /* Nanoseconds */
+    config.tick_get_cb = get_tick_cb;
+    config.flush_cb = flush_cb;
+    config.format = LV_PROFILER_BUILTIN_FORMAT_CHROME_TRACE;
+
+    output_line = 0;
+    lv_memzero(output_buf, sizeof(output_buf));
+    lv_profiler_builtin_init(&config);
+    TEST_ASSERT_EQUAL_STRING("[\n", output_buf[0]);
+
+    output_line = 0;
+    profiler_tick = 1234;
+    LV_PROFILER_BEGIN;
+    profiler_tick = 1000001234;
+    LV_PROFILER_END;
+    lv_profiler_builtin_flush();
+
+    TEST_ASSERT_EQUAL_INT(3, output_line);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"LVGL-1\"}},\n",
+        output_buf[0]);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"name\":\"test_profiler_chrome_trace\",\"ph\":\"B\",\"ts\":1.234,\"pid\":1,\"tid\":1,\"args\":{\"cpu\":0}},\n",
+        output_buf[1]);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"name\":\"test_profiler_chrome_trace\",\"ph\":\"E\",\"ts\":1000001.234,\"pid\":1,\"tid\":1,\"args\":{\"cpu\":0}},\n",
+        output_buf[2]);
+}
+
+#if LV_USE_OS
+
+static __thread int thread_id = 1;
+static uint32_t thread_item_cnt[THREAD_NUM + 2];
+static uint32_t thread_last_tick[THREAD_NUM + 2];
+static bool thread_check_order;
+
+static int get_tid_cb(void)
+{
+    return thread_id;
+}
+
+/* Only the drain calls it and the drains are serialized */
+static void count_flush_cb(const char * buf)
+{
+    int tid;
+    uint32_t sec;
+    uint32_t usec;
+    if(sscanf(buf, "   LVGL-%d [0] %" LV_PRIu32 ".%" LV_PRIu32, &tid, &sec, &usec) != 3) return;
+
+    TEST_ASSERT_LESS_THAN(THREAD_NUM + 2, tid);
+
+    /* The items of a thread are flushed in order */
+    uint32_t tick = sec * 1000000 + usec;
+    if(thread_check_order && thread_item_cnt[tid]) TEST_ASSERT_GREATER_THAN(thread_last_tick[tid], tick);
+    thread_last_tick[tid] = tick;
+    thread_item_cnt[tid]++;
+}
+
+static void profiled_thread_cb(void * user_data)
+{
+    thread_id = (int)(lv_uintptr_t)user_data;
+
+    uint32_t i;
+    for(i = 0; i < THREAD_ITEM_NUM / 2; i++) {
+        LV_PROFILER_BEGIN;
+        LV_PROFILER_END;
+    }
+}
+
+static void run_profiled_threads(void)
+{
+    lv_memzero(thread_item_cnt, sizeof(thread_item_cnt));
+    profiler_tick = 0;
+
+    lv_thread_t threads[THREAD_NUM];
+    uint32_t i;
+    for(i = 0; i < THREAD_NUM; i++) {
+        lv_thread_init(&threads[i], LV_THREAD_PRIO_MID, profiled_thread_cb, 8 * 1024, (void *)(lv_uintptr_t)(i + 2));
+    }
+
+    profiled_thread_cb((void *)1);
+
+    for(i = 0; i < THREAD_NUM; i++) {
+        lv_thread_delete(&threads[i]);
+    }
+
+    lv_profiler_builtin_flush();
+}
+
+#endif /*LV_USE_OS*/
+
+void test_profiler_threads(void)
+{
+#if LV_USE_OS
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.buf_size = THREAD_ITEM_NUM * 32;   /* The rings are never full */
+    config.tick_per_sec = 1000000;
+    config.tick_get_cb = get_tick_cb;
+    config.tid_get_cb = get_tid_cb;
+    config.flush_cb = count_flush_cb;
+    lv_profiler_builtin_init(&config);
+
+    thread_check_order = true;
+    run_profiled_threads();
+
+    uint32_t i;
+    for(i = 1; i < THREAD_NUM + 2; i++) {
+        TEST_ASSERT_EQUAL_UINT32(THREAD_ITEM_NUM, thread_item_cnt[i]);
+    }
+#else
+    TEST_PASS();
+#endif
+}
+
+void test_profiler_threads_same_tid(void)
+{
+#if LV_USE_OS
+    /* All threads write the same buffer with the default `tid_get_cb` */
+    lv_profiler_builtin_config_t config;
+    lv_profiler_builtin_config_init(&config);
+    config.buf_size = THREAD_ITEM_NUM * (THREAD_NUM + 1) * 32;   /* The ring is never full */
+    config.tick_per_sec = 1000000;
+    config.tick_get_cb = get_tick_cb;
+    config.flush_cb = count_flush_cb;
+    lv_profiler_builtin_init(&config);
+
+    thread_check_order = false;
+    run_profiled_threads();
+
+    TEST_ASSERT_EQUAL_UINT32(THREAD_ITEM_NUM * (THREAD_NUM + 1), thread_item_cnt[1]);
+#else
+    TEST_PASS();
+#endif
+}
+
 #endif
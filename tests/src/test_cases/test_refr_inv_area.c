@@ -0,0 +1,78 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static void invalidate(int32_t x1, int32_t y1, int32_t x2, int32_t y2)
+{
+    lv_area_t a;
+    lv_area_set(&a, x1, y1, x2, y2);
+    _lv_inv_area(NULL, &a);
+}
+
+void setUp(void)
+{
+#if LV_USE_SYSMON
+#if LV_USE_MEM_MONITOR
+    lv_sysmon_hide_memory(NULL);
+#endif
+#if LV_USE_PERF_MONITOR
+    lv_sysmon_hide_performance(NULL);
+#endif
+#endif
+    lv_refr_now(NULL);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_refr_inv_area_overlapping(void)
+{
+    /*Joining them would redraw more pixels so only the overlapping part is removed*/
+    invalidate(0, 0, 99, 99);
+    invalidate(50, 50, 149, 149);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(100 * 100 * 2 - 50 * 50, lv_display_get_refr_px_cnt(NULL));
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(1, lv_display_get_flush_cnt(NULL));
+}
+
+void test_refr_inv_area_join_close(void)
+{
+    /*The gap is smaller than the overhead of refreshing one more area*/
+    invalidate(0, 0, 99, 99);
+    invalidate(0, 101, 99, 199);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(100 * 200, lv_display_get_refr_px_cnt(NULL));
+}
+
+void test_refr_inv_area_keep_far(void)
+{
+    invalidate(0, 0, 9, 9);
+    invalidate(700, 400, 709, 409);
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(10 * 10 * 2, lv_display_get_refr_px_cnt(NULL));
+}
+
+void test_refr_inv_area_many(void)
+{
+    /*More areas than LV_INV_BUF_SIZE shouldn't result in redrawing the whole screen*/
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < 8; y++) {
+        for(x = 0; x < 16; x++) {
+            invalidate(x * 50, y * 60, x * 50 + 4, y * 60 + 4);
+        }
+    }
+    lv_refr_now(NULL);
+
+    uint32_t px_cnt = lv_display_get_refr_px_cnt(NULL);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(8 * 16 * 5 * 5, px_cnt);
+    TEST_ASSERT_LESS_THAN_UINT32(800 * 480 / 2, px_cnt);
+}
+
+#endif
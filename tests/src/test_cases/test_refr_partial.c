@@ -0,0 +1,131 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "../../../src/display/lv_display_private.h"
+
+#define HOR_RES 800
+#define VER_RES 480
+#define BUF_ROWS 48
+
+LV_IMAGE_DECLARE(test_img_lvgl_logo_png);
+
+static lv_display_t * disp_ori;
+static lv_display_t * disp;
+static uint8_t buf_1[HOR_RES * BUF_ROWS * 4 + LV_DRAW_BUF_ALIGN];
+static uint8_t buf_2[HOR_RES * BUF_ROWS * 4 + LV_DRAW_BUF_ALIGN];
+static uint8_t frame_buf[HOR_RES * VER_RES * 4 + LV_DRAW_BUF_ALIGN];
+
+static uint32_t flush_cnt;
+static int32_t flush_last_y;
+static uint8_t * flush_last_px_map;
+static bool flush_is_last;
+static bool flush_order_error;
+
+static void flush_cb(lv_display_t * d, const lv_area_t * area, uint8_t * px_map)
+{
+    /*The parts should come from top to bottom from the buffers alternately*/
+    if(area->y1 <= flush_last_y || px_map == flush_last_px_map) flush_order_error = true;
+    flush_last_y = area->y2;
+    flush_last_px_map = px_map;
+    flush_cnt++;
+    flush_is_last = lv_display_flush_is_last(d);
+
+    /*Assemble the frame to compare it with a reference image*/
+    int32_t w = lv_area_get_width(area);
+    uint32_t stride = lv_draw_buf_width_to_stride(w, lv_display_get_color_format(d));
+    uint32_t frame_stride = HOR_RES * 4;
+    uint8_t * frame = lv_draw_buf_align(frame_buf, lv_display_get_color_format(d));
+    int32_t y;
+    for(y = area->y1; y <= area->y2 && y < VER_RES; y++) {
+        lv_memcpy(frame + y * frame_stride + area->x1 * 4, px_map + (y - area->y1) * stride, w * 4);
+    }
+
+    extern uint8_t * last_flushed_buf;
+    last_flushed_buf = frame;
+
+    lv_display_flush_ready(d);
+}
+
+void setUp(void)
+{
+    disp_ori = lv_display_get_default();
+    /*Refresh it now to not overwrite the flushed frame when taking the screenshot*/
+    lv_refr_now(disp_ori);
+
+    disp = lv_display_create(HOR_RES, VER_RES);
+    lv_display_set_buffers(disp, lv_draw_buf_align(buf_1, LV_COLOR_FORMAT_XRGB8888),
+                           lv_draw_buf_align(buf_2, LV_COLOR_FORMAT_XRGB8888),
+                           HOR_RES * BUF_ROWS * 4, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush_cb);
+    lv_display_set_default(disp);
+#if LV_USE_SYSMON
+#if LV_USE_MEM_MONITOR
+    lv_sysmon_hide_memory(disp);
+#endif
+#if LV_USE_PERF_MONITOR
+    lv_sysmon_hide_performance(disp);
+#endif
+#endif
+
+    flush_cnt = 0;
+    flush_last_y = -1;
+    flush_last_px_map = NULL;
+    flush_is_last = false;
+    flush_order_error = false;
+}
+
+void tearDown(void)
+{
+    lv_display_set_default(disp_ori);
+    lv_display_delete(disp);
+}
+
+void test_refr_partial_double_buffered(void)
+{
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * img = lv_image_create(lv_screen_active());
+        lv_image_set_src(img, &test_img_lvgl_logo_png);
+        lv_obj_set_style_bg_opa(img, LV_OPA_20, 0);
+        lv_obj_set_style_bg_color(img, lv_color_hex(0x000000), 0);
+        lv_obj_set_style_shadow_width(img, 10, 0);
+        lv_obj_set_style_shadow_color(img, lv_color_hex(0xff0000), 0);
+        lv_obj_set_pos(img, 100 + (i % 4) * 160, 150 + (i / 4) * 150);
+        lv_image_set_rotation(img, i * 450);
+    }
+
+    lv_refr_now(disp);
+
+    /*All parts of the screen should be flushed*/
+    TEST_ASSERT_EQUAL_UINT32(VER_RES / BUF_ROWS, flush_cnt);
+    TEST_ASSERT_EQUAL_INT32(VER_RES - 1, flush_last_y);
+    TEST_ASSERT_TRUE(flush_is_last);
+    TEST_ASSERT_FALSE(flush_order_error);
+    TEST_ASSERT_NULL(disp->layer_pending);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("widgets/image_rotate_pivot_center.png");
+}
+
+void test_refr_partial_double_buffered_small_areas(void)
+{
+    lv_refr_now(disp);
+
+    lv_obj_t * obj1 = lv_obj_create(lv_screen_active());
+    lv_obj_set_pos(obj1, 10, 10);
+    lv_obj_t * obj2 = lv_obj_create(lv_screen_active());
+    lv_obj_set_pos(obj2, 10, 300);
+
+    flush_cnt = 0;
+    flush_last_y = -1;
+    flush_last_px_map = NULL;
+    lv_refr_now(disp);
+
+    /*Both areas are flushed and only the very last part is the last*/
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(2, flush_cnt);
+    TEST_ASSERT_TRUE(flush_is_last);
+    TEST_ASSERT_FALSE(flush_order_error);
+    TEST_ASSERT_NULL(disp->layer_pending);
+}
+
+#endif
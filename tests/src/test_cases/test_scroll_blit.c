@@ -0,0 +1,206 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_obj_t * list;
+static uint8_t * ref_buf;
+static lv_draw_buf_t * draw_bufs[2];
+
+void setUp(void)
+{
+    lv_display_set_scroll_blit(NULL, true);
+}
+
+void tearDown(void)
+{
+    lv_display_set_scroll_blit(NULL, false);
+    lv_obj_clean(lv_screen_active());
+    lv_obj_clean(lv_layer_top());
+    lv_free(ref_buf);
+    ref_buf = NULL;
+}
+
+static void create_list(void)
+{
+    list = lv_list_create(lv_screen_active());
+    lv_obj_set_size(list, 300, 300);
+    lv_obj_set_pos(list, 20, 20);
+    lv_obj_set_scrollbar_mode(list, LV_SCROLLBAR_MODE_ON);
+
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        char buf[32];
+        lv_snprintf(buf, sizeof(buf), "Item %d", (int)i);
+        lv_list_add_button(list, LV_SYMBOL_FILE, buf);
+    }
+
+    lv_refr_now(NULL);
+}
+
+/*Scroll like an input device does while dragging*/
+static void scroll(int32_t dy)
+{
+    _lv_obj_scroll_by_raw(list, 0, dy);
+}
+
+/*Get the buffer which was sent to the display last time*/
+static lv_draw_buf_t * get_flushed_buf(void)
+{
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    if(draw_bufs[0] == NULL) return buf;
+    return buf == draw_bufs[0] ? draw_bufs[1] : draw_bufs[0];
+}
+
+static void dummy_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    LV_UNUSED(area);
+    LV_UNUSED(px_map);
+    lv_display_flush_ready(disp);
+}
+
+/*Redraw everything and check if the result is the same as it was*/
+static void check_frame(void)
+{
+    lv_draw_buf_t * buf = get_flushed_buf();
+    if(ref_buf == NULL) ref_buf = lv_malloc(buf->data_size);
+    lv_memcpy(ref_buf, buf->data, buf->data_size);
+
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    buf = get_flushed_buf();
+    TEST_ASSERT_EQUAL_MEMORY(buf->data, ref_buf, buf->data_size);
+}
+
+void test_scroll_blit_redraw_only_exposed_parts(void)
+{
+    create_list();
+    uint32_t list_px_cnt = lv_area_get_size(&list->coords);
+
+    int32_t i;
+    for(i = 0; i < 5; i++) {
+        scroll(-17);
+        lv_refr_now(NULL);
+        TEST_ASSERT_LESS_THAN_UINT32(list_px_cnt / 2, lv_display_get_refr_px_cnt(NULL));
+        check_frame();
+    }
+
+    /*Scroll back and forth and change an item in the same refresh*/
+    scroll(30);
+    lv_obj_set_style_bg_color(lv_obj_get_child(list, 3), lv_palette_main(LV_PALETTE_RED), 0);
+    scroll(-12);
+    scroll(-40);
+    lv_refr_now(NULL);
+    check_frame();
+
+    /*Scroll more than the visible area*/
+    scroll(-500);
+    lv_refr_now(NULL);
+    check_frame();
+}
+
+void test_scroll_blit_overlays(void)
+{
+    create_list();
+
+    /*A sibling, a floating child and an object on the top layer drawn on the list*/
+    lv_obj_t * sibling = lv_obj_create(lv_screen_active());
+    lv_obj_set_pos(sibling, 200, 100);
+    lv_obj_set_size(sibling, 150, 50);
+
+    lv_obj_t * floating = lv_button_create(list);
+    lv_obj_add_flag(floating, LV_OBJ_FLAG_FLOATING);
+    lv_obj_align(floating, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
+
+    lv_obj_t * top = lv_obj_create(lv_layer_top());
+    lv_obj_set_pos(top, 50, 200);
+    lv_obj_set_size(top, 40, 40);
+    lv_obj_set_style_radius(top, LV_RADIUS_CIRCLE, 0);
+
+    lv_refr_now(NULL);
+
+    int32_t i;
+    for(i = 0; i < 5; i++) {
+        scroll(-23);
+        lv_refr_now(NULL);
+        check_frame();
+    }
+}
+
+void test_scroll_blit_double_buffered(void)
+{
+    lv_display_t * disp_ori = lv_display_get_default();
+    lv_display_t * disp = lv_display_create(400, 400);
+    draw_bufs[0] = lv_draw_buf_create(400, 400, LV_COLOR_FORMAT_XRGB8888, 0);
+    draw_bufs[1] = lv_draw_buf_create(400, 400, LV_COLOR_FORMAT_XRGB8888, 0);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);
+    lv_display_set_draw_buffers(disp, draw_bufs[0], draw_bufs[1]);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(disp, dummy_flush_cb);
+    lv_display_set_scroll_blit(disp, true);
+    lv_display_set_default(disp);
+
+    create_list();
+    uint32_t list_px_cnt = lv_area_get_size(&list->coords);
+
+    int32_t i;
+    for(i = 0; i < 6; i++) {
+        scroll(i & 1 ? -9 : -31);
+        lv_refr_now(NULL);
+        TEST_ASSERT_LESS_THAN_UINT32(list_px_cnt / 2, lv_display_get_refr_px_cnt(NULL));
+        check_frame();
+    }
+
+    /*Two scrolls between the refreshes*/
+    scroll(-15);
+    lv_refr_now(NULL);
+    scroll(25);
+    scroll(-7);
+    lv_refr_now(NULL);
+    check_frame();
+
+    lv_display_set_default(disp_ori);
+    lv_display_delete(disp);
+    lv_draw_buf_destroy(draw_bufs[0]);
+    lv_draw_buf_destroy(draw_bufs[1]);
+    draw_bufs[0] = NULL;
+    draw_bufs[1] = NULL;
+}
+
+void test_scroll_blit_fallback(void)
+{
+    create_list();
+    uint32_t list_px_cnt = lv_area_get_size(&list->coords);
+
+    /*The background wouldn't move with the content*/
+    lv_obj_set_style_bg_grad_dir(list, LV_GRAD_DIR_VER, 0);
+    lv_obj_set_style_bg_grad_color(list, lv_color_hex(0x4080ff), 0);
+    lv_refr_now(NULL);
+
+    scroll(-20);
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(list_px_cnt, lv_display_get_refr_px_cnt(NULL));
+    check_frame();
+
+    /*Transformed content*/
+    lv_obj_set_style_bg_grad_dir(list, LV_GRAD_DIR_NONE, 0);
+    lv_obj_set_style_transform_rotation(lv_screen_active(), 10, 0);
+    lv_refr_now(NULL);
+
+    scroll(-20);
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(list_px_cnt, lv_display_get_refr_px_cnt(NULL));
+    lv_obj_set_style_transform_rotation(lv_screen_active(), 0, 0);
+
+    /*Disabled*/
+    lv_display_set_scroll_blit(NULL, false);
+    lv_refr_now(NULL);
+
+    scroll(-20);
+    lv_refr_now(NULL);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(list_px_cnt, lv_display_get_refr_px_cnt(NULL));
+    check_frame();
+}
+
+#endif
@@ -140,4 +140,51 @@ void test_style_has_prop(void)
     lv_style_reset(&style);
 }
 
+void test_style_sorted_props(void)
+{
+    lv_style_t style;
+    lv_style_init(&style);
+
+    /*Set the properties in "random" order, including a custom one*/
+    lv_style_prop_t custom_prop = lv_style_register_prop(LV_STYLE_PROP_FLAG_NONE);
+    lv_style_prop_t props[] = {LV_STYLE_TEXT_COLOR, LV_STYLE_WIDTH, custom_prop, LV_STYLE_BG_OPA,
+                               LV_STYLE_RADIUS, LV_STYLE_OPA, LV_STYLE_PAD_TOP
+                              };
+    uint32_t cnt = sizeof(props) / sizeof(props[0]);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_style_set_prop(&style, props[i], (lv_style_value_t) {
+            .num = i + 10
+        });
+    }
+
+    /*Overwrite one without adding a new property*/
+    lv_style_set_prop(&style, LV_STYLE_BG_OPA, (lv_style_value_t) {
+        .num = 100
+    });
+    TEST_ASSERT_EQUAL(cnt, style.prop_cnt);
+
+    lv_style_value_t v;
+    for(i = 0; i < cnt; i++) {
+        TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, props[i], &v));
+        TEST_ASSERT_EQUAL_INT32(props[i] == LV_STYLE_BG_OPA ? 100 : (int32_t)i + 10, v.num);
+    }
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_BG_COLOR, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_TEXT_OPA, &v));
+
+    /*The other properties should remain after removing one*/
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, LV_STYLE_RADIUS));
+    TEST_ASSERT_FALSE(lv_style_remove_prop(&style, LV_STYLE_RADIUS));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_NOT_FOUND, lv_style_get_prop(&style, LV_STYLE_RADIUS, &v));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, custom_prop, &v));
+    TEST_ASSERT_EQUAL_INT32(12, v.num);
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, lv_style_get_prop(&style, LV_STYLE_PAD_TOP, &v));
+    TEST_ASSERT_EQUAL_INT32(16, v.num);
+
+    /*The group of the removed property shouldn't be marked anymore*/
+    TEST_ASSERT_EQUAL(0, style.has_group & ((uint64_t)1 << _lv_style_get_prop_group(LV_STYLE_RADIUS)));
+
+    lv_style_reset(&style);
+}
+
 #endif
@@ -0,0 +1,182 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define MANY_TIMER_CNT 1000
+
+static uint32_t run_order[8];
+static uint32_t run_cnt;
+static lv_timer_t * timer_to_delete;
+static lv_timer_t * created_timer;
+static lv_timer_t * many_timers[MANY_TIMER_CNT];
+
+static void order_cb(lv_timer_t * timer)
+{
+    if(run_cnt < 8) run_order[run_cnt] = (uint32_t)(lv_uintptr_t)lv_timer_get_user_data(timer);
+    run_cnt++;
+}
+
+static void count_cb(lv_timer_t * timer)
+{
+    uint32_t * cnt = lv_timer_get_user_data(timer);
+    (*cnt)++;
+}
+
+static void delete_create_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    lv_timer_delete(timer_to_delete);
+    timer_to_delete = NULL;
+    created_timer = lv_timer_create(order_cb, 0, (void *)4);
+    lv_timer_set_repeat_count(created_timer, 1);
+}
+
+void setUp(void)
+{
+    run_cnt = 0;
+    timer_to_delete = NULL;
+    created_timer = NULL;
+    lv_memzero(run_order, sizeof(run_order));
+}
+
+void tearDown(void)
+{
+    /*Delete all timers of the tests*/
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer) {
+        lv_timer_t * next = lv_timer_get_next(timer);
+        lv_timer_cb_t cb = timer->timer_cb;
+        if(cb == order_cb || cb == count_cb || cb == delete_create_cb) lv_timer_delete(timer);
+        timer = next;
+    }
+}
+
+void test_timer_run_ready_timers_in_order(void)
+{
+    lv_timer_create(order_cb, 10, (void *)1);
+    lv_timer_create(order_cb, 50, (void *)2);
+    lv_timer_create(order_cb, 20, (void *)3);
+
+    lv_tick_inc(30);
+    lv_timer_handler();
+
+    /*Only the ready timers run, the most recently created first*/
+    TEST_ASSERT_EQUAL_UINT32(2, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(3, run_order[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, run_order[1]);
+
+    /*Each timer runs only once in a call even if it's ready again*/
+    lv_timer_t * timer = lv_timer_create(order_cb, 0, (void *)5);
+    run_cnt = 0;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_timer_get_time_until_next());
+    lv_timer_delete(timer);
+}
+
+void test_timer_create_and_delete_in_callback(void)
+{
+    /*The older timer runs later*/
+    timer_to_delete = lv_timer_create(order_cb, 20, (void *)1);
+    lv_timer_create(delete_create_cb, 10, NULL);
+
+    lv_tick_inc(20);
+    lv_timer_handler();
+
+    /*The deleted timer shouldn't run but the created one should run in the same call*/
+    TEST_ASSERT_NULL(timer_to_delete);
+    TEST_ASSERT_EQUAL_UINT32(1, run_cnt);
+    TEST_ASSERT_EQUAL_UINT32(4, run_order[0]);
+
+    /*The created timer was deleted after its only run*/
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer) {
+        TEST_ASSERT_NOT_EQUAL(created_timer, timer);
+        timer = lv_timer_get_next(timer);
+    }
+}
+
+void test_timer_pause_resume_and_time_until_next(void)
+{
+    uint32_t cnt_1 = 0;
+    uint32_t cnt_2 = 0;
+    lv_timer_t * timer_1 = lv_timer_create(count_cb, 1000, &cnt_1);
+    lv_timer_t * timer_2 = lv_timer_create(count_cb, 1500, &cnt_2);
+
+    /*Make sure that the other timers of LVGL don't interfere*/
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer) {
+        if(timer != timer_1 && timer != timer_2) lv_timer_pause(timer);
+        timer = lv_timer_get_next(timer);
+    }
+
+    lv_tick_inc(400);
+    TEST_ASSERT_EQUAL_UINT32(600, lv_timer_handler());
+
+    lv_timer_pause(timer_1);
+    TEST_ASSERT_EQUAL_UINT32(1100, lv_timer_handler());
+
+    lv_tick_inc(1100);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, cnt_1);
+    TEST_ASSERT_EQUAL_UINT32(1, cnt_2);
+
+    lv_timer_resume(timer_1);
+    lv_timer_set_period(timer_2, 100);
+    TEST_ASSERT_EQUAL_UINT32(100, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(1, cnt_1);
+    TEST_ASSERT_EQUAL_UINT32(1, cnt_2);
+
+    lv_timer_ready(timer_2);
+    TEST_ASSERT_EQUAL_UINT32(100, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(2, cnt_2);
+
+    /*The paused timer with the over repeat count is paused again*/
+    lv_timer_set_auto_delete(timer_1, false);
+    lv_timer_set_repeat_count(timer_1, 0);
+    lv_timer_handler();
+    TEST_ASSERT_TRUE(timer_1->paused);
+
+    timer = lv_timer_get_next(NULL);
+    while(timer) {
+        if(timer != timer_1) lv_timer_resume(timer);
+        timer = lv_timer_get_next(timer);
+    }
+}
+
+void test_timer_many_timers(void)
+{
+    uint32_t slow_cnt = 0;
+    uint32_t fast_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < MANY_TIMER_CNT; i++) {
+        many_timers[i] = lv_timer_create(count_cb, 100000 + i, &slow_cnt);
+    }
+    lv_timer_create(count_cb, 1, &fast_cnt);
+
+    clock_t t = clock();
+    for(i = 0; i < 1000; i++) {
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+    t = clock() - t;
+
+    printf("lv_timer_handler with %d idle timers: %ld clocks for 1000 calls\n", MANY_TIMER_CNT, (long)t);
+    TEST_ASSERT_EQUAL_UINT32(1000, fast_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, slow_cnt);
+
+    /*Delete every second timer and check that the others still run in time*/
+    for(i = 0; i < MANY_TIMER_CNT; i += 2) {
+        lv_timer_delete(many_timers[i]);
+    }
+
+    lv_tick_inc(100000);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(MANY_TIMER_CNT / 2, slow_cnt);
+}
+
+#endif